@@ -0,0 +1,22 @@
+#ifndef REGEXPERIENCE_ALLOCATION_REPORT_H
+#define REGEXPERIENCE_ALLOCATION_REPORT_H
+
+#include <glib.h>
+
+G_BEGIN_DECLS
+
+/* Describes the heap allocations made by a single call (in the calling thread only) - reallocations count
+ * as allocations and the bytes are the usable sizes of the allocated blocks. The peak is the highest number
+ * of bytes the call held at once, on top of what was already allocated before it began.
+ */
+typedef struct
+{
+  guint64 allocations_count;
+  guint64 frees_count;
+  guint64 allocated_bytes;
+  guint64 peak_bytes;
+} AllocationReport;
+
+G_END_DECLS
+
+#endif /* REGEXPERIENCE_ALLOCATION_REPORT_H */
@@ -0,0 +1,24 @@
+#ifndef REGEXPERIENCE_AUTOMATON_STATS_H
+#define REGEXPERIENCE_AUTOMATON_STATS_H
+
+#include <glib.h>
+
+G_BEGIN_DECLS
+
+/* Describes the compiled automaton - whichever one the matching is performed by (the DFA, by default).
+ * The alphabet consists of the disjoint sets of characters that the automaton tells apart. The bytes
+ * cover every structure the automaton keeps alive (its states, transitions, tables and profile), but
+ * neither the allocator's overhead nor the spare capacity of the arrays.
+ */
+typedef struct
+{
+  guint    states_count;
+  guint    transitions_count;
+  guint    alphabet_size;
+  gboolean has_dead_state;
+  gsize    bytes;
+} AutomatonStats;
+
+G_END_DECLS
+
+#endif /* REGEXPERIENCE_AUTOMATON_STATS_H */
@@ -0,0 +1,40 @@
+#ifndef REGEXPERIENCE_COMPILE_REPORT_H
+#define REGEXPERIENCE_COMPILE_REPORT_H
+
+#include <glib.h>
+
+G_BEGIN_DECLS
+
+/* Describes the phases of a single compilation - the time (in microseconds, measured by the monotonic clock)
+ * spent in each one of them and the size of what each one of them produced. Both are zero for the phases
+ * that were skipped (or not reached, in case the compilation failed). The lexical analysis is followed by
+ * the syntactic one which builds the AST by itself (the semantic actions are performed while parsing), the
+ * state machine built from the AST is either the epsilon-NFA, the position automaton or the bit-parallel
+ * one. The NFA fallback is included in the construction and the epsilon closures, whereas the reverse DFA
+ * (in leftmost-longest mode) is only included in the total.
+ */
+typedef struct
+{
+  gint64 tokenization_time;
+  gint64 parsing_time;
+  gint64 construction_time;
+  gint64 epsilon_closures_time;
+  gint64 subset_construction_time;
+  gint64 minimization_time;
+  gint64 total_time;
+
+  guint  tokens_count;
+  guint  ast_nodes_count;
+  guint  epsilon_nfa_states_count;
+  guint  epsilon_nfa_transitions_count;
+  guint  nfa_states_count;
+  guint  nfa_transitions_count;
+  guint  dfa_states_count;
+  guint  dfa_transitions_count;
+  guint  minimized_dfa_states_count;
+  guint  minimized_dfa_transitions_count;
+} CompileReport;
+
+G_END_DECLS
+
+#endif /* REGEXPERIENCE_COMPILE_REPORT_H */
@@ -6,7 +6,12 @@ typedef enum
   CORE_REGEXPERIENCE_ERROR_UNDEFINED = 0,
   CORE_REGEXPERIENCE_ERROR_REGULAR_EXPRESSION_NOT_COMPILED,
   CORE_REGEXPERIENCE_ERROR_INPUT_NULL,
+  /* Deprecated, no longer reported since any input is accepted (the value is kept reserved). */
   CORE_REGEXPERIENCE_ERROR_INPUT_NOT_ASCII,
+  CORE_REGEXPERIENCE_ERROR_COMPILATION_BUDGET_EXCEEDED,
+  CORE_REGEXPERIENCE_ERROR_MATCHER_NAME_INVALID,
+  CORE_REGEXPERIENCE_ERROR_PROFILE_UNAVAILABLE,
+  CORE_REGEXPERIENCE_ERROR_PROFILE_INVALID,
   CORE_REGEXPERIENCE_N_ERRORS
 } CoreRegexperienceError;
 
@@ -14,7 +19,9 @@ typedef enum
 {
   LEXICAL_ANALYSIS_LEXER_ERROR_UNDEFINED = CORE_REGEXPERIENCE_N_ERRORS,
   LEXICAL_ANALYSIS_LEXER_ERROR_INPUT_NULL,
-  LEXICAL_ANALYSIS_LEXER_ERROR_INPUT_NOT_ASCII,
+  LEXICAL_ANALYSIS_LEXER_ERROR_INPUT_NOT_UTF8,
+  /* Deprecated, expressions are validated as UTF-8 rather than ASCII (the value is shared). */
+  LEXICAL_ANALYSIS_LEXER_ERROR_INPUT_NOT_ASCII = LEXICAL_ANALYSIS_LEXER_ERROR_INPUT_NOT_UTF8,
   LEXICAL_ANALYSIS_LEXER_N_ERRORS
 } LexicalAnalysisLexerError;
 
@@ -33,12 +40,14 @@ typedef enum
   SYNTACTIC_ANALYSIS_PARSER_ERROR_UNEXPECTED_END_ANCHOR,
   SYNTACTIC_ANALYSIS_PARSER_ERROR_UNEXPECTED_EMPTY_EXPRESSION,
   SYNTACTIC_ANALYSIS_PARSER_ERROR_EMPTY_BRACKET_EXPRESSION,
+  SYNTACTIC_ANALYSIS_PARSER_ERROR_UNMATCHED_OPEN_BRACE,
   SYNTACTIC_ANALYSIS_PARSER_N_ERRORS
 } SyntacticAnalysisParserError;
 
 typedef enum
 {
-  SEMANTIC_ANALYSIS_RANGE_ERROR_INVALID_VALUES = SYNTACTIC_ANALYSIS_PARSER_N_ERRORS
+  SEMANTIC_ANALYSIS_RANGE_ERROR_INVALID_VALUES = SYNTACTIC_ANALYSIS_PARSER_N_ERRORS,
+  SEMANTIC_ANALYSIS_QUANTIFICATION_ERROR_INVALID_BOUNDS
 } SemanticAnalysisAnalyzerError;
 
 #endif /* REGEXPERIENCE_ERRORS_H */
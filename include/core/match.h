@@ -14,6 +14,13 @@ G_DECLARE_FINAL_TYPE (Match, match, CORE, MATCH, GObject)
 #define PROP_MATCH_RANGE_BEGIN "range-begin"
 #define PROP_MATCH_RANGE_END   "range-end"
 
+/* Offsets of the substrings matched by the capture groups (numbered by their opening parentheses, from
+ * left to right) - each group takes up two elements of the array, the beginning and the (exclusive) end.
+ * Both of them are negative in case the group did not take part in the match. The array itself is NULL
+ * unless the capture groups were requested before the expression was compiled.
+ */
+#define PROP_MATCH_CAPTURES    "captures"
+
 G_END_DECLS
 
 #endif /* REGEXPERIENCE_MATCH_H */
@@ -0,0 +1,40 @@
+#ifndef REGEXPERIENCE_MATCH_COUNTERS_H
+#define REGEXPERIENCE_MATCH_COUNTERS_H
+
+#include <glib.h>
+
+G_BEGIN_DECLS
+
+/* Counts what the matching engines did - every engine runs the same way (a single run at a time, either
+ * continued on the next character or abandoned in the dead state, which is the empty set of states for
+ * the NFAs). The input characters consumed by the runs are the scanned bytes (the start and end of text
+ * characters included), a reset is a run abandoned (or completed) after having consumed at least a single
+ * character. The skips count the times a part of
+ * the input was not scanned at all since no match could have been found there (e.g. the characters
+ * in between the start of text characters, for a start-anchored expression).
+ */
+typedef struct
+{
+  guint64 bytes_scanned;
+  guint64 resets;
+  guint64 dead_transitions;
+  guint64 matches;
+  guint64 empty_matches;
+  guint64 skips;
+} MatchCounters;
+
+static inline void
+match_counters_add (MatchCounters       *self,
+                    const MatchCounters *other)
+{
+  self->bytes_scanned += other->bytes_scanned;
+  self->resets += other->resets;
+  self->dead_transitions += other->dead_transitions;
+  self->matches += other->matches;
+  self->empty_matches += other->empty_matches;
+  self->skips += other->skips;
+}
+
+G_END_DECLS
+
+#endif /* REGEXPERIENCE_MATCH_COUNTERS_H */
@@ -3,6 +3,10 @@
 
 #include "errors.h"
 #include "match.h"
+#include "compile_report.h"
+#include "automaton_stats.h"
+#include "match_counters.h"
+#include "allocation_report.h"
 
 #include <glib-object.h>
 
@@ -13,14 +17,120 @@ G_BEGIN_DECLS
 
 G_DECLARE_FINAL_TYPE (Regexperience, regexperience, CORE, REGEXPERIENCE, GObject)
 
-void     regexperience_compile (Regexperience  *self,
-                                const gchar    *expression,
-                                GError        **error);
+void     regexperience_compile             (Regexperience  *self,
+                                            const gchar    *expression,
+                                            GError        **error);
 
-gboolean regexperience_match   (Regexperience  *self,
-                                const gchar    *input,
-                                GPtrArray     **matches,
-                                GError        **error);
+/* Finds the matches of the compiled expression in the input. The expression keeps the state of the match
+ * in progress, it must not be matched from more than one thread at a time.
+ */
+gboolean regexperience_match               (Regexperience  *self,
+                                            const gchar    *input,
+                                            GPtrArray     **matches,
+                                            GError        **error);
+
+/* Generates the source and the header of a standalone C matcher (the minimized DFA and a function running
+ * over it) which finds the same matches as the default engine, without depending on GLib. Every identifier
+ * it declares is prefixed by the matcher's name, the compilation limits apply to it as well.
+ */
+gboolean regexperience_generate_matcher    (Regexperience  *self,
+                                            const gchar    *expression,
+                                            const gchar    *matcher_name,
+                                            gchar         **source,
+                                            gchar         **header,
+                                            GError        **error);
+
+/* Fills in the report of the most recent compilation (whether it succeeded or not), the report is zeroed
+ * in case nothing was compiled yet.
+ */
+void     regexperience_get_compile_report  (Regexperience  *self,
+                                            CompileReport  *report);
+
+/* Fills in the statistics of the compiled automaton (whichever engine it belongs to) - including the number
+ * of bytes it holds, which is what a compiled expression costs for as long as it is kept around.
+ */
+gboolean regexperience_get_stats           (Regexperience  *self,
+                                            AutomatonStats *stats,
+                                            GError        **error);
+
+/* Fills in the counters of the expression (summed up over every one of its matches since the counters were
+ * last reset) or the ones of the calling thread (summed up over every expression it matched with) -
+ * counting must be enabled for an expression to contribute to either one.
+ */
+void     regexperience_get_counters        (Regexperience  *self,
+                                            MatchCounters  *counters);
+
+void     regexperience_reset_counters      (Regexperience  *self);
+
+void     regexperience_get_thread_counters (MatchCounters  *counters);
+
+/* Fills in the allocations made by the most recent compilation and by the most recent match, either one
+ * of the reports may be NULL. Allocation accounting must be enabled for the calls to be accounted for,
+ * the reports are zeroed otherwise.
+ */
+void     regexperience_get_allocations     (Regexperience    *self,
+                                            AllocationReport *compile_allocations,
+                                            AllocationReport *match_allocations);
+
+/* Writes the Chrome trace events (loadable in Perfetto as well) of every expression's compilation into the file
+ * until tracing is stopped - a span for each phase, including each refinement level of the minimization and each
+ * DFA state defined by the subset construction. Every n-th match is traced as well (none for a zero interval),
+ * along with the number of bytes it was given.
+ */
+gboolean regexperience_start_tracing       (const gchar    *filename,
+                                            guint           match_sampling_interval,
+                                            GError        **error);
+
+void     regexperience_stop_tracing        (void);
+
+/* Exports the numbers of state visits and transitions taken by the compiled expression's DFA while matching,
+ * in a textual form - profiling must be enabled before the expression is compiled. Applying a profile to the
+ * same expression compiled anew renumbers the DFA's states so that the ones visited most often share
+ * the same cache lines (which is what matters the most for DFAs that do not fit into the cache).
+ */
+gchar   *regexperience_export_profile      (Regexperience  *self,
+                                            GError        **error);
+
+gboolean regexperience_apply_profile       (Regexperience  *self,
+                                            const gchar    *profile,
+                                            GError        **error);
+
+/* Compilation limits, zero stands for no limit (which is the default) for each one of them. */
+#define PROP_REGEXPERIENCE_MAX_STATES "max-states"
+#define PROP_REGEXPERIENCE_MAX_BYTES  "max-bytes"
+#define PROP_REGEXPERIENCE_TIME_LIMIT "time-limit"
+
+/* Whether the NFA is simulated directly in case the DFA would exceed the state or byte limit (enabled by default). */
+#define PROP_REGEXPERIENCE_NFA_FALLBACK "nfa-fallback"
+
+/* Whether short expressions (at most 64 positions) are simulated bit-parallel instead of being converted
+ * to a DFA (enabled by default).
+ */
+#define PROP_REGEXPERIENCE_BIT_PARALLEL "bit-parallel"
+
+/* Whether each match begins as early and ends as late as possible (disabled by default) - by default,
+ * a new match is looked for right where the previous attempt failed, without ever going back.
+ */
+#define PROP_REGEXPERIENCE_LEFTMOST_LONGEST "leftmost-longest"
+
+/* Whether each match reports the substrings matched by the capture groups (disabled by default) - the
+ * matches are found the default way in that case, regardless of the leftmost-longest mode.
+ */
+#define PROP_REGEXPERIENCE_CAPTURES "captures"
+
+/* Whether the DFA counts the state visits and the transitions taken while matching (disabled by default),
+ * the other engines are never profiled.
+ */
+#define PROP_REGEXPERIENCE_PROFILING "profiling"
+
+/* Whether the matching engines count what they do (disabled by default), see match_counters.h. */
+#define PROP_REGEXPERIENCE_COUNTERS "counters"
+
+/* Whether the allocations made by each compilation and each match are counted (disabled by default) - the library
+ * must be built with REGEXPERIENCE_ALLOCATION_ACCOUNTING, which replaces the process' allocator, for the counts
+ * to be anything other than zero.
+ */
+#define PROP_REGEXPERIENCE_ALLOCATION_ACCOUNTING "allocation-accounting"
 
 G_END_DECLS
 
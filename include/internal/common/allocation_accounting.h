@@ -0,0 +1,16 @@
+#ifndef REGEXPERIENCE_ALLOCATION_ACCOUNTING_H
+#define REGEXPERIENCE_ALLOCATION_ACCOUNTING_H
+
+#include "core/allocation_report.h"
+
+#include <glib.h>
+
+/* Counts the allocations made by the calling thread in between the two calls, which cannot be nested.
+ * The allocator is only replaced in case the library was built with REGEXPERIENCE_ALLOCATION_ACCOUNTING,
+ * the report is always zeroed otherwise.
+ */
+void allocation_accounting_begin (void);
+
+void allocation_accounting_end   (AllocationReport *report);
+
+#endif /* REGEXPERIENCE_ALLOCATION_ACCOUNTING_H */
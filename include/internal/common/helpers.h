@@ -55,10 +55,7 @@ GPtrArray *g_hash_table_values_to_ptr_array  (GHashTable     *hash_table,
 
 void       g_queue_unref_g_objects           (GQueue         *queue);
 
-gboolean   g_node_unref_g_object             (GNode          *node,
-                                              gpointer        data);
-
-void       g_node_unref_g_objects            (GNode          *node);
+gsize      g_object_get_instance_size        (gpointer        object);
 
 #define g_collection_has_items(X)        \
   _Generic((X),                          \
@@ -0,0 +1,33 @@
+#ifndef REGEXPERIENCE_TRACE_H
+#define REGEXPERIENCE_TRACE_H
+
+#include <glib.h>
+
+/* Writes the events in the Chrome trace event format (which Perfetto loads as well) - each span
+ * is a pair of begin and end events of the calling thread, the end event carrying the arguments.
+ * Every function does nothing at all while tracing is disabled, which it is by default.
+ */
+gboolean  trace_start         (const gchar  *filename,
+                               guint         match_sampling_interval,
+                               GError      **error);
+
+void      trace_stop          (void);
+
+gboolean  trace_is_enabled    (void);
+
+/* Whether the current match should be traced, only every n-th one is. */
+gboolean  trace_samples_match (void);
+
+void      trace_begin         (const gchar  *category,
+                               const gchar  *name);
+
+/* The arguments are the members of a JSON object, e.g. "\"states\": %u". */
+void      trace_end           (const gchar  *category,
+                               const gchar  *name,
+                               const gchar  *arguments_format,
+                               ...) G_GNUC_PRINTF (3, 4);
+
+/* Quotes and escapes the string so that it can be passed as a JSON argument. */
+gchar    *trace_quote         (const gchar  *string);
+
+#endif /* REGEXPERIENCE_TRACE_H */
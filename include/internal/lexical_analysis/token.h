@@ -21,11 +21,13 @@ typedef enum
   TOKEN_CATEGORY_STAR_QUANTIFICATION_OPERATOR,
   TOKEN_CATEGORY_PLUS_QUANTIFICATION_OPERATOR,
   TOKEN_CATEGORY_QUESTION_MARK_QUANTIFICATION_OPERATOR,
+  TOKEN_CATEGORY_BOUNDED_QUANTIFICATION_OPERATOR,
   TOKEN_CATEGORY_METACHARACTER_ESCAPE,
   TOKEN_CATEGORY_OPEN_PARENTHESIS,
   TOKEN_CATEGORY_CLOSE_PARENTHESIS,
   TOKEN_CATEGORY_OPEN_BRACKET,
   TOKEN_CATEGORY_CLOSE_BRACKET,
+  TOKEN_CATEGORY_CLOSE_BRACE,
   TOKEN_CATEGORY_RANGE_OPERATOR,
   TOKEN_CATEGORY_EMPTY_EXPRESSION_MARKER,
   TOKEN_CATEGORY_END_OF_INPUT_MARKER,
@@ -2,6 +2,7 @@
 #define REGEXPERIENCE_ANALYZER_H
 
 #include "ast_nodes/ast_node.h"
+#include "internal/syntactic_analysis/production.h"
 
 #include <glib-object.h>
 
@@ -12,9 +13,10 @@ G_BEGIN_DECLS
 
 G_DECLARE_FINAL_TYPE (Analyzer, analyzer, SEMANTIC_ANALYSIS, ANALYZER, GObject)
 
-AstNode *analyzer_build_abstract_syntax_tree (Analyzer  *self,
-                                              GNode     *concrete_syntax_tree,
-                                              GError   **error);
+GObject *analyzer_reduce (Analyzer   *self,
+                          Production *production,
+                          gpointer   *values,
+                          guint       n_values);
 
 G_END_DECLS
 
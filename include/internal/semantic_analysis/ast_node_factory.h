@@ -2,17 +2,30 @@
 #define REGEXPERIENCE_AST_NODE_FACTORY_H
 
 #include "ast_nodes/ast_node.h"
+#include "ast_nodes/anchor.h"
+#include "internal/lexical_analysis/token.h"
 
-AstNode *create_constant        (GNode        *cst_context);
+AstNode    *create_constant               (Token        *token);
 
-AstNode *create_anchor          (GNode        *cst_context,
-                                 AstNode      *anchored_node);
+AnchorType  discern_anchor_type           (Token        *anchor_token);
 
-AstNode *create_unary_operator  (OperatorType  operator_type,
-                                 AstNode      *operand);
+AstNode    *create_anchor                 (AstNode      *anchored_node,
+                                           AnchorType    start_anchor_type,
+                                           AnchorType    end_anchor_type);
 
-AstNode *create_binary_operator (OperatorType  operator_type,
-                                 AstNode      *left_operand,
-                                 AstNode      *right_operand);
+AstNode    *create_unary_operator         (OperatorType  operator_type,
+                                           AstNode      *operand);
+
+AstNode    *create_bounded_quantification (AstNode      *operand,
+                                           Token        *bounds_token);
+
+AstNode    *create_binary_operator        (OperatorType  operator_type,
+                                           AstNode      *left_operand,
+                                           AstNode      *right_operand);
+
+AstNode    *create_bracket_expression     (AstNode      *items,
+                                           gboolean      negated);
+
+AstNode    *create_group                  (AstNode      *grouped_node);
 
 #endif /* REGEXPERIENCE_AST_NODE_FACTORY_H */
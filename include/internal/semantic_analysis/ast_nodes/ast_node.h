@@ -19,6 +19,7 @@ typedef enum
   OPERATOR_TYPE_STAR_QUANTIFICATION,
   OPERATOR_TYPE_PLUS_QUANTIFICATION,
   OPERATOR_TYPE_QUESTION_MARK_QUANTIFICATION,
+  OPERATOR_TYPE_BOUNDED_QUANTIFICATION,
   OPERATOR_TYPE_RANGE
 } OperatorType;
 
@@ -0,0 +1,28 @@
+#ifndef REGEXPERIENCE_BRACKET_EXPRESSION_H
+#define REGEXPERIENCE_BRACKET_EXPRESSION_H
+
+#include "unary_operator.h"
+#include "internal/state_machines/transitions/character_set.h"
+
+#include <glib-object.h>
+
+G_BEGIN_DECLS
+
+#define AST_NODES_TYPE_BRACKET_EXPRESSION (bracket_expression_get_type ())
+#define bracket_expression_new(...) (g_object_new (AST_NODES_TYPE_BRACKET_EXPRESSION, ##__VA_ARGS__, NULL))
+
+G_DECLARE_FINAL_TYPE (BracketExpression, bracket_expression, AST_NODES, BRACKET_EXPRESSION, UnaryOperator)
+
+CharacterSet *bracket_expression_fetch_character_set (BracketExpression *self);
+
+/* Returns NULL in case the bracket expression is not negated and only lists ASCII characters, the character set
+ * describes the whole bracket expression then. Otherwise, the (possibly complemented) items are matched by the
+ * returned UTF-8 sequences.
+ */
+GPtrArray    *bracket_expression_fetch_sequences     (BracketExpression *self);
+
+#define PROP_BRACKET_EXPRESSION_NEGATED "negated"
+
+G_END_DECLS
+
+#endif /* REGEXPERIENCE_BRACKET_EXPRESSION_H */
@@ -17,6 +17,11 @@ struct _ConstantClass
   AstNodeClass parent_class;
 };
 
+/* Returns NULL in case the constant is a single ASCII character. Otherwise, the constant (a non-ASCII character
+ * or the dot metacharacter, which stands for any character) is matched by the returned UTF-8 sequences.
+ */
+GPtrArray *constant_fetch_sequences (Constant *self);
+
 #define PROP_CONSTANT_VALUE    "value"
 #define PROP_CONSTANT_POSITION "position"
 
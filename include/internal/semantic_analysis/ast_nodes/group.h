@@ -0,0 +1,17 @@
+#ifndef REGEXPERIENCE_GROUP_H
+#define REGEXPERIENCE_GROUP_H
+
+#include "unary_operator.h"
+
+#include <glib-object.h>
+
+G_BEGIN_DECLS
+
+#define AST_NODES_TYPE_GROUP (group_get_type ())
+#define group_new(...) (g_object_new (AST_NODES_TYPE_GROUP, ##__VA_ARGS__, NULL))
+
+G_DECLARE_FINAL_TYPE (Group, group, AST_NODES, GROUP, UnaryOperator)
+
+G_END_DECLS
+
+#endif /* REGEXPERIENCE_GROUP_H */
@@ -12,16 +12,15 @@ G_BEGIN_DECLS
 
 G_DECLARE_FINAL_TYPE (Quantification, quantification, AST_NODES, QUANTIFICATION, UnaryOperator)
 
-typedef enum
-{
-  QUANTIFICATION_BOUND_TYPE_UNDEFINED,
-  QUANTIFICATION_BOUND_TYPE_ZERO,
-  QUANTIFICATION_BOUND_TYPE_ONE,
-  QUANTIFICATION_BOUND_TYPE_INFINITY
-} QuantificationBoundType;
+/* Bounds are repetition counts, an unbounded upper bound is represented by the largest
+ * possible value while explicitly given bounds must not exceed the maximum.
+ */
+#define QUANTIFICATION_BOUND_INFINITY   G_MAXUINT
+#define QUANTIFICATION_BOUND_MAXIMUM    1000
 
 #define PROP_QUANTIFICATION_LOWER_BOUND "lower-bound"
 #define PROP_QUANTIFICATION_UPPER_BOUND "upper-bound"
+#define PROP_QUANTIFICATION_POSITION    "position"
 
 G_END_DECLS
 
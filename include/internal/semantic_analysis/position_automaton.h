@@ -0,0 +1,24 @@
+#ifndef REGEXPERIENCE_POSITION_AUTOMATON_H
+#define REGEXPERIENCE_POSITION_AUTOMATON_H
+
+#include "ast_nodes/ast_node.h"
+#include "internal/state_machines/acceptors/acceptor_runnable.h"
+
+FsmConvertible   *build_position_automaton         (AstNode *abstract_syntax_tree);
+
+/* Builds the automaton of the reversed expression which also loops on every character in its initial state,
+ * running it backwards over the input finds every position at which a match begins.
+ */
+FsmConvertible   *build_reverse_position_automaton (AstNode *abstract_syntax_tree);
+
+/* Returns NULL in case the expression consists of too many positions to be simulated bit-parallel. */
+AcceptorRunnable *build_bit_parallel_automaton     (AstNode *abstract_syntax_tree);
+
+/* Builds the position automaton which also records where each one of the capture groups begins and ends. */
+AcceptorRunnable *build_tagged_automaton           (AstNode *abstract_syntax_tree);
+
+guint             count_positions                  (AstNode *abstract_syntax_tree);
+
+guint             count_nodes                      (AstNode *abstract_syntax_tree);
+
+#endif /* REGEXPERIENCE_POSITION_AUTOMATON_H */
@@ -0,0 +1,47 @@
+#ifndef REGEXPERIENCE_UTF8_SEQUENCES_H
+#define REGEXPERIENCE_UTF8_SEQUENCES_H
+
+#include "internal/state_machines/fsm_convertible.h"
+#include "internal/state_machines/transitions/character_set.h"
+
+#include <glib.h>
+
+/* The state machines consume the input byte by byte, a non-ASCII character is therefore matched by a
+ * sequence of transitions. Each sequence is an array of character sets (one for each byte of the encoded
+ * characters it covers) and every ASCII character is covered by a single sequence of length one.
+ */
+typedef struct
+{
+  gunichar lower;
+  gunichar upper;
+} CodePointRange;
+
+/* The sequences share their common suffixes - each node consumes a byte of one or more sequences and is
+ * followed by a single other node (none at all in case the byte is the last one). The first bytes followed
+ * by the same node are merged into a single node as well. Each node comes before the node following it.
+ */
+typedef struct
+{
+  CharacterSet *character_set;
+  gint          next;
+  gboolean      is_first;
+} Utf8SequenceNode;
+
+/* The ranges may overlap and they are not required to be sorted. The complemented ranges are matched by the
+ * sequences of every other valid character except the start and end of text special characters.
+ */
+GPtrArray      *create_utf8_sequences          (GArray    *code_point_ranges,
+                                                gboolean   complemented);
+
+GPtrArray      *create_utf8_range_sequences    (gunichar   lower,
+                                                gunichar   upper);
+
+GPtrArray      *create_utf8_any_sequences      (void);
+
+GArray         *create_utf8_sequence_nodes     (GPtrArray *sequences);
+
+FsmConvertible *build_utf8_sequences_acceptor  (GPtrArray *sequences);
+
+guint           count_utf8_sequences_positions (GPtrArray *sequences);
+
+#endif /* REGEXPERIENCE_UTF8_SEQUENCES_H */
@@ -1,6 +1,11 @@
 #ifndef REGEXPERIENCE_ACCEPTOR_RUNNABLE_H
 #define REGEXPERIENCE_ACCEPTOR_RUNNABLE_H
 
+#include "core/automaton_stats.h"
+#include "core/match_counters.h"
+#include "internal/state_machines/transitions/transition.h"
+#include "internal/common/helpers.h"
+
 #include <glib-object.h>
 
 G_BEGIN_DECLS
@@ -14,15 +19,56 @@ struct _AcceptorRunnableInterface
   GTypeInterface parent_iface;
 
   GPtrArray * (*run)        (AcceptorRunnable *self,
-                             const gchar      *input);
+                             const gchar      *input,
+                             MatchCounters    *counters);
   gboolean    (*can_accept) (AcceptorRunnable *self);
+  void        (*measure)    (AcceptorRunnable *self,
+                             AutomatonStats   *stats);
 };
 
+/* The counters (if any) are added to, they are never reset. */
 GPtrArray *acceptor_runnable_run        (AcceptorRunnable *self,
-                                         const gchar      *input);
+                                         const gchar      *input,
+                                         MatchCounters    *counters);
 
 gboolean   acceptor_runnable_can_accept (AcceptorRunnable *self);
 
+void       acceptor_runnable_measure    (AcceptorRunnable *self,
+                                         AutomatonStats   *stats);
+
+/* Copies the input's characters from the beginning up to (but not including) the end, the start and end
+ * of text characters included.
+ */
+GString   *acceptor_runnable_input_copy (const gchar      *input,
+                                         guint             begin,
+                                         guint             end);
+
+/* Returns the index of the character's first occurrence at the given index or after it (G_MAXUINT if there
+ * is none). Apart from the leading start of text character, only the input's own characters are searched.
+ */
+guint      acceptor_runnable_input_find (const gchar      *input,
+                                         guint             index,
+                                         gchar             character);
+
+/* The input is run as if it was surrounded by the start and end of text characters, which are never actually
+ * copied into it. The null terminator is found on the way instead of measuring the input beforehand - the end
+ * of text character takes its place and it is followed by the terminator itself, nothing is read past it.
+ */
+static inline gchar
+acceptor_runnable_input_at (const gchar *input,
+                            guint        index)
+{
+  if (G_UNLIKELY (index == 0))
+    return START;
+
+  if (G_UNLIKELY (index > 1 && input[index - 2] == END_OF_STRING))
+    return END_OF_STRING;
+
+  gchar character = input[index - 1];
+
+  return G_LIKELY (character != END_OF_STRING) ? character : END;
+}
+
 G_END_DECLS
 
 #endif /* REGEXPERIENCE_ACCEPTOR_RUNNABLE_H */
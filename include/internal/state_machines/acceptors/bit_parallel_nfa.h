@@ -0,0 +1,24 @@
+#ifndef REGEXPERIENCE_BIT_PARALLEL_NFA_H
+#define REGEXPERIENCE_BIT_PARALLEL_NFA_H
+
+#include <glib-object.h>
+
+G_BEGIN_DECLS
+
+#define ACCEPTORS_TYPE_BIT_PARALLEL_NFA (bit_parallel_nfa_get_type ())
+#define bit_parallel_nfa_new(...) (g_object_new (ACCEPTORS_TYPE_BIT_PARALLEL_NFA, ##__VA_ARGS__, NULL))
+
+G_DECLARE_FINAL_TYPE (BitParallelNfa, bit_parallel_nfa, ACCEPTORS, BIT_PARALLEL_NFA, GObject)
+
+/* Each position of the expression is represented by a single bit of a machine word. */
+#define BIT_PARALLEL_NFA_MAX_POSITIONS 64
+
+#define PROP_BIT_PARALLEL_NFA_FIRST_POSITIONS "first-positions"
+#define PROP_BIT_PARALLEL_NFA_LAST_POSITIONS  "last-positions"
+#define PROP_BIT_PARALLEL_NFA_NULLABLE        "nullable"
+#define PROP_BIT_PARALLEL_NFA_FOLLOW_SETS     "follow-sets"
+#define PROP_BIT_PARALLEL_NFA_CHARACTER_MASKS "character-masks"
+
+G_END_DECLS
+
+#endif /* REGEXPERIENCE_BIT_PARALLEL_NFA_H */
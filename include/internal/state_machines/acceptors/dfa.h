@@ -12,6 +12,18 @@ G_BEGIN_DECLS
 
 G_DECLARE_FINAL_TYPE (Dfa, dfa, ACCEPTORS, DFA, Fsm)
 
+/* Returns NULL unless profiling is enabled, the states are always numbered the original way. */
+gchar    *dfa_export_profile (Dfa         *self);
+
+/* Returns FALSE in case the profile is malformed or it does not match the DFA, the counts recorded
+ * so far (if any) are discarded otherwise.
+ */
+gboolean  dfa_apply_profile  (Dfa         *self,
+                              const gchar *serialized_profile);
+
+/* Whether the state visits and the transitions taken are counted during each run (disabled by default). */
+#define PROP_DFA_PROFILING "profiling"
+
 G_END_DECLS
 
 #endif /* REGEXPERIENCE_DFA_H */
@@ -0,0 +1,25 @@
+#ifndef REGEXPERIENCE_DFA_GENERATOR_H
+#define REGEXPERIENCE_DFA_GENERATOR_H
+
+#include "internal/state_machines/acceptors/dfa_table.h"
+
+#include <glib.h>
+
+G_BEGIN_DECLS
+
+/* The generated matcher consists of static tables (the flattened DFA itself) and a single function which
+ * runs over them the same way the DFA does, neither of them depends on GLib.
+ */
+gchar    *dfa_generator_emit_source   (const DfaTable *table,
+                                       gboolean        is_start_anchored,
+                                       const gchar    *matcher_name);
+
+gchar    *dfa_generator_emit_header   (const gchar    *matcher_name,
+                                       const gchar    *expression);
+
+/* Whether the name can be used as a prefix of C identifiers. */
+gboolean  dfa_generator_is_valid_name (const gchar    *matcher_name);
+
+G_END_DECLS
+
+#endif /* REGEXPERIENCE_DFA_GENERATOR_H */
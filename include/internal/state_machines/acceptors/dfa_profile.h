@@ -0,0 +1,48 @@
+#ifndef REGEXPERIENCE_DFA_PROFILE_H
+#define REGEXPERIENCE_DFA_PROFILE_H
+
+#include <glib.h>
+
+G_BEGIN_DECLS
+
+/* Number of times each state of a flattened DFA was visited (i.e., its row of the transition table was looked up)
+ * and number of times each one of its transitions was taken, both indexed the same way as the table itself.
+ */
+typedef struct
+{
+  guint    states_count;
+  guint    classes_count;
+  guint64 *visits;
+  guint64 *transitions;
+} DfaProfile;
+
+DfaProfile *dfa_profile_new         (guint             states_count,
+                                     guint             classes_count);
+
+void        dfa_profile_free        (DfaProfile       *self);
+
+/* Copies the profile, the counts of each state are moved to the index it is mapped onto. */
+DfaProfile *dfa_profile_renumber    (const DfaProfile *self,
+                                     const guint      *indices);
+
+gchar      *dfa_profile_serialize   (const DfaProfile *self);
+
+/* Returns NULL in case the serialized profile is malformed. */
+DfaProfile *dfa_profile_deserialize (const gchar      *serialized_profile);
+
+gsize       dfa_profile_measure     (const DfaProfile *self);
+
+static inline void
+dfa_profile_record (DfaProfile *self,
+                    guint       state,
+                    guint       class)
+{
+  self->visits[state]++;
+  self->transitions[(gsize) state * self->classes_count + class]++;
+}
+
+G_DEFINE_AUTOPTR_CLEANUP_FUNC (DfaProfile, dfa_profile_free)
+
+G_END_DECLS
+
+#endif /* REGEXPERIENCE_DFA_PROFILE_H */
@@ -0,0 +1,64 @@
+#ifndef REGEXPERIENCE_DFA_TABLE_H
+#define REGEXPERIENCE_DFA_TABLE_H
+
+#include "internal/state_machines/acceptors/dfa.h"
+#include "internal/state_machines/acceptors/dfa_profile.h"
+
+#include <glib.h>
+
+G_BEGIN_DECLS
+
+/* Flattened representation of a DFA - states are numbered from zero, each input character is mapped
+ * onto its set of the alphabet (character class) and the next state is found in a single lookup.
+ * Characters which do not belong to the alphabet as well as the DFA's own dead state all lead to
+ * the dead state found right after the remaining ones. The layout holds the original index of each state
+ * once the states were renumbered (it is NULL until then).
+ */
+typedef struct
+{
+  guint     states_count;
+  guint     classes_count;
+  guint     start;
+  guint     dead;
+  guint     character_classes[G_MAXUINT8 + 1];
+  guint    *transitions;
+  gboolean *finals;
+  guint    *layout;
+} DfaTable;
+
+DfaTable *dfa_table_new            (Dfa              *dfa);
+
+void      dfa_table_free           (DfaTable         *self);
+
+/* Renumbers the states so that the visited ones come first (in breadth-first order from the start state,
+ * following the transitions taken most often first) and their rows are packed into the same cache lines,
+ * the remaining ones follow them. The profile's states are expected to be numbered the original way.
+ */
+void      dfa_table_apply_profile  (DfaTable         *self,
+                                    const DfaProfile *profile);
+
+/* Whether the start state is left only on the given character (and is not final) - a start-anchored
+ * expression cannot match anywhere else than right at the start of text character, for instance.
+ */
+gboolean  dfa_table_is_anchored_on (const DfaTable   *self,
+                                    gchar             anchor);
+
+/* Whether the start state loops on every character except the given one (and is not final). */
+gboolean  dfa_table_is_idle_unless (const DfaTable   *self,
+                                    gchar             anchor);
+
+gsize     dfa_table_measure        (const DfaTable   *self);
+
+static inline guint
+dfa_table_step (const DfaTable *self,
+                guint           state,
+                gchar           input_character)
+{
+  return self->transitions[state * self->classes_count + self->character_classes[(guint8) input_character]];
+}
+
+G_DEFINE_AUTOPTR_CLEANUP_FUNC (DfaTable, dfa_table_free)
+
+G_END_DECLS
+
+#endif /* REGEXPERIENCE_DFA_TABLE_H */
@@ -0,0 +1,18 @@
+#ifndef REGEXPERIENCE_LEFTMOST_LONGEST_DFA_H
+#define REGEXPERIENCE_LEFTMOST_LONGEST_DFA_H
+
+#include <glib-object.h>
+
+G_BEGIN_DECLS
+
+#define ACCEPTORS_TYPE_LEFTMOST_LONGEST_DFA (leftmost_longest_dfa_get_type ())
+#define leftmost_longest_dfa_new(...) (g_object_new (ACCEPTORS_TYPE_LEFTMOST_LONGEST_DFA, ##__VA_ARGS__, NULL))
+
+G_DECLARE_FINAL_TYPE (LeftmostLongestDfa, leftmost_longest_dfa, ACCEPTORS, LEFTMOST_LONGEST_DFA, GObject)
+
+#define PROP_LEFTMOST_LONGEST_DFA_FORWARD_DFA "forward-dfa"
+#define PROP_LEFTMOST_LONGEST_DFA_REVERSE_DFA "reverse-dfa"
+
+G_END_DECLS
+
+#endif /* REGEXPERIENCE_LEFTMOST_LONGEST_DFA_H */
@@ -0,0 +1,41 @@
+#ifndef REGEXPERIENCE_TAGGED_NFA_H
+#define REGEXPERIENCE_TAGGED_NFA_H
+
+#include <glib-object.h>
+
+G_BEGIN_DECLS
+
+#define ACCEPTORS_TYPE_TAGGED_NFA (tagged_nfa_get_type ())
+#define tagged_nfa_new(...) (g_object_new (ACCEPTORS_TYPE_TAGGED_NFA, ##__VA_ARGS__, NULL))
+
+G_DECLARE_FINAL_TYPE (TaggedNfa, tagged_nfa, ACCEPTORS, TAGGED_NFA, GObject)
+
+/* Each capture group has two tags - the first one records where the group begins (its index is twice
+ * the group's index), the second one records where it ends.
+ */
+#define TAGGED_NFA_OPENING_TAG(group) ((group) * 2)
+#define TAGGED_NFA_CLOSING_TAG(group) ((group) * 2 + 1)
+
+/* An edge enters its target position and sets each one of the tags found in the operations array
+ * (from the beginning up to, but not including, the end) to the offset at which that happens.
+ * The edges which end the expression leave their target position instead.
+ */
+typedef struct
+{
+  guint target;
+  guint operations_begin;
+  guint operations_end;
+} TaggedEdge;
+
+#define PROP_TAGGED_NFA_NULLABLE       "nullable"
+#define PROP_TAGGED_NFA_GROUPS_COUNT   "groups-count"
+#define PROP_TAGGED_NFA_CHARACTER_SETS "character-sets"
+#define PROP_TAGGED_NFA_FIRST_EDGES    "first-edges"
+#define PROP_TAGGED_NFA_FOLLOW_EDGES   "follow-edges"
+#define PROP_TAGGED_NFA_LAST_EDGES     "last-edges"
+#define PROP_TAGGED_NFA_EMPTY_EDGE     "empty-edge"
+#define PROP_TAGGED_NFA_OPERATIONS     "operations"
+
+G_END_DECLS
+
+#endif /* REGEXPERIENCE_TAGGED_NFA_H */
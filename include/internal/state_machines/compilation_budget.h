@@ -0,0 +1,37 @@
+#ifndef REGEXPERIENCE_COMPILATION_BUDGET_H
+#define REGEXPERIENCE_COMPILATION_BUDGET_H
+
+#include <glib-object.h>
+
+G_BEGIN_DECLS
+
+#define STATE_MACHINES_TYPE_COMPILATION_BUDGET (compilation_budget_get_type ())
+#define compilation_budget_new(...) (g_object_new (STATE_MACHINES_TYPE_COMPILATION_BUDGET, ##__VA_ARGS__, NULL))
+
+G_DECLARE_FINAL_TYPE (CompilationBudget, compilation_budget, STATE_MACHINES, COMPILATION_BUDGET, GObject)
+
+typedef enum
+{
+  COMPILATION_BUDGET_LIMIT_NONE,
+  COMPILATION_BUDGET_LIMIT_STATES,
+  COMPILATION_BUDGET_LIMIT_BYTES,
+  COMPILATION_BUDGET_LIMIT_DEADLINE
+} CompilationBudgetLimit;
+
+gboolean compilation_budget_allows_states (CompilationBudget *self,
+                                           guint              states_count);
+
+gboolean compilation_budget_charge        (CompilationBudget *self,
+                                           guint              states_count,
+                                           guint              transitions_count);
+
+gboolean compilation_budget_is_exceeded   (CompilationBudget *self);
+
+#define PROP_COMPILATION_BUDGET_MAX_STATES     "max-states"
+#define PROP_COMPILATION_BUDGET_MAX_BYTES      "max-bytes"
+#define PROP_COMPILATION_BUDGET_DEADLINE       "deadline"
+#define PROP_COMPILATION_BUDGET_EXCEEDED_LIMIT "exceeded-limit"
+
+G_END_DECLS
+
+#endif /* REGEXPERIENCE_COMPILATION_BUDGET_H */
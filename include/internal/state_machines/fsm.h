@@ -3,6 +3,7 @@
 
 #include "state.h"
 #include "composite_state.h"
+#include "core/automaton_stats.h"
 
 #include <glib-object.h>
 
@@ -30,6 +31,15 @@ State     *fsm_get_or_create_composite_state     (GPtrArray
 
 State     *fsm_get_or_create_dead_state          (GPtrArray                      *all_states);
 
+/* Each output state of each transition is counted separately. */
+void       fsm_count_states_and_transitions      (Fsm                            *self,
+                                                  guint                          *states_count,
+                                                  guint                          *transitions_count);
+
+/* Fills in the statistics of the state machine's own states and transitions (and the bytes they hold). */
+void       fsm_measure                           (Fsm                            *self,
+                                                  AutomatonStats                 *stats);
+
 G_END_DECLS
 
 #endif /* REGEXPERIENCE_FSM_H */
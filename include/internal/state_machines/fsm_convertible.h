@@ -2,6 +2,7 @@
 #define REGEXPERIENCE_FSM_CONVERTIBLE_H
 
 #include "fsm_modifiable.h"
+#include "compilation_budget.h"
 
 #include <glib-object.h>
 
@@ -15,13 +16,17 @@ struct _FsmConvertibleInterface
 {
   GTypeInterface parent_iface;
 
-  FsmConvertible * (*compute_epsilon_closures) (FsmConvertible *self);
-  FsmModifiable  * (*construct_subset)         (FsmConvertible *self);
+  FsmConvertible * (*compute_epsilon_closures) (FsmConvertible    *self,
+                                                CompilationBudget *budget);
+  FsmModifiable  * (*construct_subset)         (FsmConvertible    *self,
+                                                CompilationBudget *budget);
 };
 
-FsmConvertible *fsm_convertible_compute_epsilon_closures (FsmConvertible *self);
+FsmConvertible *fsm_convertible_compute_epsilon_closures (FsmConvertible    *self,
+                                                          CompilationBudget *budget);
 
-FsmModifiable  *fsm_convertible_construct_subset         (FsmConvertible *self);
+FsmModifiable  *fsm_convertible_construct_subset         (FsmConvertible    *self,
+                                                          CompilationBudget *budget);
 
 G_END_DECLS
 
@@ -1,6 +1,8 @@
 #ifndef REGEXPERIENCE_FSM_MODIFIABLE_H
 #define REGEXPERIENCE_FSM_MODIFIABLE_H
 
+#include "compilation_budget.h"
+
 #include <glib-object.h>
 
 G_BEGIN_DECLS
@@ -13,13 +15,15 @@ struct _FsmModifiableInterface
 {
   GTypeInterface parent_iface;
 
-  void (*minimize)   (FsmModifiable *self);
-  void (*complement) (FsmModifiable *self);
+  void (*minimize)   (FsmModifiable     *self,
+                      CompilationBudget *budget);
+  void (*complement) (FsmModifiable     *self);
 };
 
-void fsm_modifiable_minimize   (FsmModifiable *self);
+void fsm_modifiable_minimize   (FsmModifiable     *self,
+                                CompilationBudget *budget);
 
-void fsm_modifiable_complement (FsmModifiable *self);
+void fsm_modifiable_complement (FsmModifiable     *self);
 
 G_END_DECLS
 
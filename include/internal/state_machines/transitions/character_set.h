@@ -0,0 +1,55 @@
+#ifndef REGEXPERIENCE_CHARACTER_SET_H
+#define REGEXPERIENCE_CHARACTER_SET_H
+
+#include <glib-object.h>
+
+G_BEGIN_DECLS
+
+#define TRANSITIONS_TYPE_CHARACTER_SET (character_set_get_type ())
+
+typedef struct _CharacterSet CharacterSet;
+
+GType         character_set_get_type           (void) G_GNUC_CONST;
+
+CharacterSet *character_set_new                (void);
+
+CharacterSet *character_set_copy               (const CharacterSet *self);
+
+void          character_set_free               (CharacterSet       *self);
+
+void          character_set_add                (CharacterSet       *self,
+                                                gchar               character);
+
+void          character_set_add_range          (CharacterSet       *self,
+                                                gchar               lower_character,
+                                                gchar               upper_character);
+
+void          character_set_add_set            (CharacterSet       *self,
+                                                const CharacterSet *other);
+
+void          character_set_remove             (CharacterSet       *self,
+                                                gchar               character);
+
+void          character_set_subtract           (CharacterSet       *self,
+                                                const CharacterSet *other);
+
+CharacterSet *character_set_intersect          (const CharacterSet *self,
+                                                const CharacterSet *other);
+
+gboolean      character_set_contains           (const CharacterSet *self,
+                                                gchar               character);
+
+gboolean      character_set_is_empty           (const CharacterSet *self);
+
+gboolean      character_set_equal              (const CharacterSet *self,
+                                                const CharacterSet *other);
+
+gchar         character_set_get_representative (const CharacterSet *self);
+
+gsize         character_set_measure            (const CharacterSet *self);
+
+G_DEFINE_AUTOPTR_CLEANUP_FUNC (CharacterSet, character_set_free)
+
+G_END_DECLS
+
+#endif /* REGEXPERIENCE_CHARACTER_SET_H */
@@ -1,6 +1,8 @@
 #ifndef REGEXPERIENCE_TRANSITION_H
 #define REGEXPERIENCE_TRANSITION_H
 
+#include "character_set.h"
+
 #include <glib-object.h>
 
 G_BEGIN_DECLS
@@ -14,7 +16,8 @@ typedef enum
   EQUALITY_CONDITION_TYPE_UNDEFINED,
   EQUALITY_CONDITION_TYPE_ANY,
   EQUALITY_CONDITION_TYPE_EQUAL,
-  EQUALITY_CONDITION_TYPE_NOT_EQUAL
+  EQUALITY_CONDITION_TYPE_NOT_EQUAL,
+  EQUALITY_CONDITION_TYPE_IN_SET
 } EqualityConditionType;
 
 struct _TransitionClass
@@ -27,23 +30,26 @@ struct _TransitionClass
   gpointer     padding[8];
 };
 
-void     transition_supplement_states_array_with_output (Transition *self,
-                                                         GPtrArray  *states_array);
+void          transition_supplement_states_array_with_output (Transition *self,
+                                                              GPtrArray  *states_array);
+
+gboolean      transition_is_possible                         (Transition *self,
+                                                              gchar       input_character);
 
-gboolean transition_is_possible                         (Transition *self,
-                                                         gchar       input_character);
+gboolean      transition_is_allowed                          (Transition *self,
+                                                              gchar       input_character);
 
-gboolean transition_is_allowed                          (Transition *self,
-                                                         gchar       input_character);
+gboolean      transition_is_epsilon                          (Transition *self);
 
-gboolean transition_is_epsilon                          (Transition *self);
+void          transition_convert_to_epsilon                  (Transition *self);
 
-void     transition_convert_to_epsilon                  (Transition *self);
+CharacterSet *transition_fetch_expected_characters           (Transition *self);
 
-gint     transition_compare_equality_condition_type     (Transition *a,
-                                                         Transition *b);
+gint          transition_compare_equality_condition_type     (Transition *a,
+                                                              Transition *b);
 
 #define PROP_TRANSITION_EXPECTED_CHARACTER      "expected-character"
+#define PROP_TRANSITION_EXPECTED_CHARACTERS     "expected-characters"
 #define PROP_TRANSITION_REQUIRES_INPUT          "requires-input"
 #define PROP_TRANSITION_EQUALITY_CONDITION_TYPE "equality-condition-type"
 
@@ -4,14 +4,20 @@
 #include "internal/state_machines/transitions/transition.h"
 #include "internal/state_machines/state.h"
 
-Transition *create_nondeterministic_transition (gchar      expected_character,
-                                                GPtrArray *output_states);
+Transition *create_nondeterministic_transition     (gchar         expected_character,
+                                                    GPtrArray    *output_states);
 
-Transition *create_deterministic_transition    (gchar      expected_character,
-                                                State     *output_state);
+Transition *create_nondeterministic_set_transition (CharacterSet *expected_characters,
+                                                    GPtrArray    *output_states);
 
-Transition *create_mealy_transition            (gchar      expected_character,
-                                                State     *output_state,
-                                                gpointer   output_data);
+Transition *create_deterministic_transition        (gchar         expected_character,
+                                                    State        *output_state);
+
+Transition *create_deterministic_set_transition    (CharacterSet *expected_characters,
+                                                    State        *output_state);
+
+Transition *create_mealy_transition                (gchar         expected_character,
+                                                    State        *output_state,
+                                                    gpointer      output_data);
 
 #endif /* REGEXPERIENCE_TRANSITION_FACTORY_H */
@@ -34,10 +34,18 @@ G_DECLARE_FINAL_TYPE (Grammar, grammar, SYNTACTIC_ANALYSIS, GRAMMAR, GObject)
 #define STAR_QUANTIFICATION              "star-quantification"
 #define PLUS_QUANTIFICATION              "plus-quantification"
 #define QUESTION_MARK_QUANTIFICATION     "question-mark-quantification"
+#define BOUNDED_QUANTIFICATION           "bounded-quantification"
+#define QUANTIFICATION_BOUNDS            "quantification-bounds"
+#define QUANTIFICATION_BOUNDS_PRIME      "quantification-bounds-prime"
+#define UPPER_QUANTIFICATION_BOUND       "upper-quantification-bound"
+#define QUANTIFICATION_BOUND             "quantification-bound"
+#define QUANTIFICATION_BOUND_PRIME       "quantification-bound-prime"
+#define QUANTIFICATION_BOUND_DIGIT       "quantification-bound-digit"
 #define ELEMENTARY_EXPRESSION            "elementary-expression"
 #define ELEMENTARY_EXPRESSION_PRIME      "elementary-expression-prime"
 #define GROUP                            "group"
 #define BRACKET_EXPRESSION               "bracket-expression"
+#define BRACKET_EXPRESSION_NEGATION      "bracket-expression-negation"
 #define BRACKET_EXPRESSION_ITEMS         "bracket-expression-items"
 #define BRACKET_EXPRESSION_ITEMS_PRIME   "bracket-expression-items-prime"
 #define BRACKET_EXPRESSION_ITEM          "bracket-expression-item"
@@ -45,10 +53,12 @@ G_DECLARE_FINAL_TYPE (Grammar, grammar, SYNTACTIC_ANALYSIS, GRAMMAR, GObject)
 #define LOWER_CASE_LETTER_RANGE          "upper-case-letter-range"
 #define UPPER_CASE_LETTER_RANGE          "lower-case-letter-range"
 #define DIGIT_RANGE                      "digit-range"
+#define NON_ASCII_CHARACTER_RANGE        "non-ascii-character-range"
 #define UPPER_CASE_LETTER                "upper-case-letter"
 #define LOWER_CASE_LETTER                "lower-case-letter"
 #define DIGIT                            "digit"
 #define SPECIAL_CHARACTER                "special-character"
+#define NON_ASCII_CHARACTER              "non-ascii-character"
 #define SPACE                            "space"
 #define HORIZONTAL_TAB                   "horizontal-tab"
 #define REGULAR_METACHARACTER            "regular-metacharacter"
@@ -1,6 +1,8 @@
 #ifndef REGEXPERIENCE_PARSER_H
 #define REGEXPERIENCE_PARSER_H
 
+#include "internal/semantic_analysis/ast_nodes/ast_node.h"
+
 #include <glib-object.h>
 
 G_BEGIN_DECLS
@@ -10,9 +12,9 @@ G_BEGIN_DECLS
 
 G_DECLARE_FINAL_TYPE (Parser, parser, SYNTACTIC_ANALYSIS, PARSER, GObject)
 
-GNode *parser_build_concrete_syntax_tree (Parser     *self,
-                                          GPtrArray  *tokens,
-                                          GError    **error);
+AstNode *parser_build_abstract_syntax_tree (Parser     *self,
+                                            GPtrArray  *tokens,
+                                            GError    **error);
 
 G_END_DECLS
 
@@ -12,6 +12,11 @@ G_BEGIN_DECLS
 
 G_DECLARE_FINAL_TYPE (Terminal, terminal, SYMBOLS, TERMINAL, Symbol)
 
+/* Every non-ASCII character is matched by the terminal symbol whose value is this placeholder - a lone
+ * continuation byte is not a valid UTF-8 string so it can never be found in an expression on its own.
+ */
+#define TERMINAL_NON_ASCII_CHARACTER "\x80"
+
 G_END_DECLS
 
 #endif /* REGEXPERIENCE_TERMINAL_H */
@@ -0,0 +1,178 @@
+#include "internal/common/allocation_accounting.h"
+
+#include <string.h>
+
+#ifdef REGEXPERIENCE_ALLOCATION_ACCOUNTING
+
+#include <errno.h>
+#include <malloc.h>
+
+/* The allocator functions are replaced for the whole process (GLib included), each replacement forwards
+ * to the C library's own implementation. The state is thread-local by means of the storage class rather
+ * than GPrivate, which might allocate by itself.
+ */
+extern void *__libc_malloc   (size_t  size);
+extern void *__libc_calloc   (size_t  count,
+                              size_t  size);
+extern void *__libc_realloc  (void   *pointer,
+                              size_t  size);
+extern void *__libc_memalign (size_t  alignment,
+                              size_t  size);
+extern void  __libc_free     (void   *pointer);
+
+static _Thread_local gboolean         is_accounting = FALSE;
+static _Thread_local AllocationReport current_report;
+static _Thread_local gint64           live_bytes = 0;
+
+static void allocation_accounting_add    (void *pointer);
+
+static void allocation_accounting_remove (void *pointer);
+
+void *
+malloc (size_t size)
+{
+  void *pointer = __libc_malloc (size);
+
+  allocation_accounting_add (pointer);
+
+  return pointer;
+}
+
+void *
+calloc (size_t count,
+        size_t size)
+{
+  void *pointer = __libc_calloc (count, size);
+
+  allocation_accounting_add (pointer);
+
+  return pointer;
+}
+
+void *
+realloc (void   *pointer,
+         size_t  size)
+{
+  gsize previous_size = (pointer != NULL && is_accounting) ? malloc_usable_size (pointer) : 0;
+  void *reallocated_pointer = __libc_realloc (pointer, size);
+
+  /* The block that was reallocated is accounted for as if it was freed, unless the reallocation failed. */
+  if (is_accounting && (reallocated_pointer != NULL || size == 0))
+    {
+      if (pointer != NULL)
+        {
+          current_report.frees_count++;
+          live_bytes -= (gint64) previous_size;
+        }
+
+      allocation_accounting_add (reallocated_pointer);
+    }
+
+  return reallocated_pointer;
+}
+
+void *
+memalign (size_t alignment,
+          size_t size)
+{
+  void *pointer = __libc_memalign (alignment, size);
+
+  allocation_accounting_add (pointer);
+
+  return pointer;
+}
+
+void *
+aligned_alloc (size_t alignment,
+               size_t size)
+{
+  return memalign (alignment, size);
+}
+
+int
+posix_memalign (void   **pointer,
+                size_t   alignment,
+                size_t   size)
+{
+  if (alignment % sizeof (void *) != 0 || (alignment & (alignment - 1)) != 0)
+    return EINVAL;
+
+  void *aligned_pointer = memalign (alignment, size);
+
+  if (aligned_pointer == NULL)
+    return ENOMEM;
+
+  *pointer = aligned_pointer;
+
+  return 0;
+}
+
+void
+free (void *pointer)
+{
+  allocation_accounting_remove (pointer);
+
+  __libc_free (pointer);
+}
+
+void
+allocation_accounting_begin (void)
+{
+  g_return_if_fail (!is_accounting);
+
+  memset (&current_report, 0, sizeof (AllocationReport));
+  live_bytes = 0;
+  is_accounting = TRUE;
+}
+
+void
+allocation_accounting_end (AllocationReport *report)
+{
+  g_return_if_fail (report != NULL);
+
+  is_accounting = FALSE;
+  *report = current_report;
+}
+
+static void
+allocation_accounting_add (void *pointer)
+{
+  if (!is_accounting || pointer == NULL)
+    return;
+
+  gsize size = malloc_usable_size (pointer);
+
+  current_report.allocations_count++;
+  current_report.allocated_bytes += size;
+  live_bytes += (gint64) size;
+
+  if (live_bytes > 0 && (guint64) live_bytes > current_report.peak_bytes)
+    current_report.peak_bytes = (guint64) live_bytes;
+}
+
+static void
+allocation_accounting_remove (void *pointer)
+{
+  if (!is_accounting || pointer == NULL)
+    return;
+
+  current_report.frees_count++;
+  live_bytes -= (gint64) malloc_usable_size (pointer);
+}
+
+#else
+
+void
+allocation_accounting_begin (void)
+{
+}
+
+void
+allocation_accounting_end (AllocationReport *report)
+{
+  g_return_if_fail (report != NULL);
+
+  memset (report, 0, sizeof (AllocationReport));
+}
+
+#endif
@@ -220,30 +220,16 @@ g_queue_unref_g_objects (GQueue *queue)
   g_queue_free (queue);
 }
 
-gboolean
-g_node_unref_g_object (GNode    *node,
-                       gpointer  data)
+gsize
+g_object_get_instance_size (gpointer object)
 {
-  g_return_val_if_fail (node != NULL, TRUE);
-  g_return_val_if_fail (node->data != NULL, TRUE);
-  g_return_val_if_fail (G_IS_OBJECT (node->data), TRUE);
-
-  g_object_unref (node->data);
-
-  return FALSE;
-}
+  g_return_val_if_fail (G_IS_OBJECT (object), 0);
 
-void
-g_node_unref_g_objects (GNode *node)
-{
-  g_return_if_fail (node != NULL);
+  GTypeQuery query;
+  gint private_offset = g_type_class_get_instance_private_offset (G_OBJECT_GET_CLASS (object));
 
-  g_node_traverse (node,
-                   G_IN_ORDER,
-                   G_TRAVERSE_ALL,
-                   -1,
-                   g_node_unref_g_object,
-                   NULL);
+  g_type_query (G_OBJECT_TYPE (object), &query);
 
-  g_node_destroy (node);
+  /* The private data (of the whole class hierarchy) is allocated right in front of the instance. */
+  return query.instance_size + (gsize) ABS (private_offset);
 }
@@ -0,0 +1,216 @@
+#include "internal/common/trace.h"
+
+#include <stdio.h>
+#include <errno.h>
+#include <unistd.h>
+
+static GMutex   trace_mutex;
+static FILE    *trace_file = NULL;
+static gboolean trace_has_events = FALSE;
+static gint     trace_enabled = FALSE;
+static guint    trace_match_sampling_interval = 0;
+static gint     trace_matches_count = 0;
+static gint     trace_threads_count = 0;
+
+/* The threads are numbered in the order in which they emit their first event. */
+static GPrivate trace_thread_id = G_PRIVATE_INIT (NULL);
+
+static void     trace_emit            (const gchar *phase,
+                                       const gchar *category,
+                                       const gchar *name,
+                                       const gchar *arguments);
+
+static guint    trace_fetch_thread_id (void);
+
+gboolean
+trace_start (const gchar  *filename,
+             guint         match_sampling_interval,
+             GError      **error)
+{
+  g_return_val_if_fail (filename != NULL, FALSE);
+  g_return_val_if_fail (error == NULL || *error == NULL, FALSE);
+
+  FILE *file = fopen (filename, "w");
+
+  if (file == NULL)
+    {
+      int saved_errno = errno;
+
+      g_set_error (error,
+                   G_FILE_ERROR,
+                   g_file_error_from_errno (saved_errno),
+                   "Could not open the trace file: %s",
+                   g_strerror (saved_errno));
+
+      return FALSE;
+    }
+
+  /* The previous trace (if any) is completed first. */
+  trace_stop ();
+
+  g_mutex_lock (&trace_mutex);
+
+  trace_file = file;
+  trace_has_events = FALSE;
+  trace_match_sampling_interval = match_sampling_interval;
+  trace_matches_count = 0;
+
+  fputs ("{\"traceEvents\": [\n", trace_file);
+
+  g_atomic_int_set (&trace_enabled, TRUE);
+
+  g_mutex_unlock (&trace_mutex);
+
+  return TRUE;
+}
+
+void
+trace_stop (void)
+{
+  g_mutex_lock (&trace_mutex);
+
+  g_atomic_int_set (&trace_enabled, FALSE);
+
+  if (trace_file != NULL)
+    {
+      fputs ("\n], \"displayTimeUnit\": \"ms\"}\n", trace_file);
+      fclose (trace_file);
+
+      trace_file = NULL;
+    }
+
+  g_mutex_unlock (&trace_mutex);
+}
+
+gboolean
+trace_is_enabled (void)
+{
+  return g_atomic_int_get (&trace_enabled);
+}
+
+gboolean
+trace_samples_match (void)
+{
+  guint match_sampling_interval = trace_match_sampling_interval;
+
+  if (!trace_is_enabled () || match_sampling_interval == 0)
+    return FALSE;
+
+  guint match_index = (guint) g_atomic_int_add (&trace_matches_count, 1);
+
+  return match_index % match_sampling_interval == 0;
+}
+
+void
+trace_begin (const gchar *category,
+             const gchar *name)
+{
+  if (!trace_is_enabled ())
+    return;
+
+  trace_emit ("B", category, name, NULL);
+}
+
+void
+trace_end (const gchar *category,
+           const gchar *name,
+           const gchar *arguments_format,
+           ...)
+{
+  if (!trace_is_enabled ())
+    return;
+
+  g_autofree gchar *arguments = NULL;
+
+  if (arguments_format != NULL)
+    {
+      va_list arguments_list;
+
+      va_start (arguments_list, arguments_format);
+      arguments = g_strdup_vprintf (arguments_format, arguments_list);
+      va_end (arguments_list);
+    }
+
+  trace_emit ("E", category, name, arguments);
+}
+
+gchar *
+trace_quote (const gchar *string)
+{
+  g_return_val_if_fail (string != NULL, NULL);
+
+  GString *quoted_string = g_string_new ("\"");
+
+  for (const gchar *character = string; *character != '\0'; ++character)
+    {
+      switch (*character)
+        {
+        case '"':
+          g_string_append (quoted_string, "\\\"");
+          break;
+
+        case '\\':
+          g_string_append (quoted_string, "\\\\");
+          break;
+
+        default:
+          if ((guchar) *character < 0x20)
+            g_string_append_printf (quoted_string, "\\u%04x", (guchar) *character);
+          else
+            g_string_append_c (quoted_string, *character);
+          break;
+        }
+    }
+
+  g_string_append_c (quoted_string, '"');
+
+  return g_string_free (quoted_string, FALSE);
+}
+
+static void
+trace_emit (const gchar *phase,
+            const gchar *category,
+            const gchar *name,
+            const gchar *arguments)
+{
+  /* The monotonic clock is in microseconds already, which is what the timestamps are expected to be in. */
+  gint64 timestamp = g_get_monotonic_time ();
+  guint thread_id = trace_fetch_thread_id ();
+
+  g_mutex_lock (&trace_mutex);
+
+  /* Tracing might have been stopped in the meantime. */
+  if (trace_file != NULL)
+    {
+      fprintf (trace_file,
+               "%s{\"name\": \"%s\", \"cat\": \"%s\", \"ph\": \"%s\", \"ts\": %" G_GINT64_FORMAT ", "
+               "\"pid\": %d, \"tid\": %u, \"args\": {%s}}",
+               trace_has_events ? ",\n" : "",
+               name,
+               category,
+               phase,
+               timestamp,
+               (gint) getpid (),
+               thread_id,
+               arguments != NULL ? arguments : "");
+
+      trace_has_events = TRUE;
+    }
+
+  g_mutex_unlock (&trace_mutex);
+}
+
+static guint
+trace_fetch_thread_id (void)
+{
+  guint thread_id = GPOINTER_TO_UINT (g_private_get (&trace_thread_id));
+
+  if (thread_id == 0)
+    {
+      thread_id = (guint) g_atomic_int_add (&trace_threads_count, 1) + 1;
+
+      g_private_set (&trace_thread_id, GUINT_TO_POINTER (thread_id));
+    }
+
+  return thread_id;
+}
@@ -104,23 +104,30 @@ lexer_tokenize (Lexer        *self,
 
   while (TRUE)
     {
-      gchar current_character = *normalized_expression++;
+      gchar current_character = *normalized_expression;
 
       if (current_character == END_OF_STRING)
         break;
 
+      /* The transducer only sees the leading byte of a non-ASCII character (which is never special),
+       * the token's content is the whole character nevertheless.
+       */
+      gchar *next_character = g_utf8_next_char (normalized_expression);
       TokenCategory category = (TokenCategory) GPOINTER_TO_INT (transducer_runnable_run (transducer,
                                                                                          current_character));
 
       if (category != TOKEN_CATEGORY_UNDEFINED)
         {
-          g_autofree gchar *content = g_strdup_printf ("%c", current_character);
+          g_autofree gchar *content = g_strndup (normalized_expression,
+                                                 (gsize) (next_character - normalized_expression));
 
           lexer_create_token (category,
                               content,
                               &character_position,
                               tokens);
         }
+
+      normalized_expression = next_character;
     }
 
   /* Appending the end of input marker. */
@@ -144,7 +151,8 @@ lexer_create_token (TokenCategory  category,
   g_autoptr (GString) lexeme_content = g_string_new (content);
   guint lexeme_start_position = 0;
   guint lexeme_end_position = 0;
-  gsize lexeme_content_length = lexeme_content->len;
+  /* Positions are counted in characters rather than bytes. */
+  gsize lexeme_content_length = (gsize) g_utf8_strlen (lexeme_content->str, (gssize) lexeme_content->len);
 
   if (character_position != NULL)
     {
@@ -176,10 +184,12 @@ lexer_build_transducer (void)
   State *regular_context_escape = state_new (PROP_STATE_TYPE_FLAGS, STATE_TYPE_DEFAULT);
   State *bracket_context = state_new (PROP_STATE_TYPE_FLAGS, STATE_TYPE_DEFAULT);
   State *bracket_context_escape = state_new (PROP_STATE_TYPE_FLAGS, STATE_TYPE_DEFAULT);
+  State *bounds_context = state_new (PROP_STATE_TYPE_FLAGS, STATE_TYPE_DEFAULT);
 
   MealyMapping regular_context_mappings[] =
     {
       { '[',   bracket_context,        TOKEN_CATEGORY_OPEN_BRACKET,                         },
+      { '{',   bounds_context,         TOKEN_CATEGORY_BOUNDED_QUANTIFICATION_OPERATOR       },
       { '(',   regular_context,        TOKEN_CATEGORY_OPEN_PARENTHESIS                      },
       { ')',   regular_context,        TOKEN_CATEGORY_CLOSE_PARENTHESIS                     },
       { '^',   regular_context,        TOKEN_CATEGORY_START_ANCHOR,                         },
@@ -225,6 +235,18 @@ lexer_build_transducer (void)
     lexer_create_transitions_from (bracket_context_escape_mappings,
                                    G_N_ELEMENTS (bracket_context_escape_mappings));
 
+  /* Everything up to the closing brace belongs to the bounds of the quantification operator,
+   * the bounds themselves are validated by the parser.
+   */
+  MealyMapping bounds_context_mappings[] =
+    {
+      { '}', regular_context, TOKEN_CATEGORY_CLOSE_BRACE        },
+      { ANY, bounds_context,  TOKEN_CATEGORY_ORDINARY_CHARACTER }
+    };
+  g_autoptr (GPtrArray) bounds_context_transitions =
+    lexer_create_transitions_from (bounds_context_mappings,
+                                   G_N_ELEMENTS (bounds_context_mappings));
+
   g_object_set (regular_context,
                 PROP_STATE_TRANSITIONS, regular_context_transitions,
                 NULL);
@@ -237,9 +259,13 @@ lexer_build_transducer (void)
   g_object_set (bracket_context_escape,
                 PROP_STATE_TRANSITIONS, bracket_context_escape_transitions,
                 NULL);
+  g_object_set (bounds_context,
+                PROP_STATE_TRANSITIONS, bounds_context_transitions,
+                NULL);
 
   g_ptr_array_add_multiple (all_states,
                             regular_context, regular_context_escape, bracket_context, bracket_context_escape,
+                            bounds_context,
                             NULL);
 
   return mealy_new (PROP_FSM_INITIALIZABLE_ALL_STATES, all_states);
@@ -279,10 +305,10 @@ lexer_report_error (const gchar  *expression,
       error_code = LEXICAL_ANALYSIS_LEXER_ERROR_INPUT_NULL;
       error_message = "The expression must not be NULL";
     }
-  else if (!g_str_is_ascii (expression))
+  else if (!g_utf8_validate (expression, -1, NULL))
     {
-      error_code = LEXICAL_ANALYSIS_LEXER_ERROR_INPUT_NOT_ASCII;
-      error_message = "The expression must be an ASCII string";
+      error_code = LEXICAL_ANALYSIS_LEXER_ERROR_INPUT_NOT_UTF8;
+      error_message = "The expression must be a valid UTF-8 string";
     }
 
   if (error_message != NULL)
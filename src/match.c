@@ -12,6 +12,7 @@ typedef struct
   GString *value;
   guint    range_begin;
   guint    range_end;
+  GArray  *captures;
 } MatchPrivate;
 
 enum
@@ -19,6 +20,7 @@ enum
   PROP_VALUE = 1,
   PROP_RANGE_BEGIN,
   PROP_RANGE_END,
+  PROP_CAPTURES,
   N_PROPERTIES
 };
 
@@ -77,6 +79,14 @@ match_class_init (MatchClass *klass)
                        0,
                        G_PARAM_CONSTRUCT_ONLY | G_PARAM_READWRITE);
 
+  obj_properties[PROP_CAPTURES] =
+    g_param_spec_boxed (PROP_MATCH_CAPTURES,
+                        "Captures",
+                        "Beginning and ending positions of the substrings matched by each one of the "
+                          "capture groups (negative for the groups which did not take part in the match).",
+                        G_TYPE_ARRAY,
+                        G_PARAM_CONSTRUCT_ONLY | G_PARAM_READWRITE);
+
   g_object_class_install_properties (object_class,
                                      N_PROPERTIES,
                                      obj_properties);
@@ -135,6 +145,10 @@ match_get_property (GObject    *object,
       g_value_set_uint (value, priv->range_end);
       break;
 
+    case PROP_CAPTURES:
+      g_value_set_boxed (value, priv->captures);
+      break;
+
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
       break;
@@ -166,6 +180,13 @@ match_set_property (GObject      *object,
       priv->range_end = g_value_get_uint (value);
       break;
 
+    case PROP_CAPTURES:
+      if (priv->captures != NULL)
+        g_array_unref (priv->captures);
+
+      priv->captures = g_value_dup_boxed (value);
+      break;
+
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
       break;
@@ -180,5 +201,8 @@ match_finalize (GObject *object)
   if (priv->value != NULL)
     g_string_free (priv->value, TRUE);
 
+  if (priv->captures != NULL)
+    g_array_unref (priv->captures);
+
   G_OBJECT_CLASS (match_parent_class)->finalize (object);
 }
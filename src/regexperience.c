@@ -1,9 +1,18 @@
 #include "core/regexperience.h"
 #include "internal/lexical_analysis/lexer.h"
 #include "internal/syntactic_analysis/parser.h"
-#include "internal/semantic_analysis/analyzer.h"
+#include "internal/semantic_analysis/position_automaton.h"
 #include "internal/state_machines/acceptors/acceptor_runnable.h"
+#include "internal/state_machines/acceptors/dfa.h"
+#include "internal/state_machines/acceptors/leftmost_longest_dfa.h"
+#include "internal/state_machines/acceptors/dfa_generator.h"
+#include "internal/state_machines/transitions/transition.h"
+#include "internal/state_machines/compilation_budget.h"
 #include "internal/common/helpers.h"
+#include "internal/common/trace.h"
+#include "internal/common/allocation_accounting.h"
+
+#include <string.h>
 
 struct _Regexperience
 {
@@ -15,13 +24,95 @@ typedef struct
   /* Compilation */
   Lexer            *lexer;
   Parser           *parser;
-  Analyzer         *analyzer;
+  guint             max_states;
+  guint64           max_bytes;
+  gint64            time_limit;
+  gboolean          nfa_fallback;
+  gboolean          bit_parallel;
+  gboolean          leftmost_longest;
+  gboolean          captures;
+  gboolean          profiling;
+  CompileReport     report;
+  gboolean          allocation_accounting;
+  AllocationReport  compile_allocations;
 
   /* Matching */
   AcceptorRunnable *acceptor;
+  gboolean          counters;
+  MatchCounters     match_counters;
+  AllocationReport  match_allocations;
+  GMutex            match_counters_mutex;
 } RegexperiencePrivate;
 
-static void regexperience_dispose (GObject *object);
+enum
+{
+  PROP_MAX_STATES = 1,
+  PROP_MAX_BYTES,
+  PROP_TIME_LIMIT,
+  PROP_NFA_FALLBACK,
+  PROP_BIT_PARALLEL,
+  PROP_LEFTMOST_LONGEST,
+  PROP_CAPTURES,
+  PROP_PROFILING,
+  PROP_COUNTERS,
+  PROP_ALLOCATION_ACCOUNTING,
+  N_PROPERTIES
+};
+
+static GParamSpec *obj_properties[N_PROPERTIES] = { NULL };
+
+/* Every thread's counters are summed up over all of the expressions it matched with. */
+static GPrivate thread_match_counters = G_PRIVATE_INIT (g_free);
+
+static AstNode           *regexperience_build_abstract_syntax_tree (Regexperience      *self,
+                                                                    const gchar        *expression,
+                                                                    CompileReport      *report,
+                                                                    GError            **error);
+
+static CompilationBudget *regexperience_create_budget              (Regexperience      *self,
+                                                                    gint64              deadline);
+
+static FsmConvertible    *regexperience_build_nfa                  (AstNode            *abstract_syntax_tree,
+                                                                    CompilationBudget  *budget,
+                                                                    CompileReport      *report);
+
+static FsmModifiable     *regexperience_build_dfa                  (FsmConvertible     *nfa,
+                                                                    CompilationBudget  *budget,
+                                                                    CompileReport      *report);
+
+static AcceptorRunnable  *regexperience_build_leftmost_longest_dfa (AstNode            *abstract_syntax_tree,
+                                                                    FsmModifiable      *dfa,
+                                                                    CompilationBudget  *budget);
+
+static AcceptorRunnable  *regexperience_build_tagged_nfa           (AstNode            *abstract_syntax_tree,
+                                                                    CompilationBudget  *budget);
+
+static gboolean           regexperience_can_fall_back              (Regexperience      *self,
+                                                                    CompilationBudget  *budget);
+
+static Dfa               *regexperience_fetch_dfa                  (Regexperience      *self,
+                                                                    GError            **error);
+
+static void               regexperience_finish_compilation         (Regexperience      *self,
+                                                                    const gchar        *expression,
+                                                                    gboolean            is_compiled);
+
+static void               regexperience_set_budget_error           (CompilationBudget  *budget,
+                                                                    GError            **error);
+
+static void               regexperience_get_property               (GObject            *object,
+                                                                    guint               property_id,
+                                                                    GValue             *value,
+                                                                    GParamSpec         *pspec);
+
+static void               regexperience_set_property               (GObject            *object,
+                                                                    guint               property_id,
+                                                                    const GValue       *value,
+                                                                    GParamSpec         *pspec);
+
+static void               regexperience_dispose                    (GObject            *object);
+
+static void               regexperience_finalize                   (GObject            *object);
 
 G_DEFINE_QUARK (core-regexperience-error-quark, core_regexperience_error)
 #define CORE_REGEXPERIENCE_ERROR (core_regexperience_error_quark ())
@@ -33,7 +124,101 @@ regexperience_class_init (RegexperienceClass *klass)
 {
   GObjectClass *object_class = G_OBJECT_CLASS (klass);
 
+  object_class->get_property = regexperience_get_property;
+  object_class->set_property = regexperience_set_property;
   object_class->dispose = regexperience_dispose;
+  object_class->finalize = regexperience_finalize;
+
+  obj_properties[PROP_MAX_STATES] =
+    g_param_spec_uint (PROP_REGEXPERIENCE_MAX_STATES,
+                       "Max states",
+                       "Maximum number of states that the NFA and the DFA built during the compilation "
+                         "may consist of (zero stands for no limit).",
+                       0,
+                       G_MAXUINT,
+                       0,
+                       G_PARAM_READWRITE);
+
+  obj_properties[PROP_MAX_BYTES] =
+    g_param_spec_uint64 (PROP_REGEXPERIENCE_MAX_BYTES,
+                         "Max bytes",
+                         "Maximum (approximate) number of bytes that the state machines built during the "
+                           "compilation may occupy (zero stands for no limit).",
+                         0,
+                         G_MAXUINT64,
+                         0,
+                         G_PARAM_READWRITE);
+
+  obj_properties[PROP_TIME_LIMIT] =
+    g_param_spec_int64 (PROP_REGEXPERIENCE_TIME_LIMIT,
+                        "Time limit",
+                        "Maximum amount of time (in microseconds) that a single compilation may take "
+                          "(zero stands for no limit).",
+                        0,
+                        G_MAXINT64,
+                        0,
+                        G_PARAM_READWRITE);
+
+  obj_properties[PROP_NFA_FALLBACK] =
+    g_param_spec_boolean (PROP_REGEXPERIENCE_NFA_FALLBACK,
+                          "NFA fallback",
+                          "Whether the NFA should be simulated directly in case the DFA would exceed "
+                            "the maximum number of states or bytes.",
+                          TRUE,
+                          G_PARAM_READWRITE);
+
+  obj_properties[PROP_BIT_PARALLEL] =
+    g_param_spec_boolean (PROP_REGEXPERIENCE_BIT_PARALLEL,
+                          "Bit-parallel",
+                          "Whether expressions consisting of at most 64 positions should be simulated "
+                            "bit-parallel instead of being converted to a DFA.",
+                          TRUE,
+                          G_PARAM_READWRITE);
+
+  obj_properties[PROP_LEFTMOST_LONGEST] =
+    g_param_spec_boolean (PROP_REGEXPERIENCE_LEFTMOST_LONGEST,
+                          "Leftmost-longest",
+                          "Whether each match should begin as early and end as late as possible "
+                            "(a reverse DFA is built in order to find where the matches begin).",
+                          FALSE,
+                          G_PARAM_READWRITE);
+
+  obj_properties[PROP_CAPTURES] =
+    g_param_spec_boolean (PROP_REGEXPERIENCE_CAPTURES,
+                          "Captures",
+                          "Whether the substrings matched by the capture groups should be reported "
+                            "(the position automaton is simulated directly in that case).",
+                          FALSE,
+                          G_PARAM_READWRITE);
+
+  obj_properties[PROP_PROFILING] =
+    g_param_spec_boolean (PROP_REGEXPERIENCE_PROFILING,
+                          "Profiling",
+                          "Whether the DFA should count the state visits and the transitions taken "
+                            "while matching (see regexperience_export_profile).",
+                          FALSE,
+                          G_PARAM_READWRITE);
+
+  obj_properties[PROP_COUNTERS] =
+    g_param_spec_boolean (PROP_REGEXPERIENCE_COUNTERS,
+                          "Counters",
+                          "Whether the matching engines should count the bytes scanned, the resets, "
+                            "the dead state transitions, the matches and the skips "
+                            "(see regexperience_get_counters).",
+                          FALSE,
+                          G_PARAM_READWRITE);
+
+  obj_properties[PROP_ALLOCATION_ACCOUNTING] =
+    g_param_spec_boolean (PROP_REGEXPERIENCE_ALLOCATION_ACCOUNTING,
+                          "Allocation accounting",
+                          "Whether the allocations made by each compilation and each match should be counted "
+                            "(see regexperience_get_allocations).",
+                          FALSE,
+                          G_PARAM_READWRITE);
+
+  g_object_class_install_properties (object_class,
+                                     N_PROPERTIES,
+                                     obj_properties);
 }
 
 static void
@@ -43,7 +228,10 @@ regexperience_init (Regexperience *self)
 
   priv->lexer = lexer_new ();
   priv->parser = parser_new ();
-  priv->analyzer = analyzer_new ();
+  priv->nfa_fallback = TRUE;
+  priv->bit_parallel = TRUE;
+
+  g_mutex_init (&priv->match_counters_mutex);
 }
 
 void
@@ -55,59 +243,111 @@ regexperience_compile (Regexperience  *self,
   g_return_if_fail (error == NULL || *error == NULL);
 
   RegexperiencePrivate *priv = regexperience_get_instance_private (self);
-  Lexer *lexer = priv->lexer;
-  Parser *parser = priv->parser;
-  Analyzer *analyzer = priv->analyzer;
-  GError *temporary_error = NULL;
+  CompileReport *report = &priv->report;
+  gint64 compilation_start = g_get_monotonic_time ();
+  gint64 deadline = 0;
 
-  g_autoptr (GPtrArray) tokens = lexer_tokenize (lexer,
-                                                 expression,
-                                                 &temporary_error);
+  /* The report always describes the most recent compilation, even the one that failed. */
+  memset (report, 0, sizeof (CompileReport));
+  memset (&priv->compile_allocations, 0, sizeof (AllocationReport));
+  trace_begin ("compile", "compilation");
 
-  if (temporary_error != NULL)
+  if (priv->allocation_accounting)
+    allocation_accounting_begin ();
+
+  /* The time limit covers the whole compilation, including the lexical and syntactic analysis. */
+  if (priv->time_limit != 0)
+    deadline = compilation_start + priv->time_limit;
+
+  g_autoptr (CompilationBudget) budget = regexperience_create_budget (self, deadline);
+  g_autoptr (AstNode) abstract_syntax_tree = regexperience_build_abstract_syntax_tree (self,
+                                                                                      expression,
+                                                                                      report,
+                                                                                      error);
+
+  if (abstract_syntax_tree == NULL)
     {
-      g_propagate_error (error, temporary_error);
+      report->total_time = g_get_monotonic_time () - compilation_start;
+      regexperience_finish_compilation (self, expression, FALSE);
 
       return;
     }
 
-  GNode *concrete_syntax_tree = parser_build_concrete_syntax_tree (parser,
-                                                                   tokens,
-                                                                   &temporary_error);
+  AcceptorRunnable *acceptor = NULL;
+  g_autoptr (FsmConvertible) nfa = NULL;
 
-  if (temporary_error != NULL)
+  /* Short expressions are simulated bit-parallel, neither the subset construction nor the minimization
+   * are needed in that case (the state machine's size is fixed so the budget does not apply either).
+   * The construction is only reported in case the position automaton is actually used, otherwise
+   * the NFA's construction (which follows) is the one that counts.
+   */
+  if (priv->captures || (priv->bit_parallel && !priv->leftmost_longest))
     {
-      g_propagate_error (error, temporary_error);
+      gint64 construction_start = g_get_monotonic_time ();
 
-      return;
+      trace_begin ("compile", "position automaton construction");
+
+      if (priv->captures)
+        acceptor = regexperience_build_tagged_nfa (abstract_syntax_tree, budget);
+      else
+        acceptor = build_bit_parallel_automaton (abstract_syntax_tree);
+
+      if (acceptor != NULL)
+        report->construction_time += g_get_monotonic_time () - construction_start;
+
+      trace_end ("compile", "position automaton construction", NULL);
     }
 
-  g_autoptr (AstNode) abstract_syntax_tree = analyzer_build_abstract_syntax_tree (analyzer,
-                                                                                  concrete_syntax_tree,
-                                                                                  &temporary_error);
+  if (acceptor == NULL && !priv->captures)
+    nfa = regexperience_build_nfa (abstract_syntax_tree, budget, report);
+
+  if (nfa != NULL)
+    {
+      FsmModifiable *dfa = regexperience_build_dfa (nfa, budget, report);
+
+      if (dfa != NULL && priv->leftmost_longest)
+        {
+          acceptor = regexperience_build_leftmost_longest_dfa (abstract_syntax_tree, dfa, budget);
 
-  /* Manually decreasing the reference count of every object found
-   * in the concrete syntax tree and finally destroying the GNode itself.
+          g_object_unref (dfa);
+        }
+      else if (dfa != NULL)
+        {
+          acceptor = ACCEPTORS_ACCEPTOR_RUNNABLE (dfa);
+        }
+    }
+
+  /* The subset construction modifies the states of the NFA it was given, a fresh NFA (built with its own budget)
+   * is therefore simulated directly in case the DFA turned out to be too large.
    */
-  g_node_unref_g_objects (concrete_syntax_tree);
+  if (acceptor == NULL && regexperience_can_fall_back (self, budget))
+    {
+      g_clear_object (&budget);
 
-  if (temporary_error != NULL)
+      budget = regexperience_create_budget (self, deadline);
+      acceptor = ACCEPTORS_ACCEPTOR_RUNNABLE (regexperience_build_nfa (abstract_syntax_tree, budget, report));
+    }
+
+  report->total_time = g_get_monotonic_time () - compilation_start;
+  regexperience_finish_compilation (self, expression, acceptor != NULL);
+
+  /* The previously compiled expression (if any) is kept in case the budget is exceeded. */
+  if (acceptor == NULL)
     {
-      g_propagate_error (error, temporary_error);
+      regexperience_set_budget_error (budget, error);
 
       return;
     }
 
+  if (priv->profiling && ACCEPTORS_IS_DFA (acceptor))
+    g_object_set (acceptor,
+                  PROP_DFA_PROFILING, TRUE,
+                  NULL);
+
   if (priv->acceptor != NULL)
     g_object_unref (priv->acceptor);
 
-  g_autoptr (FsmConvertible) epsilon_nfa = ast_node_build_acceptor (abstract_syntax_tree);
-  g_autoptr (FsmConvertible) nfa = fsm_convertible_compute_epsilon_closures (epsilon_nfa);
-  FsmModifiable *dfa = fsm_convertible_construct_subset (nfa);
-
-  fsm_modifiable_minimize (dfa);
-
-  priv->acceptor = ACCEPTORS_ACCEPTOR_RUNNABLE (dfa);
+  priv->acceptor = acceptor;
 }
 
 gboolean
@@ -135,11 +375,6 @@ regexperience_match (Regexperience  *self,
       error_message = "The input must not be NULL";
       error_code = CORE_REGEXPERIENCE_ERROR_INPUT_NULL;
     }
-  else if (!g_str_is_ascii (input))
-    {
-      error_message = "The input must be an ASCII string";
-      error_code = CORE_REGEXPERIENCE_ERROR_INPUT_NOT_ASCII;
-    }
 
   if (error_message != NULL)
     {
@@ -151,12 +386,731 @@ regexperience_match (Regexperience  *self,
       return FALSE;
     }
 
-  *matches = acceptor_runnable_run (acceptor, input);
+  gboolean is_match_traced = trace_samples_match ();
+
+  if (is_match_traced)
+    trace_begin ("match", "match");
+
+  if (priv->allocation_accounting)
+    allocation_accounting_begin ();
+
+  if (priv->counters)
+    {
+      MatchCounters counters = { 0 };
+      MatchCounters *thread_counters = g_private_get (&thread_match_counters);
+
+      *matches = acceptor_runnable_run (acceptor, input, &counters);
+
+      g_mutex_lock (&priv->match_counters_mutex);
+      match_counters_add (&priv->match_counters, &counters);
+      g_mutex_unlock (&priv->match_counters_mutex);
+
+      if (thread_counters == NULL)
+        {
+          thread_counters = g_new0 (MatchCounters, 1);
+
+          g_private_set (&thread_match_counters, thread_counters);
+        }
+
+      match_counters_add (thread_counters, &counters);
+    }
+  else
+    {
+      *matches = acceptor_runnable_run (acceptor, input, NULL);
+    }
+
+  if (priv->allocation_accounting)
+    {
+      AllocationReport allocations;
+
+      allocation_accounting_end (&allocations);
+
+      g_mutex_lock (&priv->match_counters_mutex);
+      priv->match_allocations = allocations;
+      g_mutex_unlock (&priv->match_counters_mutex);
+    }
+
+  if (is_match_traced)
+    trace_end ("match", "match",
+               "\"bytes\": %" G_GSIZE_FORMAT ", \"matches\": %u",
+               strlen (input),
+               *matches != NULL ? (*matches)->len : 0);
 
   return g_collection_has_items (*matches)
       && acceptor_runnable_can_accept (acceptor);
 }
 
+gboolean
+regexperience_generate_matcher (Regexperience  *self,
+                                const gchar    *expression,
+                                const gchar    *matcher_name,
+                                gchar         **source,
+                                gchar         **header,
+                                GError        **error)
+{
+  g_return_val_if_fail (CORE_IS_REGEXPERIENCE (self), FALSE);
+  g_return_val_if_fail (source != NULL && *source == NULL, FALSE);
+  g_return_val_if_fail (header != NULL && *header == NULL, FALSE);
+  g_return_val_if_fail (error == NULL || *error == NULL, FALSE);
+
+  RegexperiencePrivate *priv = regexperience_get_instance_private (self);
+  gint64 deadline = 0;
+
+  if (!dfa_generator_is_valid_name (matcher_name))
+    {
+      g_set_error (error,
+                   CORE_REGEXPERIENCE_ERROR,
+                   CORE_REGEXPERIENCE_ERROR_MATCHER_NAME_INVALID,
+                   "The matcher name must be a valid C identifier");
+
+      return FALSE;
+    }
+
+  if (priv->time_limit != 0)
+    deadline = g_get_monotonic_time () + priv->time_limit;
+
+  g_autoptr (CompilationBudget) budget = regexperience_create_budget (self, deadline);
+  g_autoptr (AstNode) abstract_syntax_tree = regexperience_build_abstract_syntax_tree (self,
+                                                                                      expression,
+                                                                                      NULL,
+                                                                                      error);
+
+  if (abstract_syntax_tree == NULL)
+    return FALSE;
+
+  /* The generated matcher always consists of the minimized DFA, there is nothing to fall back to. */
+  g_autoptr (FsmConvertible) nfa = regexperience_build_nfa (abstract_syntax_tree, budget, NULL);
+  g_autoptr (FsmModifiable) dfa = NULL;
+
+  if (nfa != NULL)
+    dfa = regexperience_build_dfa (nfa, budget, NULL);
+
+  if (dfa == NULL)
+    {
+      regexperience_set_budget_error (budget, error);
+
+      return FALSE;
+    }
+
+  g_autoptr (DfaTable) table = dfa_table_new (ACCEPTORS_DFA (dfa));
+
+  *source = dfa_generator_emit_source (table,
+                                       dfa_table_is_anchored_on (table, START),
+                                       matcher_name);
+  *header = dfa_generator_emit_header (matcher_name, expression);
+
+  return TRUE;
+}
+
+void
+regexperience_get_compile_report (Regexperience *self,
+                                  CompileReport *report)
+{
+  g_return_if_fail (CORE_IS_REGEXPERIENCE (self));
+  g_return_if_fail (report != NULL);
+
+  RegexperiencePrivate *priv = regexperience_get_instance_private (self);
+
+  *report = priv->report;
+}
+
+gboolean
+regexperience_get_stats (Regexperience   *self,
+                         AutomatonStats  *stats,
+                         GError         **error)
+{
+  g_return_val_if_fail (CORE_IS_REGEXPERIENCE (self), FALSE);
+  g_return_val_if_fail (stats != NULL, FALSE);
+  g_return_val_if_fail (error == NULL || *error == NULL, FALSE);
+
+  RegexperiencePrivate *priv = regexperience_get_instance_private (self);
+
+  if (priv->acceptor == NULL)
+    {
+      g_set_error (error,
+                   CORE_REGEXPERIENCE_ERROR,
+                   CORE_REGEXPERIENCE_ERROR_REGULAR_EXPRESSION_NOT_COMPILED,
+                   "The expression must be compiled beforehand");
+
+      return FALSE;
+    }
+
+  acceptor_runnable_measure (priv->acceptor, stats);
+
+  return TRUE;
+}
+
+void
+regexperience_get_counters (Regexperience *self,
+                            MatchCounters *counters)
+{
+  g_return_if_fail (CORE_IS_REGEXPERIENCE (self));
+  g_return_if_fail (counters != NULL);
+
+  RegexperiencePrivate *priv = regexperience_get_instance_private (self);
+
+  g_mutex_lock (&priv->match_counters_mutex);
+  *counters = priv->match_counters;
+  g_mutex_unlock (&priv->match_counters_mutex);
+}
+
+void
+regexperience_reset_counters (Regexperience *self)
+{
+  g_return_if_fail (CORE_IS_REGEXPERIENCE (self));
+
+  RegexperiencePrivate *priv = regexperience_get_instance_private (self);
+
+  g_mutex_lock (&priv->match_counters_mutex);
+  memset (&priv->match_counters, 0, sizeof (MatchCounters));
+  g_mutex_unlock (&priv->match_counters_mutex);
+}
+
+void
+regexperience_get_allocations (Regexperience    *self,
+                               AllocationReport *compile_allocations,
+                               AllocationReport *match_allocations)
+{
+  g_return_if_fail (CORE_IS_REGEXPERIENCE (self));
+
+  RegexperiencePrivate *priv = regexperience_get_instance_private (self);
+
+  if (compile_allocations != NULL)
+    *compile_allocations = priv->compile_allocations;
+
+  if (match_allocations != NULL)
+    {
+      g_mutex_lock (&priv->match_counters_mutex);
+      *match_allocations = priv->match_allocations;
+      g_mutex_unlock (&priv->match_counters_mutex);
+    }
+}
+
+void
+regexperience_get_thread_counters (MatchCounters *counters)
+{
+  g_return_if_fail (counters != NULL);
+
+  MatchCounters *thread_counters = g_private_get (&thread_match_counters);
+
+  if (thread_counters != NULL)
+    *counters = *thread_counters;
+  else
+    memset (counters, 0, sizeof (MatchCounters));
+}
+
+gboolean
+regexperience_start_tracing (const gchar  *filename,
+                             guint         match_sampling_interval,
+                             GError      **error)
+{
+  g_return_val_if_fail (filename != NULL, FALSE);
+  g_return_val_if_fail (error == NULL || *error == NULL, FALSE);
+
+  return trace_start (filename, match_sampling_interval, error);
+}
+
+void
+regexperience_stop_tracing (void)
+{
+  trace_stop ();
+}
+
+gchar *
+regexperience_export_profile (Regexperience  *self,
+                              GError        **error)
+{
+  g_return_val_if_fail (CORE_IS_REGEXPERIENCE (self), NULL);
+  g_return_val_if_fail (error == NULL || *error == NULL, NULL);
+
+  Dfa *dfa = regexperience_fetch_dfa (self, error);
+
+  if (dfa == NULL)
+    return NULL;
+
+  gchar *profile = dfa_export_profile (dfa);
+
+  if (profile == NULL)
+    g_set_error (error,
+                 CORE_REGEXPERIENCE_ERROR,
+                 CORE_REGEXPERIENCE_ERROR_PROFILE_UNAVAILABLE,
+                 "Profiling must be enabled before the expression is compiled");
+
+  return profile;
+}
+
+gboolean
+regexperience_apply_profile (Regexperience  *self,
+                             const gchar    *profile,
+                             GError        **error)
+{
+  g_return_val_if_fail (CORE_IS_REGEXPERIENCE (self), FALSE);
+  g_return_val_if_fail (profile != NULL, FALSE);
+  g_return_val_if_fail (error == NULL || *error == NULL, FALSE);
+
+  Dfa *dfa = regexperience_fetch_dfa (self, error);
+
+  if (dfa == NULL)
+    return FALSE;
+
+  if (!dfa_apply_profile (dfa, profile))
+    {
+      g_set_error (error,
+                   CORE_REGEXPERIENCE_ERROR,
+                   CORE_REGEXPERIENCE_ERROR_PROFILE_INVALID,
+                   "The profile is malformed or it does not match the compiled expression");
+
+      return FALSE;
+    }
+
+  return TRUE;
+}
+
+static AstNode *
+regexperience_build_abstract_syntax_tree (Regexperience  *self,
+                                          const gchar    *expression,
+                                          CompileReport  *report,
+                                          GError        **error)
+{
+  RegexperiencePrivate *priv = regexperience_get_instance_private (self);
+  GError *temporary_error = NULL;
+  gint64 phase_start = g_get_monotonic_time ();
+
+  trace_begin ("compile", "tokenization");
+
+  g_autoptr (GPtrArray) tokens = lexer_tokenize (priv->lexer,
+                                                 expression,
+                                                 &temporary_error);
+
+  if (report != NULL)
+    report->tokenization_time = g_get_monotonic_time () - phase_start;
+
+  trace_end ("compile", "tokenization", "\"tokens\": %u", tokens != NULL ? tokens->len : 0);
+
+  if (temporary_error != NULL)
+    {
+      g_propagate_error (error, temporary_error);
+
+      return NULL;
+    }
+
+  phase_start = g_get_monotonic_time ();
+
+  trace_begin ("compile", "parsing");
+
+  /* The semantic actions are performed while parsing, the AST is therefore built in the same phase. */
+  AstNode *abstract_syntax_tree = parser_build_abstract_syntax_tree (priv->parser,
+                                                                     tokens,
+                                                                     &temporary_error);
+
+  trace_end ("compile", "parsing", NULL);
+
+  if (report != NULL)
+    {
+      report->parsing_time = g_get_monotonic_time () - phase_start;
+      report->tokens_count = tokens->len;
+    }
+
+  if (temporary_error != NULL)
+    {
+      g_propagate_error (error, temporary_error);
+
+      return NULL;
+    }
+
+  if (report != NULL)
+    report->ast_nodes_count = count_nodes (abstract_syntax_tree);
+
+  return abstract_syntax_tree;
+}
+
+static CompilationBudget *
+regexperience_create_budget (Regexperience *self,
+                             gint64         deadline)
+{
+  RegexperiencePrivate *priv = regexperience_get_instance_private (self);
+
+  return compilation_budget_new (PROP_COMPILATION_BUDGET_MAX_STATES, priv->max_states,
+                                 PROP_COMPILATION_BUDGET_MAX_BYTES, priv->max_bytes,
+                                 PROP_COMPILATION_BUDGET_DEADLINE, deadline);
+}
+
+static FsmConvertible *
+regexperience_build_nfa (AstNode           *abstract_syntax_tree,
+                         CompilationBudget *budget,
+                         CompileReport     *report)
+{
+  /* Estimating the number of NFA states before any state machine is built - this is what prevents
+   * expressions such as nested bounded repetitions from consuming a lot of memory up front.
+   */
+  guint nfa_states_count = MIN (count_positions (abstract_syntax_tree), G_MAXUINT - 1) + 1;
+
+  if (!compilation_budget_allows_states (budget, nfa_states_count))
+    return NULL;
+
+#ifdef REGEXPERIENCE_POSITION_AUTOMATON
+  if (!compilation_budget_charge (budget, nfa_states_count, 0))
+    return NULL;
+#endif
+
+  gint64 phase_start = g_get_monotonic_time ();
+  FsmConvertible *nfa = NULL;
+
+  trace_begin ("compile", "construction");
+
+#ifdef REGEXPERIENCE_POSITION_AUTOMATON
+  /* The position (Glushkov) automaton is epsilon-free by construction, it consists of exactly one
+   * state per position and the start state.
+   */
+  nfa = build_position_automaton (abstract_syntax_tree);
+
+  if (report != NULL)
+    report->construction_time += g_get_monotonic_time () - phase_start;
+
+  trace_end ("compile", "construction", NULL);
+#else
+  g_autoptr (FsmConvertible) epsilon_nfa = ast_node_build_acceptor (abstract_syntax_tree);
+
+  trace_end ("compile", "construction", NULL);
+
+  if (report != NULL)
+    {
+      report->construction_time += g_get_monotonic_time () - phase_start;
+
+      fsm_count_states_and_transitions (STATE_MACHINES_FSM (epsilon_nfa),
+                                        &report->epsilon_nfa_states_count,
+                                        &report->epsilon_nfa_transitions_count);
+    }
+
+  phase_start = g_get_monotonic_time ();
+
+  trace_begin ("compile", "epsilon closures");
+
+  nfa = fsm_convertible_compute_epsilon_closures (epsilon_nfa, budget);
+
+  if (report != NULL)
+    report->epsilon_closures_time += g_get_monotonic_time () - phase_start;
+
+  trace_end ("compile", "epsilon closures", NULL);
+#endif
+
+  if (report != NULL && nfa != NULL)
+    fsm_count_states_and_transitions (STATE_MACHINES_FSM (nfa),
+                                      &report->nfa_states_count,
+                                      &report->nfa_transitions_count);
+
+  return nfa;
+}
+
+static FsmModifiable *
+regexperience_build_dfa (FsmConvertible    *nfa,
+                         CompilationBudget *budget,
+                         CompileReport     *report)
+{
+  gint64 phase_start = g_get_monotonic_time ();
+
+  trace_begin ("compile", "subset construction");
+
+  FsmModifiable *dfa = fsm_convertible_construct_subset (nfa, budget);
+
+  if (report != NULL)
+    report->subset_construction_time += g_get_monotonic_time () - phase_start;
+
+  trace_end ("compile", "subset construction", NULL);
+
+  if (dfa == NULL)
+    return NULL;
+
+  /* Counted before the minimization modifies the DFA in place. */
+  if (report != NULL)
+    fsm_count_states_and_transitions (STATE_MACHINES_FSM (dfa),
+                                      &report->dfa_states_count,
+                                      &report->dfa_transitions_count);
+
+  phase_start = g_get_monotonic_time ();
+
+  trace_begin ("compile", "minimization");
+
+  fsm_modifiable_minimize (dfa, budget);
+
+  if (report != NULL)
+    {
+      report->minimization_time += g_get_monotonic_time () - phase_start;
+
+      fsm_count_states_and_transitions (STATE_MACHINES_FSM (dfa),
+                                        &report->minimized_dfa_states_count,
+                                        &report->minimized_dfa_transitions_count);
+    }
+
+  trace_end ("compile", "minimization", NULL);
+
+  if (compilation_budget_is_exceeded (budget))
+    {
+      g_object_unref (dfa);
+
+      return NULL;
+    }
+
+  return dfa;
+}
+
+static AcceptorRunnable *
+regexperience_build_leftmost_longest_dfa (AstNode           *abstract_syntax_tree,
+                                          FsmModifiable     *dfa,
+                                          CompilationBudget *budget)
+{
+  guint reverse_nfa_states_count = MIN (count_positions (abstract_syntax_tree), G_MAXUINT - 1) + 1;
+
+  if (!compilation_budget_allows_states (budget, reverse_nfa_states_count) ||
+      !compilation_budget_charge (budget, reverse_nfa_states_count, 0))
+    return NULL;
+
+  /* The reverse DFA is always built from the position automaton, whatever the forward one was built from. */
+  g_autoptr (FsmConvertible) reverse_nfa = build_reverse_position_automaton (abstract_syntax_tree);
+  g_autoptr (FsmModifiable) reverse_dfa = regexperience_build_dfa (reverse_nfa, budget, NULL);
+
+  if (reverse_dfa == NULL)
+    return NULL;
+
+  return ACCEPTORS_ACCEPTOR_RUNNABLE (leftmost_longest_dfa_new (PROP_LEFTMOST_LONGEST_DFA_FORWARD_DFA, dfa,
+                                                                PROP_LEFTMOST_LONGEST_DFA_REVERSE_DFA, reverse_dfa));
+}
+
+static AcceptorRunnable *
+regexperience_build_tagged_nfa (AstNode           *abstract_syntax_tree,
+                                CompilationBudget *budget)
+{
+  guint tagged_nfa_states_count = MIN (count_positions (abstract_syntax_tree), G_MAXUINT - 1) + 1;
+
+  if (!compilation_budget_allows_states (budget, tagged_nfa_states_count) ||
+      !compilation_budget_charge (budget, tagged_nfa_states_count, 0))
+    return NULL;
+
+  /* The groups are tracked on the position automaton's edges, no other state machine is built in that case. */
+  return build_tagged_automaton (abstract_syntax_tree);
+}
+
+static gboolean
+regexperience_can_fall_back (Regexperience     *self,
+                             CompilationBudget *budget)
+{
+  RegexperiencePrivate *priv = regexperience_get_instance_private (self);
+  CompilationBudgetLimit exceeded_limit = COMPILATION_BUDGET_LIMIT_NONE;
+
+  /* The NFA is simulated the default way only, it cannot find where the leftmost-longest matches begin
+   * (the tagged one is already simulated directly).
+   */
+  if (!priv->nfa_fallback || priv->leftmost_longest || priv->captures)
+    return FALSE;
+
+  g_object_get (budget,
+                PROP_COMPILATION_BUDGET_EXCEEDED_LIMIT, &exceeded_limit,
+                NULL);
+
+  /* Simulating the NFA does not help in case the time limit was exceeded. */
+  return exceeded_limit == COMPILATION_BUDGET_LIMIT_STATES
+      || exceeded_limit == COMPILATION_BUDGET_LIMIT_BYTES;
+}
+
+static Dfa *
+regexperience_fetch_dfa (Regexperience  *self,
+                         GError        **error)
+{
+  RegexperiencePrivate *priv = regexperience_get_instance_private (self);
+
+  if (priv->acceptor == NULL)
+    {
+      g_set_error (error,
+                   CORE_REGEXPERIENCE_ERROR,
+                   CORE_REGEXPERIENCE_ERROR_REGULAR_EXPRESSION_NOT_COMPILED,
+                   "The expression must be compiled beforehand");
+
+      return NULL;
+    }
+
+  /* Only the DFA's states are laid out in a table, the remaining engines have nothing to renumber. */
+  if (!ACCEPTORS_IS_DFA (priv->acceptor))
+    {
+      g_set_error (error,
+                   CORE_REGEXPERIENCE_ERROR,
+                   CORE_REGEXPERIENCE_ERROR_PROFILE_UNAVAILABLE,
+                   "The expression must be compiled to a DFA");
+
+      return NULL;
+    }
+
+  return ACCEPTORS_DFA (priv->acceptor);
+}
+
+static void
+regexperience_finish_compilation (Regexperience *self,
+                                  const gchar   *expression,
+                                  gboolean       is_compiled)
+{
+  RegexperiencePrivate *priv = regexperience_get_instance_private (self);
+
+  if (priv->allocation_accounting)
+    allocation_accounting_end (&priv->compile_allocations);
+
+  if (!trace_is_enabled ())
+    return;
+
+  g_autofree gchar *quoted_expression = (expression != NULL) ? trace_quote (expression) : g_strdup ("null");
+
+  trace_end ("compile", "compilation",
+             "\"expression\": %s, \"compiled\": %s",
+             quoted_expression,
+             is_compiled ? "true" : "false");
+}
+
+static void
+regexperience_set_budget_error (CompilationBudget  *budget,
+                                GError            **error)
+{
+  CompilationBudgetLimit exceeded_limit = COMPILATION_BUDGET_LIMIT_NONE;
+  const gchar *error_message = NULL;
+
+  g_object_get (budget,
+                PROP_COMPILATION_BUDGET_EXCEEDED_LIMIT, &exceeded_limit,
+                NULL);
+
+  switch (exceeded_limit)
+    {
+    case COMPILATION_BUDGET_LIMIT_STATES:
+      error_message = "Maximum number of states exceeded";
+      break;
+
+    case COMPILATION_BUDGET_LIMIT_BYTES:
+      error_message = "Maximum number of bytes exceeded";
+      break;
+
+    case COMPILATION_BUDGET_LIMIT_DEADLINE:
+      error_message = "Time limit exceeded";
+      break;
+
+    default:
+      g_return_if_reached ();
+    }
+
+  g_set_error (error,
+               CORE_REGEXPERIENCE_ERROR,
+               CORE_REGEXPERIENCE_ERROR_COMPILATION_BUDGET_EXCEEDED,
+               "Compilation aborted (%s)",
+               error_message);
+}
+
+static void
+regexperience_get_property (GObject    *object,
+                            guint       property_id,
+                            GValue     *value,
+                            GParamSpec *pspec)
+{
+  RegexperiencePrivate *priv = regexperience_get_instance_private (CORE_REGEXPERIENCE (object));
+
+  switch (property_id)
+    {
+    case PROP_MAX_STATES:
+      g_value_set_uint (value, priv->max_states);
+      break;
+
+    case PROP_MAX_BYTES:
+      g_value_set_uint64 (value, priv->max_bytes);
+      break;
+
+    case PROP_TIME_LIMIT:
+      g_value_set_int64 (value, priv->time_limit);
+      break;
+
+    case PROP_NFA_FALLBACK:
+      g_value_set_boolean (value, priv->nfa_fallback);
+      break;
+
+    case PROP_BIT_PARALLEL:
+      g_value_set_boolean (value, priv->bit_parallel);
+      break;
+
+    case PROP_LEFTMOST_LONGEST:
+      g_value_set_boolean (value, priv->leftmost_longest);
+      break;
+
+    case PROP_CAPTURES:
+      g_value_set_boolean (value, priv->captures);
+      break;
+
+    case PROP_PROFILING:
+      g_value_set_boolean (value, priv->profiling);
+      break;
+
+    case PROP_COUNTERS:
+      g_value_set_boolean (value, priv->counters);
+      break;
+
+    case PROP_ALLOCATION_ACCOUNTING:
+      g_value_set_boolean (value, priv->allocation_accounting);
+      break;
+
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
+      break;
+    }
+}
+
+static void
+regexperience_set_property (GObject      *object,
+                            guint         property_id,
+                            const GValue *value,
+                            GParamSpec   *pspec)
+{
+  RegexperiencePrivate *priv = regexperience_get_instance_private (CORE_REGEXPERIENCE (object));
+
+  switch (property_id)
+    {
+    case PROP_MAX_STATES:
+      priv->max_states = g_value_get_uint (value);
+      break;
+
+    case PROP_MAX_BYTES:
+      priv->max_bytes = g_value_get_uint64 (value);
+      break;
+
+    case PROP_TIME_LIMIT:
+      priv->time_limit = g_value_get_int64 (value);
+      break;
+
+    case PROP_NFA_FALLBACK:
+      priv->nfa_fallback = g_value_get_boolean (value);
+      break;
+
+    case PROP_BIT_PARALLEL:
+      priv->bit_parallel = g_value_get_boolean (value);
+      break;
+
+    case PROP_LEFTMOST_LONGEST:
+      priv->leftmost_longest = g_value_get_boolean (value);
+      break;
+
+    case PROP_CAPTURES:
+      priv->captures = g_value_get_boolean (value);
+      break;
+
+    case PROP_PROFILING:
+      priv->profiling = g_value_get_boolean (value);
+      break;
+
+    case PROP_COUNTERS:
+      priv->counters = g_value_get_boolean (value);
+      break;
+
+    case PROP_ALLOCATION_ACCOUNTING:
+      priv->allocation_accounting = g_value_get_boolean (value);
+      break;
+
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
+      break;
+    }
+}
+
 static void
 regexperience_dispose (GObject *object)
 {
@@ -168,11 +1122,18 @@ regexperience_dispose (GObject *object)
   if (priv->parser != NULL)
     g_clear_object (&priv->parser);
 
-  if (priv->analyzer != NULL)
-    g_clear_object (&priv->analyzer);
-
   if (priv->acceptor != NULL)
     g_clear_object (&priv->acceptor);
 
   G_OBJECT_CLASS (regexperience_parent_class)->dispose (object);
 }
+
+static void
+regexperience_finalize (GObject *object)
+{
+  RegexperiencePrivate *priv = regexperience_get_instance_private (CORE_REGEXPERIENCE (object));
+
+  g_mutex_clear (&priv->match_counters_mutex);
+
+  G_OBJECT_CLASS (regexperience_parent_class)->finalize (object);
+}
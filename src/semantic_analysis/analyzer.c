@@ -1,11 +1,8 @@
 #include "internal/semantic_analysis/analyzer.h"
 #include "internal/semantic_analysis/ast_node_factory.h"
 #include "internal/syntactic_analysis/grammar.h"
-#include "internal/syntactic_analysis/production.h"
-#include "internal/syntactic_analysis/symbols/terminal.h"
-#include "internal/syntactic_analysis/symbols/non_terminal.h"
+#include "internal/lexical_analysis/lexeme.h"
 #include "internal/lexical_analysis/token.h"
-#include "internal/common/helpers.h"
 
 struct _Analyzer
 {
@@ -14,55 +11,54 @@ struct _Analyzer
 
 typedef struct
 {
-  GHashTable *operator_types;
+  Grammar    *grammar;
+  GHashTable *semantic_actions;
 } AnalyzerPrivate;
 
 typedef enum
 {
-  FETCH_CST_CHILDREN_TOKEN = 1 << 0,
-  FETCH_CST_CHILDREN_TERMINAL = 1 << 1,
-  FETCH_CST_CHILDREN_NON_TERMINAL = 1 << 2,
-  FETCH_CST_CHILDREN_ALL = 1 << 3,
-  FETCH_CST_CHILDREN_FIRST = 1 << 4
-} FetchCstChildrenFlags;
+  SEMANTIC_ACTION_PROPAGATE,
+  SEMANTIC_ACTION_CONSTANT,
+  SEMANTIC_ACTION_ANCHOR,
+  SEMANTIC_ACTION_QUANTIFICATION,
+  SEMANTIC_ACTION_QUANTIFICATION_BOUNDS,
+  SEMANTIC_ACTION_ALTERNATION,
+  SEMANTIC_ACTION_CONCATENATION,
+  SEMANTIC_ACTION_RANGE,
+  SEMANTIC_ACTION_BRACKET_EXPRESSION,
+  SEMANTIC_ACTION_GROUP
+} SemanticAction;
 
-static AstNode      *analyzer_transform_concrete_syntax_tree (GNode                  *cst_root,
-                                                              GHashTable             *operator_types);
+static GHashTable   *analyzer_define_semantic_actions      (Grammar       *grammar);
 
-static GHashTable   *analyzer_define_operator_types          (void);
+static GObject      *analyzer_propagate                    (gpointer      *values,
+                                                            guint          n_values);
 
-static gboolean      analyzer_is_constant                    (GNode                  *cst_root,
-                                                              GNode                 **first_cst_child);
+static GObject      *analyzer_reduce_constant              (gpointer      *values,
+                                                            guint          n_values);
 
-static gboolean      analyzer_is_anchor                      (GNode                  *cst_root,
-                                                              GNode                 **second_cst_child);
+static GObject      *analyzer_reduce_anchor                (gpointer      *values,
+                                                            guint          n_values);
 
-static gboolean      analyzer_is_unary_operator              (GNode                  *cst_root,
-                                                              GNode                 **first_cst_child,
-                                                              GNode                 **operator_type_discerning_node);
+static GObject      *analyzer_reduce_quantification        (gpointer      *values,
+                                                            guint          n_values);
 
-static gboolean      analyzer_is_binary_operator             (GNode                  *cst_root,
-                                                              GNode                 **first_cst_child,
-                                                              GNode                 **second_cst_child,
-                                                              GNode                 **operator_type_discerning_node);
+static GObject      *analyzer_reduce_quantification_bounds (gpointer      *values,
+                                                            guint          n_values);
 
-static gboolean      analyzer_is_empty                       (GNode                  *cst_root);
+static GObject      *analyzer_reduce_binary_operator       (OperatorType   operator_type,
+                                                            gpointer      *values,
+                                                            guint          n_values);
 
-static gboolean      analyzer_is_match                       (GNode                  *cst_root,
-                                                              ...);
+static GObject      *analyzer_reduce_bracket_expression    (gpointer      *values,
+                                                            guint          n_values);
 
-static AstNode      *analyzer_continue                       (GNode                  *cst_root,
-                                                              GHashTable             *operator_types);
+static GObject      *analyzer_reduce_group                 (gpointer      *values,
+                                                            guint          n_values);
 
-static GPtrArray    *analyzer_fetch_cst_children             (GNode                  *cst_root,
-                                                              FetchCstChildrenFlags   fetch_cst_children_flags);
+static OperatorType  analyzer_discern_operator_type        (Token         *token);
 
-static const gchar  *analyzer_fetch_node_caption             (GNode                  *cst_root);
-
-static OperatorType  analyzer_discern_operator_type          (GNode                  *cst_root,
-                                                              GHashTable             *operator_types);
-
-static void          analyzer_dispose                        (GObject                *object);
+static void          analyzer_dispose                      (GObject       *object);
 
 G_DEFINE_TYPE_WITH_PRIVATE (Analyzer, analyzer, G_TYPE_OBJECT)
 
@@ -79,457 +75,355 @@ analyzer_init (Analyzer *self)
 {
   AnalyzerPrivate *priv = analyzer_get_instance_private (self);
 
-  GHashTable *operator_types = analyzer_define_operator_types ();
+  /* The grammar is a singleton, its productions are therefore shared with the parser
+   * and can safely be used as keys when looking up semantic actions.
+   */
+  Grammar *grammar = grammar_new ();
+  GHashTable *semantic_actions = analyzer_define_semantic_actions (grammar);
 
-  priv->operator_types = operator_types;
+  priv->grammar = grammar;
+  priv->semantic_actions = semantic_actions;
 }
 
-AstNode *
-analyzer_build_abstract_syntax_tree (Analyzer  *self,
-                                     GNode     *concrete_syntax_tree,
-                                     GError   **error)
+GObject *
+analyzer_reduce (Analyzer   *self,
+                 Production *production,
+                 gpointer   *values,
+                 guint       n_values)
 {
   g_return_val_if_fail (SEMANTIC_ANALYSIS_IS_ANALYZER (self), NULL);
-  g_return_val_if_fail (concrete_syntax_tree != NULL, NULL);
-  g_return_val_if_fail (error == NULL || *error == NULL, NULL);
+  g_return_val_if_fail (SYNTACTIC_ANALYSIS_IS_PRODUCTION (production), NULL);
+  g_return_val_if_fail (values != NULL || n_values == 0, NULL);
 
   AnalyzerPrivate *priv = analyzer_get_instance_private (self);
-  GHashTable *operator_types = priv->operator_types;
-  AstNode *abstract_syntax_tree = analyzer_transform_concrete_syntax_tree (concrete_syntax_tree,
-                                                                           operator_types);
 
-  if (!ast_node_is_valid (abstract_syntax_tree, error))
+  /* Productions without an explicitly defined semantic action simply propagate
+   * the value of their right-hand side.
+   */
+  SemanticAction semantic_action =
+    (SemanticAction) GPOINTER_TO_INT (g_hash_table_lookup (priv->semantic_actions,
+                                                           production));
+
+  switch (semantic_action)
     {
-      g_assert (error != NULL || *error != NULL);
-      g_clear_object (&abstract_syntax_tree);
-    }
+    case SEMANTIC_ACTION_CONSTANT:
+      return analyzer_reduce_constant (values, n_values);
 
-  return abstract_syntax_tree;
-}
+    case SEMANTIC_ACTION_ANCHOR:
+      return analyzer_reduce_anchor (values, n_values);
 
-static AstNode *
-analyzer_transform_concrete_syntax_tree (GNode      *cst_root,
-                                         GHashTable *operator_types)
-{
-  AstNode *ast_node = NULL;
-  GNode *first_cst_child = NULL;
-  GNode *second_cst_child = NULL;
-  GNode *operator_type_discerning_node = NULL;
+    case SEMANTIC_ACTION_QUANTIFICATION:
+      return analyzer_reduce_quantification (values, n_values);
 
-  if (analyzer_is_constant (cst_root,
-                            &first_cst_child))
-    {
-      ast_node = create_constant (first_cst_child);
-    }
-  else if (analyzer_is_anchor (cst_root, &second_cst_child))
-    {
-      g_autoptr (AstNode) anchored_node = analyzer_transform_concrete_syntax_tree (second_cst_child,
-                                                                                   operator_types);
+    case SEMANTIC_ACTION_QUANTIFICATION_BOUNDS:
+      return analyzer_reduce_quantification_bounds (values, n_values);
 
-      ast_node = create_anchor (cst_root, anchored_node);
-    }
-  else if (analyzer_is_unary_operator (cst_root,
-                                       &first_cst_child,
-                                       &operator_type_discerning_node))
-    {
-      g_autoptr (AstNode) operand = analyzer_transform_concrete_syntax_tree (first_cst_child,
-                                                                             operator_types);
+    case SEMANTIC_ACTION_ALTERNATION:
+      return analyzer_reduce_binary_operator (OPERATOR_TYPE_ALTERNATION, values, n_values);
 
-      ast_node = create_unary_operator (analyzer_discern_operator_type (operator_type_discerning_node,
-                                                                        operator_types),
-                                        operand);
-    }
-  else if (analyzer_is_binary_operator (cst_root,
-                                        &first_cst_child,
-                                        &second_cst_child,
-                                        &operator_type_discerning_node))
-    {
-      g_autoptr (AstNode) left_operand = analyzer_transform_concrete_syntax_tree (first_cst_child,
-                                                                                  operator_types);
-      g_autoptr (AstNode) right_operand = analyzer_transform_concrete_syntax_tree (second_cst_child,
-                                                                                   operator_types);
-
-      ast_node = create_binary_operator (analyzer_discern_operator_type (operator_type_discerning_node,
-                                                                         operator_types),
-                                         left_operand,
-                                         right_operand);
-    }
-  else
-    {
-      /* Continuing the analysis with the current root node's first (and only) child. */
-      ast_node = analyzer_continue (cst_root, operator_types);
-    }
+    case SEMANTIC_ACTION_CONCATENATION:
+      return analyzer_reduce_binary_operator (OPERATOR_TYPE_CONCATENATION, values, n_values);
 
-  return ast_node;
-}
+    case SEMANTIC_ACTION_RANGE:
+      return analyzer_reduce_binary_operator (OPERATOR_TYPE_RANGE, values, n_values);
 
-static GHashTable *
-analyzer_define_operator_types (void)
-{
-  GHashTable *operator_types = g_hash_table_new (g_str_hash,
-                                                 g_str_equal);
-
-  g_hash_table_insert (operator_types,
-                       EXPRESSION_PRIME,
-                       GINT_TO_POINTER (OPERATOR_TYPE_ALTERNATION));
-  g_hash_table_insert (operator_types,
-                       ALTERNATION_PRIME,
-                       GINT_TO_POINTER (OPERATOR_TYPE_ALTERNATION));
-  g_hash_table_insert (operator_types,
-                       SIMPLE_EXPRESSION_PRIME,
-                       GINT_TO_POINTER (OPERATOR_TYPE_CONCATENATION));
-  g_hash_table_insert (operator_types,
-                       CONCATENATION_PRIME,
-                       GINT_TO_POINTER (OPERATOR_TYPE_CONCATENATION));
-  g_hash_table_insert (operator_types,
-                       STAR_QUANTIFICATION,
-                       GINT_TO_POINTER (OPERATOR_TYPE_STAR_QUANTIFICATION));
-  g_hash_table_insert (operator_types,
-                       PLUS_QUANTIFICATION,
-                       GINT_TO_POINTER (OPERATOR_TYPE_PLUS_QUANTIFICATION));
-  g_hash_table_insert (operator_types,
-                       QUESTION_MARK_QUANTIFICATION,
-                       GINT_TO_POINTER (OPERATOR_TYPE_QUESTION_MARK_QUANTIFICATION));
-  /* Bracket expression items behave in exactly the same way as alternation does but without
-   * the usage of an explicit operator ("|").
-   */
-  g_hash_table_insert (operator_types,
-                       BRACKET_EXPRESSION_ITEMS_PRIME,
-                       GINT_TO_POINTER (OPERATOR_TYPE_ALTERNATION));
-  g_hash_table_insert (operator_types,
-                       UPPER_CASE_LETTER_RANGE,
-                       GINT_TO_POINTER (OPERATOR_TYPE_RANGE));
-  g_hash_table_insert (operator_types,
-                       LOWER_CASE_LETTER_RANGE,
-                       GINT_TO_POINTER (OPERATOR_TYPE_RANGE));
-  g_hash_table_insert (operator_types,
-                       DIGIT_RANGE,
-                       GINT_TO_POINTER (OPERATOR_TYPE_RANGE));
-
-  return operator_types;
+    case SEMANTIC_ACTION_BRACKET_EXPRESSION:
+      return analyzer_reduce_bracket_expression (values, n_values);
+
+    case SEMANTIC_ACTION_GROUP:
+      return analyzer_reduce_group (values, n_values);
+
+    default:
+      return analyzer_propagate (values, n_values);
+    }
 }
 
-static gboolean
-analyzer_is_constant (GNode  *cst_root,
-                      GNode **first_cst_child)
+static GHashTable *
+analyzer_define_semantic_actions (Grammar *grammar)
 {
-  if (analyzer_is_match (cst_root,
-                         UPPER_CASE_LETTER,
-                         LOWER_CASE_LETTER,
-                         DIGIT,
-                         SPECIAL_CHARACTER,
-                         REGULAR_METACHARACTER,
-                         BRACKET_EXPRESSION_METACHARACTER,
-                         ANY_CHARACTER,
-                         METACHARACTER_ESCAPE,
-                         SPACE,
-                         HORIZONTAL_TAB,
-                         EMPTY_EXPRESSION,
-                         NULL))
+  struct
+  {
+    const gchar    *caption;
+    SemanticAction  semantic_action;
+  } semantic_actions_array[] =
+    {
+      { ANCHORED_EXPRESSION,              SEMANTIC_ACTION_ANCHOR                },
+      { EXPRESSION,                       SEMANTIC_ACTION_ALTERNATION           },
+      { ALTERNATION,                      SEMANTIC_ACTION_ALTERNATION           },
+      { SIMPLE_EXPRESSION,                SEMANTIC_ACTION_CONCATENATION         },
+      { CONCATENATION,                    SEMANTIC_ACTION_CONCATENATION         },
+      { BASIC_EXPRESSION,                 SEMANTIC_ACTION_QUANTIFICATION        },
+      /* Bounds of the quantification operator (including the braces themselves) are merged into a
+       * single token which is interpreted only once the quantified expression is known.
+       */
+      { BOUNDED_QUANTIFICATION,           SEMANTIC_ACTION_QUANTIFICATION_BOUNDS },
+      { QUANTIFICATION_BOUNDS,            SEMANTIC_ACTION_QUANTIFICATION_BOUNDS },
+      { QUANTIFICATION_BOUNDS_PRIME,      SEMANTIC_ACTION_QUANTIFICATION_BOUNDS },
+      { UPPER_QUANTIFICATION_BOUND,       SEMANTIC_ACTION_QUANTIFICATION_BOUNDS },
+      { QUANTIFICATION_BOUND,             SEMANTIC_ACTION_QUANTIFICATION_BOUNDS },
+      { QUANTIFICATION_BOUND_PRIME,       SEMANTIC_ACTION_QUANTIFICATION_BOUNDS },
+      { GROUP,                            SEMANTIC_ACTION_GROUP                 },
+      { BRACKET_EXPRESSION,               SEMANTIC_ACTION_BRACKET_EXPRESSION    },
+      /* Bracket expression items behave in exactly the same way as alternation does but without
+       * the usage of an explicit operator ("|").
+       */
+      { BRACKET_EXPRESSION_ITEMS,         SEMANTIC_ACTION_ALTERNATION           },
+      { BRACKET_EXPRESSION_ITEM,          SEMANTIC_ACTION_RANGE                 },
+      { UPPER_CASE_LETTER,                SEMANTIC_ACTION_CONSTANT              },
+      { LOWER_CASE_LETTER,                SEMANTIC_ACTION_CONSTANT              },
+      { DIGIT,                            SEMANTIC_ACTION_CONSTANT              },
+      { SPECIAL_CHARACTER,                SEMANTIC_ACTION_CONSTANT              },
+      { NON_ASCII_CHARACTER,              SEMANTIC_ACTION_CONSTANT              },
+      { SPACE,                            SEMANTIC_ACTION_CONSTANT              },
+      { HORIZONTAL_TAB,                   SEMANTIC_ACTION_CONSTANT              },
+      { REGULAR_METACHARACTER,            SEMANTIC_ACTION_CONSTANT              },
+      { BRACKET_EXPRESSION_METACHARACTER, SEMANTIC_ACTION_CONSTANT              },
+      { ANY_CHARACTER,                    SEMANTIC_ACTION_CONSTANT              },
+      { METACHARACTER_ESCAPE,             SEMANTIC_ACTION_CONSTANT              },
+      { EMPTY_EXPRESSION,                 SEMANTIC_ACTION_CONSTANT              }
+    };
+  GHashTable *semantic_actions = g_hash_table_new (g_direct_hash,
+                                                   g_direct_equal);
+  g_autoptr (GPtrArray) all_productions = NULL;
+
+  g_object_get (grammar,
+                PROP_GRAMMAR_ALL_PRODUCTIONS, &all_productions,
+                NULL);
+
+  for (guint i = 0; i < all_productions->len; ++i)
     {
-      g_autoptr (GPtrArray) cst_children =
-        analyzer_fetch_cst_children (cst_root,
-                                     FETCH_CST_CHILDREN_TOKEN | FETCH_CST_CHILDREN_FIRST);
+      Production *production = g_ptr_array_index (all_productions, i);
+      g_autofree gchar *caption = NULL;
 
-      if (g_collection_has_items (cst_children))
-        {
-          const guint constant_node_children_count = 1;
+      g_object_get (production,
+                    PROP_PRODUCTION_CAPTION, &caption,
+                    NULL);
 
-          if (cst_children->len == constant_node_children_count)
+      for (guint j = 0; j < G_N_ELEMENTS (semantic_actions_array); ++j)
+        {
+          if (g_strcmp0 (caption, semantic_actions_array[j].caption) == 0)
             {
-              *first_cst_child = g_ptr_array_index (cst_children, 0);
+              g_hash_table_insert (semantic_actions,
+                                   production,
+                                   GINT_TO_POINTER (semantic_actions_array[j].semantic_action));
 
-              return TRUE;
+              break;
             }
         }
     }
 
-  return FALSE;
+  return semantic_actions;
 }
 
-static gboolean
-analyzer_is_anchor (GNode  *cst_root,
-                    GNode **second_cst_child)
+static GObject *
+analyzer_propagate (gpointer *values,
+                    guint     n_values)
 {
-  if (analyzer_is_match (cst_root,
-                         ANCHORED_EXPRESSION,
-                         NULL))
-    {
-      g_autoptr (GPtrArray) cst_children =
-          analyzer_fetch_cst_children (cst_root,
-                                       FETCH_CST_CHILDREN_NON_TERMINAL | FETCH_CST_CHILDREN_ALL);
-
-      if (g_collection_has_items (cst_children))
-        {
-          const guint anchor_node_children_count = 3;
+  GObject *token = NULL;
 
-          if (cst_children->len == anchor_node_children_count)
-            {
-              *second_cst_child = g_ptr_array_index (cst_children, 1);
+  /* Abstract syntax tree nodes take precedence over tokens (brackets and other punctuation
+   * are meaningful only during parsing), while tokens are propagated
+   * only if nothing else is available (anchors and quantification operators).
+   */
+  for (guint i = 0; i < n_values; ++i)
+    {
+      gpointer value = values[i];
 
-              return TRUE;
-            }
-        }
+      if (AST_NODES_IS_AST_NODE (value))
+        return g_object_ref (value);
+      else if (token == NULL && LEXICAL_ANALYSIS_IS_TOKEN (value))
+        token = value;
     }
 
-  return FALSE;
+  return token != NULL ? g_object_ref (token) : NULL;
 }
 
-static gboolean
-analyzer_is_unary_operator (GNode  *cst_root,
-                            GNode **first_cst_child,
-                            GNode **operator_type_discerning_node)
+static GObject *
+analyzer_reduce_constant (gpointer *values,
+                          guint     n_values)
 {
-  if (analyzer_is_match (cst_root,
-                         BASIC_EXPRESSION,
-                         NULL))
-    {
-      g_autoptr (GPtrArray) cst_children =
-          analyzer_fetch_cst_children (cst_root,
-                                       FETCH_CST_CHILDREN_NON_TERMINAL | FETCH_CST_CHILDREN_ALL);
+  const guint constant_values_count = 1;
 
-      if (g_collection_has_items (cst_children))
-        {
-          for (guint i = 0; i < cst_children->len; ++i)
-            {
-              GNode *cst_child = g_ptr_array_index (cst_children, i);
-
-              if (analyzer_is_match (cst_child,
-                                     BASIC_EXPRESSION_PRIME,
-                                     NULL) &&
-                  !analyzer_is_empty (cst_child))
-                {
-                  g_autoptr (GPtrArray) cst_grandchildren =
-                    analyzer_fetch_cst_children (cst_child,
-                                                 FETCH_CST_CHILDREN_NON_TERMINAL | FETCH_CST_CHILDREN_FIRST);
-
-                  if (g_collection_has_items (cst_grandchildren))
-                    {
-                      GNode *cst_grandchild = g_ptr_array_index (cst_grandchildren, 0);
-
-                      if (analyzer_is_match (cst_grandchild,
-                                             STAR_QUANTIFICATION,
-                                             PLUS_QUANTIFICATION,
-                                             QUESTION_MARK_QUANTIFICATION,
-                                             NULL))
-                        {
-                          *first_cst_child = g_ptr_array_index (cst_children, 0);
-                          *operator_type_discerning_node = cst_grandchild;
-
-                          return TRUE;
-                        }
-                    }
-                }
-            }
-        }
-    }
+  if (n_values == constant_values_count && LEXICAL_ANALYSIS_IS_TOKEN (values[0]))
+    return G_OBJECT (create_constant (LEXICAL_ANALYSIS_TOKEN (values[0])));
 
-  return FALSE;
+  return analyzer_propagate (values, n_values);
 }
 
-static gboolean
-analyzer_is_binary_operator (GNode  *cst_root,
-                             GNode **first_cst_child,
-                             GNode **second_cst_child,
-                             GNode **operator_type_discerning_node)
+static GObject *
+analyzer_reduce_anchor (gpointer *values,
+                        guint     n_values)
 {
-  if (analyzer_is_match (cst_root,
-                         EXPRESSION,
-                         ALTERNATION,
-                         SIMPLE_EXPRESSION,
-                         CONCATENATION,
-                         BRACKET_EXPRESSION_ITEMS,
-                         BRACKET_EXPRESSION_ITEM,
-                         NULL))
-    {
-      g_autoptr (GPtrArray) cst_children =
-        analyzer_fetch_cst_children (cst_root,
-                                     FETCH_CST_CHILDREN_NON_TERMINAL | FETCH_CST_CHILDREN_ALL);
+  const guint anchor_values_count = 3;
 
-      if (g_collection_has_items (cst_children))
-        {
-          for (guint i = 0; i < cst_children->len; ++i)
-            {
-              GNode *cst_child = g_ptr_array_index (cst_children, i);
-
-              if (analyzer_is_match (cst_child,
-                                     EXPRESSION_PRIME,
-                                     ALTERNATION_PRIME,
-                                     SIMPLE_EXPRESSION_PRIME,
-                                     CONCATENATION_PRIME,
-                                     BRACKET_EXPRESSION_ITEMS_PRIME,
-                                     UPPER_CASE_LETTER_RANGE,
-                                     LOWER_CASE_LETTER_RANGE,
-                                     DIGIT_RANGE,
-                                     NULL) &&
-                  !analyzer_is_empty (cst_child))
-                {
-                  g_autoptr (GPtrArray) cst_grandchildren =
-                    analyzer_fetch_cst_children (cst_child,
-                                                 FETCH_CST_CHILDREN_NON_TERMINAL | FETCH_CST_CHILDREN_ALL);
-
-                  if (g_collection_has_items (cst_grandchildren))
-                    {
-                      *first_cst_child = g_ptr_array_index (cst_children, 0);
-                      *second_cst_child = g_ptr_array_index (cst_grandchildren, cst_grandchildren->len - 1);
-                      *operator_type_discerning_node = cst_child;
-
-                      return TRUE;
-                    }
-                }
-            }
-        }
-    }
+  g_return_val_if_fail (n_values == anchor_values_count, NULL);
+  g_return_val_if_fail (AST_NODES_IS_AST_NODE (values[1]), NULL);
 
-  return FALSE;
+  return G_OBJECT (create_anchor (AST_NODES_AST_NODE (values[1]),
+                                  discern_anchor_type (values[0]),
+                                  discern_anchor_type (values[2])));
 }
 
-static gboolean
-analyzer_is_empty (GNode *cst_root)
+static GObject *
+analyzer_reduce_quantification (gpointer *values,
+                                guint     n_values)
 {
-  g_autoptr (GPtrArray) cst_children =
-    analyzer_fetch_cst_children (cst_root,
-                                 FETCH_CST_CHILDREN_TERMINAL | FETCH_CST_CHILDREN_FIRST);
+  const guint quantification_values_count = 2;
 
-  if (g_collection_has_items (cst_children))
+  if (n_values == quantification_values_count &&
+      AST_NODES_IS_AST_NODE (values[0]) &&
+      LEXICAL_ANALYSIS_IS_TOKEN (values[1]))
     {
-      const guint empty_node_children_count = 1;
+      OperatorType operator_type = analyzer_discern_operator_type (LEXICAL_ANALYSIS_TOKEN (values[1]));
 
-      if (cst_children->len == empty_node_children_count)
-        {
-          GNode *cst_child = g_ptr_array_index (cst_children, 0);
-          Symbol *terminal = SYMBOLS_SYMBOL (cst_child->data);
+      if (operator_type == OPERATOR_TYPE_BOUNDED_QUANTIFICATION)
+        return G_OBJECT (create_bounded_quantification (AST_NODES_AST_NODE (values[0]),
+                                                        LEXICAL_ANALYSIS_TOKEN (values[1])));
 
-          return symbol_is_epsilon (terminal);
-        }
+      return G_OBJECT (create_unary_operator (operator_type,
+                                              AST_NODES_AST_NODE (values[0])));
     }
 
-  return FALSE;
+  return analyzer_propagate (values, n_values);
 }
 
-static gboolean
-analyzer_is_match (GNode *cst_root,
-                   ...)
+static GObject *
+analyzer_reduce_quantification_bounds (gpointer *values,
+                                       guint     n_values)
 {
-  gboolean result = FALSE;
-
-  if (SYMBOLS_IS_NON_TERMINAL (cst_root->data))
+  g_autoptr (GString) merged_content = g_string_new (NULL);
+  g_autoptr (Lexeme) merged_lexeme = NULL;
+  TokenCategory merged_category = TOKEN_CATEGORY_UNDEFINED;
+  guint merged_start_position = 0;
+  guint merged_end_position = 0;
+  gboolean is_empty = TRUE;
+
+  /* Missing values (epsilon derivations) are skipped, the category and the starting position
+   * are taken from the leftmost token while the ending position is taken from the rightmost one.
+   */
+  for (guint i = 0; i < n_values; ++i)
     {
-      va_list ap;
-      g_autofree const gchar *cst_root_caption = analyzer_fetch_node_caption (cst_root);
-      const gchar *current = NULL;
+      gpointer value = values[i];
 
-      va_start (ap, cst_root);
-
-      while (TRUE)
+      if (LEXICAL_ANALYSIS_IS_TOKEN (value))
         {
-          current = va_arg (ap, gchar*);
-
-          if (current != NULL)
+          g_autoptr (Lexeme) lexeme = NULL;
+          g_autoptr (GString) lexeme_content = NULL;
+          guint lexeme_start_position = 0;
+
+          g_object_get (value,
+                        PROP_TOKEN_LEXEME, &lexeme,
+                        NULL);
+          g_object_get (lexeme,
+                        PROP_LEXEME_CONTENT, &lexeme_content,
+                        PROP_LEXEME_START_POSITION, &lexeme_start_position,
+                        PROP_LEXEME_END_POSITION, &merged_end_position,
+                        NULL);
+
+          if (is_empty)
             {
-              if (g_strcmp0 (cst_root_caption, current) == 0)
-                {
-                  result = TRUE;
+              g_object_get (value,
+                            PROP_TOKEN_CATEGORY, &merged_category,
+                            NULL);
 
-                  break;
-                }
+              merged_start_position = lexeme_start_position;
+              is_empty = FALSE;
             }
-          else
-            {
-              break;
-            }
-        }
 
-      va_end (ap);
+          g_string_append (merged_content, lexeme_content->str);
+        }
     }
 
-  return result;
-}
+  if (is_empty)
+    return NULL;
 
-static AstNode *
-analyzer_continue (GNode      *cst_root,
-                   GHashTable *operator_types)
-{
-  g_autoptr (GPtrArray) cst_children =
-    analyzer_fetch_cst_children (cst_root,
-                                 FETCH_CST_CHILDREN_NON_TERMINAL | FETCH_CST_CHILDREN_FIRST);
-
-  g_assert (g_collection_has_items (cst_children));
-
-  GNode *first_cst_child = g_ptr_array_index (cst_children, 0);
+  merged_lexeme = lexeme_new (PROP_LEXEME_CONTENT, merged_content,
+                              PROP_LEXEME_START_POSITION, merged_start_position,
+                              PROP_LEXEME_END_POSITION, merged_end_position);
 
-  return analyzer_transform_concrete_syntax_tree (first_cst_child,
-                                                  operator_types);
+  return G_OBJECT (token_new (PROP_TOKEN_CATEGORY, merged_category,
+                              PROP_TOKEN_LEXEME, merged_lexeme));
 }
 
-static GPtrArray *
-analyzer_fetch_cst_children (GNode                 *cst_root,
-                             FetchCstChildrenFlags  fetch_cst_children_flags)
+static GObject *
+analyzer_reduce_binary_operator (OperatorType  operator_type,
+                                 gpointer     *values,
+                                 guint         n_values)
 {
-  GPtrArray *cst_children = g_ptr_array_new ();
-  guint cst_children_count = g_node_n_children (cst_root);
+  const guint binary_operator_values_count = 2;
 
-  for (guint i = 0; i < cst_children_count; ++i)
+  /* The right operand is always found at the very end of the right-hand side (because the grammar
+   * is right-recursive) and it is missing in case the corresponding rule derived epsilon.
+   */
+  if (n_values >= binary_operator_values_count)
     {
-      GNode *cst_child = g_node_nth_child (cst_root, i);
-      gpointer data = cst_child->data;
-
-      if (((fetch_cst_children_flags & FETCH_CST_CHILDREN_TOKEN) &&
-           LEXICAL_ANALYSIS_IS_TOKEN (data)) ||
-          ((fetch_cst_children_flags & FETCH_CST_CHILDREN_TERMINAL) &&
-           SYMBOLS_IS_TERMINAL (data)) ||
-          ((fetch_cst_children_flags & FETCH_CST_CHILDREN_NON_TERMINAL) &&
-           SYMBOLS_IS_NON_TERMINAL (data)))
-        {
-          g_ptr_array_add (cst_children, cst_child);
+      gpointer left_operand = values[n_values - 2];
+      gpointer right_operand = values[n_values - 1];
 
-          if (fetch_cst_children_flags & FETCH_CST_CHILDREN_ALL)
-            continue;
-          else if (fetch_cst_children_flags & FETCH_CST_CHILDREN_FIRST)
-            break;
-        }
+      if (AST_NODES_IS_AST_NODE (left_operand) && AST_NODES_IS_AST_NODE (right_operand))
+        return G_OBJECT (create_binary_operator (operator_type,
+                                                 left_operand,
+                                                 right_operand));
     }
 
-  return cst_children;
+  return analyzer_propagate (values, n_values);
 }
 
-static const gchar *
-analyzer_fetch_node_caption (GNode *cst_root)
+static GObject *
+analyzer_reduce_bracket_expression (gpointer *values,
+                                    guint     n_values)
 {
-  gchar *caption = NULL;
+  const guint bracket_expression_values_count = 4;
 
-  if (SYMBOLS_IS_NON_TERMINAL (cst_root->data))
-    {
-      Symbol *symbol = cst_root->data;
-      g_autoptr (Production) production = NULL;
-      GValue value = G_VALUE_INIT;
+  /* The negation's semantic value is missing unless the caret itself is present. */
+  if (n_values == bracket_expression_values_count && AST_NODES_IS_AST_NODE (values[2]))
+    return G_OBJECT (create_bracket_expression (AST_NODES_AST_NODE (values[2]),
+                                                LEXICAL_ANALYSIS_IS_TOKEN (values[1])));
 
-      symbol_extract_value (symbol, &value);
+  return analyzer_propagate (values, n_values);
+}
 
-      production = g_value_get_object (&value);
+static GObject *
+analyzer_reduce_group (gpointer *values,
+                       guint     n_values)
+{
+  const guint group_values_count = 3;
 
-      g_object_get (production,
-                    PROP_PRODUCTION_CAPTION, &caption,
-                    NULL);
-    }
+  /* Groups are kept in the tree (instead of being propagated like the rest of the punctuation)
+   * so that the substrings they match can be reported.
+   */
+  if (n_values == group_values_count && AST_NODES_IS_AST_NODE (values[1]))
+    return G_OBJECT (create_group (AST_NODES_AST_NODE (values[1])));
 
-  return caption;
+  return analyzer_propagate (values, n_values);
 }
 
 static OperatorType
-analyzer_discern_operator_type (GNode      *cst_root,
-                                GHashTable *operator_types)
+analyzer_discern_operator_type (Token *token)
 {
-  g_autofree const gchar *cst_root_caption = analyzer_fetch_node_caption (cst_root);
-  OperatorType operator_type = OPERATOR_TYPE_UNDEFINED;
+  TokenCategory token_category = TOKEN_CATEGORY_UNDEFINED;
 
-  if (g_hash_table_contains (operator_types, cst_root_caption))
+  g_object_get (token,
+                PROP_TOKEN_CATEGORY, &token_category,
+                NULL);
+
+  switch (token_category)
     {
-      operator_type = (OperatorType) GPOINTER_TO_INT (g_hash_table_lookup (operator_types,
-                                                                           cst_root_caption));
-    }
+    case TOKEN_CATEGORY_STAR_QUANTIFICATION_OPERATOR:
+      return OPERATOR_TYPE_STAR_QUANTIFICATION;
 
-  return operator_type;
+    case TOKEN_CATEGORY_PLUS_QUANTIFICATION_OPERATOR:
+      return OPERATOR_TYPE_PLUS_QUANTIFICATION;
+
+    case TOKEN_CATEGORY_QUESTION_MARK_QUANTIFICATION_OPERATOR:
+      return OPERATOR_TYPE_QUESTION_MARK_QUANTIFICATION;
+
+    case TOKEN_CATEGORY_BOUNDED_QUANTIFICATION_OPERATOR:
+      return OPERATOR_TYPE_BOUNDED_QUANTIFICATION;
+
+    default:
+      return OPERATOR_TYPE_UNDEFINED;
+    }
 }
 
 static void
@@ -537,8 +431,11 @@ analyzer_dispose (GObject *object)
 {
   AnalyzerPrivate *priv = analyzer_get_instance_private (SEMANTIC_ANALYSIS_ANALYZER (object));
 
-  if (priv->operator_types != NULL)
-    g_clear_pointer (&priv->operator_types, g_hash_table_unref);
+  if (priv->semantic_actions != NULL)
+    g_clear_pointer (&priv->semantic_actions, g_hash_table_unref);
+
+  if (priv->grammar != NULL)
+    g_clear_object (&priv->grammar);
 
   G_OBJECT_CLASS (analyzer_parent_class)->dispose (object);
 }
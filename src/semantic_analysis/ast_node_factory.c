@@ -1,21 +1,21 @@
 #include "internal/semantic_analysis/ast_node_factory.h"
 #include "internal/semantic_analysis/ast_nodes/alternation.h"
 #include "internal/semantic_analysis/ast_nodes/anchor.h"
+#include "internal/semantic_analysis/ast_nodes/bracket_expression.h"
 #include "internal/semantic_analysis/ast_nodes/concatenation.h"
 #include "internal/semantic_analysis/ast_nodes/empty.h"
+#include "internal/semantic_analysis/ast_nodes/group.h"
 #include "internal/semantic_analysis/ast_nodes/quantification.h"
 #include "internal/semantic_analysis/ast_nodes/range.h"
-#include "internal/syntactic_analysis/symbols/symbol.h"
 #include "internal/lexical_analysis/lexeme.h"
 #include "internal/lexical_analysis/token.h"
 #include "internal/state_machines/transitions/transition.h"
 
 AstNode *
-create_constant (GNode *cst_context)
+create_constant (Token *token)
 {
-  g_return_val_if_fail (cst_context != NULL, NULL);
+  g_return_val_if_fail (LEXICAL_ANALYSIS_IS_TOKEN (token), NULL);
 
-  Token *token = LEXICAL_ANALYSIS_TOKEN (cst_context->data);
   TokenCategory token_category = TOKEN_CATEGORY_UNDEFINED;
 
   g_object_get (token,
@@ -30,10 +30,10 @@ create_constant (GNode *cst_context)
     {
       g_autoptr (Lexeme) lexeme = NULL;
       g_autoptr (GString) lexeme_content = NULL;
-      const guint acceptable_lexeme_content_length = 1;
+      const glong acceptable_lexeme_content_length = 1;
       guint lexeme_start_position = 0;
       guint lexeme_end_position = 0;
-      gchar expected_character = 0;
+      gunichar expected_character = 0;
 
       g_object_get (token,
                     PROP_TOKEN_LEXEME, &lexeme,
@@ -44,7 +44,9 @@ create_constant (GNode *cst_context)
                     PROP_LEXEME_END_POSITION, &lexeme_end_position,
                     NULL);
 
-      g_return_val_if_fail (lexeme_content->len == acceptable_lexeme_content_length, NULL);
+      /* The content is a single character which is not necessarily a single byte. */
+      g_return_val_if_fail (g_utf8_strlen (lexeme_content->str, (gssize) lexeme_content->len) == acceptable_lexeme_content_length,
+                            NULL);
 
       switch (token_category)
         {
@@ -53,7 +55,7 @@ create_constant (GNode *cst_context)
           break;
 
         case TOKEN_CATEGORY_ORDINARY_CHARACTER:
-          expected_character = lexeme_content->str[0];
+          expected_character = g_utf8_get_char (lexeme_content->str);
           break;
 
         default:
@@ -66,18 +68,20 @@ create_constant (GNode *cst_context)
 }
 
 AnchorType
-discern_anchor_type (GNode *anchor_cst_node)
+discern_anchor_type (Token *anchor_token)
 {
   AnchorType anchor_type = ANCHOR_TYPE_UNDEFINED;
-  GNode *anchor_cst_node_child = g_node_nth_child (anchor_cst_node, 0);
-  gpointer child_data = anchor_cst_node_child->data;
 
-  if (LEXICAL_ANALYSIS_IS_TOKEN (child_data))
+  /* A missing token means that the corresponding anchor rule derived epsilon. */
+  if (anchor_token == NULL)
+    {
+      anchor_type = ANCHOR_TYPE_UNANCHORED;
+    }
+  else if (LEXICAL_ANALYSIS_IS_TOKEN (anchor_token))
     {
-      Token *token = LEXICAL_ANALYSIS_TOKEN (child_data);
       TokenCategory token_category = TOKEN_CATEGORY_UNDEFINED;
 
-      g_object_get (token,
+      g_object_get (anchor_token,
                     PROP_TOKEN_CATEGORY, &token_category,
                     NULL);
 
@@ -85,36 +89,26 @@ discern_anchor_type (GNode *anchor_cst_node)
           token_category == TOKEN_CATEGORY_END_ANCHOR)
         anchor_type = ANCHOR_TYPE_ANCHORED;
     }
-  else if (SYMBOLS_IS_SYMBOL (child_data))
-    {
-      Symbol *symbol = SYMBOLS_SYMBOL (child_data);
-
-      if (symbol_is_epsilon (symbol))
-        anchor_type = ANCHOR_TYPE_UNANCHORED;
-    }
 
   return anchor_type;
 }
 
 AstNode *
-create_anchor (GNode   *cst_context,
-               AstNode *anchored_node)
+create_anchor (AstNode    *anchored_node,
+               AnchorType  start_anchor_type,
+               AnchorType  end_anchor_type)
 {
-  g_return_val_if_fail (cst_context != NULL, NULL);
   g_return_val_if_fail (anchored_node != NULL, NULL);
 
-  AnchorType start_anchor_type = discern_anchor_type (g_node_first_child (cst_context));
-  AnchorType end_anchor_type = discern_anchor_type (g_node_last_child (cst_context));
-
   return anchor_new (PROP_UNARY_OPERATOR_OPERAND, anchored_node,
                      PROP_ANCHOR_START_TYPE, start_anchor_type,
                      PROP_ANCHOR_END_TYPE, end_anchor_type);
 }
 
 void
-initialize_quantification_bounds (OperatorType             operator_type,
-                                  QuantificationBoundType *lower_bound,
-                                  QuantificationBoundType *upper_bound)
+initialize_quantification_bounds (OperatorType  operator_type,
+                                  guint        *lower_bound,
+                                  guint        *upper_bound)
 {
   g_return_if_fail (lower_bound != NULL);
   g_return_if_fail (upper_bound != NULL);
@@ -122,24 +116,22 @@ initialize_quantification_bounds (OperatorType             operator_type,
   switch (operator_type)
     {
     case OPERATOR_TYPE_STAR_QUANTIFICATION:
-      *lower_bound = QUANTIFICATION_BOUND_TYPE_ZERO;
-      *upper_bound = QUANTIFICATION_BOUND_TYPE_INFINITY;
+      *lower_bound = 0;
+      *upper_bound = QUANTIFICATION_BOUND_INFINITY;
       break;
 
     case OPERATOR_TYPE_PLUS_QUANTIFICATION:
-      *lower_bound = QUANTIFICATION_BOUND_TYPE_ONE;
-      *upper_bound = QUANTIFICATION_BOUND_TYPE_INFINITY;
+      *lower_bound = 1;
+      *upper_bound = QUANTIFICATION_BOUND_INFINITY;
       break;
 
     case OPERATOR_TYPE_QUESTION_MARK_QUANTIFICATION:
-      *lower_bound = QUANTIFICATION_BOUND_TYPE_ZERO;
-      *upper_bound = QUANTIFICATION_BOUND_TYPE_ONE;
+      *lower_bound = 0;
+      *upper_bound = 1;
       break;
 
     default:
-      *lower_bound = QUANTIFICATION_BOUND_TYPE_UNDEFINED;
-      *upper_bound = QUANTIFICATION_BOUND_TYPE_UNDEFINED;
-      break;
+      g_return_if_reached ();
     }
 }
 
@@ -156,8 +148,8 @@ create_unary_operator (OperatorType  operator_type,
     case OPERATOR_TYPE_PLUS_QUANTIFICATION:
     case OPERATOR_TYPE_QUESTION_MARK_QUANTIFICATION:
       {
-        QuantificationBoundType lower_bound = QUANTIFICATION_BOUND_TYPE_UNDEFINED;
-        QuantificationBoundType upper_bound = QUANTIFICATION_BOUND_TYPE_UNDEFINED;
+        guint lower_bound = 0;
+        guint upper_bound = 0;
 
         initialize_quantification_bounds (operator_type,
                                           &lower_bound,
@@ -173,6 +165,52 @@ create_unary_operator (OperatorType  operator_type,
     }
 }
 
+AstNode *
+create_bounded_quantification (AstNode *operand,
+                               Token   *bounds_token)
+{
+  g_return_val_if_fail (operand != NULL, NULL);
+  g_return_val_if_fail (LEXICAL_ANALYSIS_IS_TOKEN (bounds_token), NULL);
+
+  g_autoptr (Lexeme) lexeme = NULL;
+  g_autoptr (GString) lexeme_content = NULL;
+  guint lexeme_start_position = 0;
+  guint lexeme_end_position = 0;
+
+  g_object_get (bounds_token,
+                PROP_TOKEN_LEXEME, &lexeme,
+                NULL);
+  g_object_get (lexeme,
+                PROP_LEXEME_CONTENT, &lexeme_content,
+                PROP_LEXEME_START_POSITION, &lexeme_start_position,
+                PROP_LEXEME_END_POSITION, &lexeme_end_position,
+                NULL);
+
+  /* The content has already been checked by the parser and is therefore always in one of
+   * the following forms: "{m}", "{m,}" or "{m,n}". Values exceeding the allowed maximum are
+   * clamped so that the quantification can later be reported as invalid.
+   */
+  const guint64 clamped_bound = QUANTIFICATION_BOUND_MAXIMUM + 1;
+  gchar *bound_end = NULL;
+  guint64 lower_bound = g_ascii_strtoull (lexeme_content->str + 1, &bound_end, 10);
+  guint64 upper_bound = lower_bound;
+
+  if (*bound_end == ',')
+    {
+      if (*(bound_end + 1) == '}')
+        upper_bound = QUANTIFICATION_BOUND_INFINITY;
+      else
+        upper_bound = MIN (g_ascii_strtoull (bound_end + 1, NULL, 10), clamped_bound);
+    }
+
+  lower_bound = MIN (lower_bound, clamped_bound);
+
+  return quantification_new (PROP_UNARY_OPERATOR_OPERAND, operand,
+                             PROP_QUANTIFICATION_LOWER_BOUND, (guint) lower_bound,
+                             PROP_QUANTIFICATION_UPPER_BOUND, (guint) upper_bound,
+                             PROP_QUANTIFICATION_POSITION, (lexeme_start_position + lexeme_end_position) / 2);
+}
+
 AstNode *
 create_binary_operator (OperatorType  operator_type,
                         AstNode      *left_operand,
@@ -200,3 +238,21 @@ create_binary_operator (OperatorType  operator_type,
       g_return_val_if_reached (NULL);
     }
 }
+
+AstNode *
+create_bracket_expression (AstNode  *items,
+                           gboolean  negated)
+{
+  g_return_val_if_fail (items != NULL, NULL);
+
+  return bracket_expression_new (PROP_UNARY_OPERATOR_OPERAND, items,
+                                 PROP_BRACKET_EXPRESSION_NEGATED, negated);
+}
+
+AstNode *
+create_group (AstNode *grouped_node)
+{
+  g_return_val_if_fail (grouped_node != NULL, NULL);
+
+  return group_new (PROP_UNARY_OPERATOR_OPERAND, grouped_node);
+}
@@ -27,6 +27,11 @@ static GParamSpec *obj_properties[N_PROPERTIES] = { NULL };
 static FsmConvertible *anchor_build_acceptor (AstNode        *self,
                                               FsmConvertible *operand_acceptor);
 
+static void            anchor_get_property   (GObject        *object,
+                                              guint           property_id,
+                                              GValue         *value,
+                                              GParamSpec     *pspec);
+
 static void            anchor_set_property   (GObject        *object,
                                               guint           property_id,
                                               const GValue   *value,
@@ -42,6 +47,7 @@ anchor_class_init (AnchorClass *klass)
 
   unary_operator_class->build_acceptor = anchor_build_acceptor;
 
+  object_class->get_property = anchor_get_property;
   object_class->set_property = anchor_set_property;
 
   obj_properties[PROP_START_TYPE] =
@@ -51,7 +57,7 @@ anchor_class_init (AnchorClass *klass)
                        ANCHOR_TYPE_UNDEFINED,
                        ANCHOR_TYPE_UNANCHORED,
                        ANCHOR_TYPE_UNDEFINED,
-                       G_PARAM_CONSTRUCT | G_PARAM_WRITABLE);
+                       G_PARAM_CONSTRUCT | G_PARAM_READWRITE);
 
   obj_properties[PROP_END_TYPE] =
     g_param_spec_uint (PROP_ANCHOR_END_TYPE,
@@ -60,7 +66,7 @@ anchor_class_init (AnchorClass *klass)
                        ANCHOR_TYPE_UNDEFINED,
                        ANCHOR_TYPE_UNANCHORED,
                        ANCHOR_TYPE_UNDEFINED,
-                       G_PARAM_CONSTRUCT | G_PARAM_WRITABLE);
+                       G_PARAM_CONSTRUCT | G_PARAM_READWRITE);
 
   g_object_class_install_properties (object_class,
                                      N_PROPERTIES,
@@ -214,6 +220,30 @@ anchor_build_acceptor (AstNode        *self,
   return epsilon_nfa_new (PROP_FSM_INITIALIZABLE_ALL_STATES, anchor_all_states);
 }
 
+static void
+anchor_get_property (GObject    *object,
+                     guint       property_id,
+                     GValue     *value,
+                     GParamSpec *pspec)
+{
+  AnchorPrivate *priv = anchor_get_instance_private (AST_NODES_ANCHOR (object));
+
+  switch (property_id)
+    {
+    case PROP_START_TYPE:
+      g_value_set_uint (value, priv->start_type);
+      break;
+
+    case PROP_END_TYPE:
+      g_value_set_uint (value, priv->end_type);
+      break;
+
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
+      break;
+    }
+}
+
 static void
 anchor_set_property (GObject      *object,
                      guint         property_id,
@@ -0,0 +1,263 @@
+#include "internal/semantic_analysis/ast_nodes/bracket_expression.h"
+#include "internal/semantic_analysis/ast_nodes/alternation.h"
+#include "internal/semantic_analysis/ast_nodes/constant.h"
+#include "internal/semantic_analysis/ast_nodes/range.h"
+#include "internal/semantic_analysis/utf8_sequences.h"
+#include "internal/state_machines/acceptors/epsilon_nfa.h"
+#include "internal/state_machines/fsm_initializable.h"
+#include "internal/state_machines/transitions/transition_factory.h"
+#include "internal/common/helpers.h"
+
+struct _BracketExpression
+{
+  UnaryOperator parent_instance;
+
+  gboolean      negated;
+};
+
+enum
+{
+  PROP_NEGATED = 1,
+  N_PROPERTIES
+};
+
+static GParamSpec *obj_properties[N_PROPERTIES] = { NULL };
+
+static FsmConvertible *bracket_expression_build_acceptor       (AstNode           *self);
+
+static GArray         *bracket_expression_fetch_ranges         (BracketExpression *self);
+
+static void            bracket_expression_collect_ranges       (AstNode           *item,
+                                                                GArray            *code_point_ranges);
+
+static gunichar        bracket_expression_fetch_constant_value (AstNode           *constant);
+
+static void            bracket_expression_get_property         (GObject           *object,
+                                                                guint              property_id,
+                                                                GValue            *value,
+                                                                GParamSpec        *pspec);
+
+static void            bracket_expression_set_property         (GObject           *object,
+                                                                guint              property_id,
+                                                                const GValue      *value,
+                                                                GParamSpec        *pspec);
+
+G_DEFINE_TYPE (BracketExpression, bracket_expression, AST_NODES_TYPE_UNARY_OPERATOR)
+
+static void
+bracket_expression_class_init (BracketExpressionClass *klass)
+{
+  AstNodeClass *ast_node_class = AST_NODES_AST_NODE_CLASS (klass);
+  GObjectClass *object_class = G_OBJECT_CLASS (klass);
+
+  /* Items are never built on their own, the whole bracket expression is instead collapsed
+   * into a single transition labelled with the union of all of them (or into a set of UTF-8
+   * sequences in case non-ASCII characters are listed). Validation is still delegated to the
+   * items so that invalid ranges keep being reported.
+   */
+  ast_node_class->build_acceptor = bracket_expression_build_acceptor;
+
+  object_class->get_property = bracket_expression_get_property;
+  object_class->set_property = bracket_expression_set_property;
+
+  obj_properties[PROP_NEGATED] =
+    g_param_spec_boolean (PROP_BRACKET_EXPRESSION_NEGATED,
+                          "Negated",
+                          "Describes whether or not the bracket expression matches the characters "
+                            "which are not listed among its items.",
+                          FALSE,
+                          G_PARAM_CONSTRUCT_ONLY | G_PARAM_READWRITE);
+
+  g_object_class_install_properties (object_class,
+                                     N_PROPERTIES,
+                                     obj_properties);
+}
+
+static void
+bracket_expression_init (BracketExpression *self)
+{
+  /* NOP */
+}
+
+CharacterSet *
+bracket_expression_fetch_character_set (BracketExpression *self)
+{
+  g_return_val_if_fail (AST_NODES_IS_BRACKET_EXPRESSION (self), NULL);
+
+  g_autoptr (GArray) code_point_ranges = bracket_expression_fetch_ranges (self);
+  CharacterSet *character_set = character_set_new ();
+
+  for (guint i = 0; i < code_point_ranges->len; ++i)
+    {
+      CodePointRange *range = &g_array_index (code_point_ranges, CodePointRange, i);
+
+      g_return_val_if_fail (range->upper <= G_MAXINT8, character_set);
+
+      character_set_add_range (character_set, (gchar) range->lower, (gchar) range->upper);
+    }
+
+  return character_set;
+}
+
+GPtrArray *
+bracket_expression_fetch_sequences (BracketExpression *self)
+{
+  g_return_val_if_fail (AST_NODES_IS_BRACKET_EXPRESSION (self), NULL);
+
+  g_autoptr (GArray) code_point_ranges = bracket_expression_fetch_ranges (self);
+
+  /* The complement always covers the non-ASCII characters as well. */
+  if (self->negated)
+    return create_utf8_sequences (code_point_ranges, TRUE);
+
+  for (guint i = 0; i < code_point_ranges->len; ++i)
+    if (g_array_index (code_point_ranges, CodePointRange, i).upper > G_MAXINT8)
+      return create_utf8_sequences (code_point_ranges, FALSE);
+
+  return NULL;
+}
+
+static FsmConvertible *
+bracket_expression_build_acceptor (AstNode *self)
+{
+  g_return_val_if_fail (AST_NODES_IS_BRACKET_EXPRESSION (self), NULL);
+
+  g_autoptr (GPtrArray) sequences = bracket_expression_fetch_sequences (AST_NODES_BRACKET_EXPRESSION (self));
+
+  if (sequences != NULL)
+    return build_utf8_sequences_acceptor (sequences);
+
+  g_autoptr (CharacterSet) expected_characters =
+    bracket_expression_fetch_character_set (AST_NODES_BRACKET_EXPRESSION (self));
+  g_autoptr (GPtrArray) all_states = g_ptr_array_new_with_free_func (g_object_unref);
+  State *start = state_new (PROP_STATE_TYPE_FLAGS, STATE_TYPE_START);
+  State *final = state_new (PROP_STATE_TYPE_FLAGS, STATE_TYPE_FINAL);
+  g_autoptr (GPtrArray) start_transitions = g_ptr_array_new_with_free_func (g_object_unref);
+  Transition *start_on_items = create_deterministic_set_transition (expected_characters, final);
+
+  g_ptr_array_add (start_transitions, start_on_items);
+
+  g_object_set (start,
+                PROP_STATE_TRANSITIONS, start_transitions,
+                NULL);
+
+  g_ptr_array_add_multiple (all_states,
+                            start, final,
+                            NULL);
+
+  return epsilon_nfa_new (PROP_FSM_INITIALIZABLE_ALL_STATES, all_states);
+}
+
+static GArray *
+bracket_expression_fetch_ranges (BracketExpression *self)
+{
+  g_autoptr (AstNode) items = NULL;
+  GArray *code_point_ranges = g_array_new (FALSE, FALSE, sizeof (CodePointRange));
+
+  g_object_get (self,
+                PROP_UNARY_OPERATOR_OPERAND, &items,
+                NULL);
+
+  bracket_expression_collect_ranges (items, code_point_ranges);
+
+  return code_point_ranges;
+}
+
+static void
+bracket_expression_collect_ranges (AstNode *item,
+                                   GArray  *code_point_ranges)
+{
+  if (AST_NODES_IS_ALTERNATION (item))
+    {
+      g_autoptr (AstNode) left_operand = NULL;
+      g_autoptr (AstNode) right_operand = NULL;
+
+      g_object_get (item,
+                    PROP_BINARY_OPERATOR_LEFT_OPERAND, &left_operand,
+                    PROP_BINARY_OPERATOR_RIGHT_OPERAND, &right_operand,
+                    NULL);
+
+      bracket_expression_collect_ranges (left_operand, code_point_ranges);
+      bracket_expression_collect_ranges (right_operand, code_point_ranges);
+    }
+  else if (AST_NODES_IS_RANGE (item))
+    {
+      g_autoptr (AstNode) left_operand = NULL;
+      g_autoptr (AstNode) right_operand = NULL;
+
+      g_object_get (item,
+                    PROP_BINARY_OPERATOR_LEFT_OPERAND, &left_operand,
+                    PROP_BINARY_OPERATOR_RIGHT_OPERAND, &right_operand,
+                    NULL);
+
+      CodePointRange range = { bracket_expression_fetch_constant_value (left_operand),
+                               bracket_expression_fetch_constant_value (right_operand) };
+
+      g_array_append_val (code_point_ranges, range);
+    }
+  else if (AST_NODES_IS_CONSTANT (item))
+    {
+      gunichar value = bracket_expression_fetch_constant_value (item);
+      CodePointRange range = { value, value };
+
+      g_array_append_val (code_point_ranges, range);
+    }
+  else
+    {
+      g_return_if_reached ();
+    }
+}
+
+static gunichar
+bracket_expression_fetch_constant_value (AstNode *constant)
+{
+  g_return_val_if_fail (AST_NODES_IS_CONSTANT (constant), 0);
+
+  gunichar value = 0;
+
+  g_object_get (constant,
+                PROP_CONSTANT_VALUE, &value,
+                NULL);
+
+  return value;
+}
+
+static void
+bracket_expression_get_property (GObject    *object,
+                                 guint       property_id,
+                                 GValue     *value,
+                                 GParamSpec *pspec)
+{
+  BracketExpression *self = AST_NODES_BRACKET_EXPRESSION (object);
+
+  switch (property_id)
+    {
+    case PROP_NEGATED:
+      g_value_set_boolean (value, self->negated);
+      break;
+
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
+      break;
+    }
+}
+
+static void
+bracket_expression_set_property (GObject      *object,
+                                 guint         property_id,
+                                 const GValue *value,
+                                 GParamSpec   *pspec)
+{
+  BracketExpression *self = AST_NODES_BRACKET_EXPRESSION (object);
+
+  switch (property_id)
+    {
+    case PROP_NEGATED:
+      self->negated = g_value_get_boolean (value);
+      break;
+
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
+      break;
+    }
+}
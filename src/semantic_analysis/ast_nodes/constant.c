@@ -1,4 +1,5 @@
 #include "internal/semantic_analysis/ast_nodes/constant.h"
+#include "internal/semantic_analysis/utf8_sequences.h"
 #include "internal/state_machines/acceptors/epsilon_nfa.h"
 #include "internal/state_machines/fsm_initializable.h"
 #include "internal/state_machines/transitions/transition_factory.h"
@@ -6,8 +7,8 @@
 
 typedef struct
 {
-  gchar value;
-  guint position;
+  gunichar value;
+  guint    position;
 } ConstantPrivate;
 
 enum
@@ -45,11 +46,11 @@ constant_class_init (ConstantClass *klass)
   object_class->set_property = constant_set_property;
 
   obj_properties[PROP_VALUE] =
-    g_param_spec_char (PROP_CONSTANT_VALUE,
+    g_param_spec_uint (PROP_CONSTANT_VALUE,
                        "Value",
-                       "Value of the constant which can be either a letter, a digit, a special character, etc.",
+                       "Code point of the constant which can be either a letter, a digit, a special character, etc.",
                        0,
-                       G_MAXINT8,
+                       0x10FFFF,
                        0,
                        G_PARAM_CONSTRUCT_ONLY | G_PARAM_READWRITE);
 
@@ -73,13 +74,35 @@ constant_init (Constant *self)
   /* NOP */
 }
 
+GPtrArray *
+constant_fetch_sequences (Constant *self)
+{
+  g_return_val_if_fail (AST_NODES_IS_CONSTANT (self), NULL);
+
+  ConstantPrivate *priv = constant_get_instance_private (self);
+
+  /* The dot metacharacter matches a whole character as well, not a single byte of one. */
+  if (priv->value == ANY)
+    return create_utf8_any_sequences ();
+
+  if (priv->value > G_MAXINT8)
+    return create_utf8_range_sequences (priv->value, priv->value);
+
+  return NULL;
+}
+
 static FsmConvertible *
 constant_build_acceptor (AstNode *self)
 {
   g_return_val_if_fail (AST_NODES_IS_CONSTANT (self), NULL);
 
   ConstantPrivate *priv = constant_get_instance_private (AST_NODES_CONSTANT (self));
-  gchar expected_character = priv->value;
+  g_autoptr (GPtrArray) sequences = constant_fetch_sequences (AST_NODES_CONSTANT (self));
+
+  if (sequences != NULL)
+    return build_utf8_sequences_acceptor (sequences);
+
+  gchar expected_character = (gchar) priv->value;
   g_autoptr (GPtrArray) all_states = g_ptr_array_new_with_free_func (g_object_unref);
   State *start = state_new (PROP_STATE_TYPE_FLAGS, STATE_TYPE_START);
   State *final = state_new (PROP_STATE_TYPE_FLAGS, STATE_TYPE_FINAL);
@@ -109,7 +132,7 @@ constant_get_property (GObject    *object,
   switch (property_id)
     {
     case PROP_VALUE:
-      g_value_set_schar (value, priv->value);
+      g_value_set_uint (value, priv->value);
       break;
 
     case PROP_POSITION:
@@ -133,7 +156,7 @@ constant_set_property (GObject      *object,
   switch (property_id)
     {
     case PROP_VALUE:
-      priv->value = g_value_get_schar (value);
+      priv->value = g_value_get_uint (value);
       break;
 
     case PROP_POSITION:
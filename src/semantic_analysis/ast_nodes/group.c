@@ -0,0 +1,36 @@
+#include "internal/semantic_analysis/ast_nodes/group.h"
+
+struct _Group
+{
+  UnaryOperator parent_instance;
+};
+
+static FsmConvertible *group_build_acceptor (AstNode        *self,
+                                             FsmConvertible *operand_acceptor);
+
+G_DEFINE_TYPE (Group, group, AST_NODES_TYPE_UNARY_OPERATOR)
+
+static void
+group_class_init (GroupClass *klass)
+{
+  UnaryOperatorClass *unary_operator_class = AST_NODES_UNARY_OPERATOR_CLASS (klass);
+
+  unary_operator_class->build_acceptor = group_build_acceptor;
+}
+
+static void
+group_init (Group *self)
+{
+  /* NOP */
+}
+
+static FsmConvertible *
+group_build_acceptor (AstNode        *self,
+                      FsmConvertible *operand_acceptor)
+{
+  g_return_val_if_fail (AST_NODES_IS_GROUP (self), NULL);
+  g_return_val_if_fail (operand_acceptor != NULL, NULL);
+
+  /* Grouping only matters when the capture groups are tracked, it accepts exactly what its operand does. */
+  return g_object_ref (operand_acceptor);
+}
@@ -3,6 +3,7 @@
 #include "internal/state_machines/fsm_initializable.h"
 #include "internal/state_machines/transitions/transition_factory.h"
 #include "internal/common/helpers.h"
+#include "core/errors.h"
 
 struct _Quantification
 {
@@ -11,26 +12,43 @@ struct _Quantification
 
 typedef struct
 {
-  QuantificationBoundType lower_bound;
-  QuantificationBoundType upper_bound;
+  guint lower_bound;
+  guint upper_bound;
+  guint position;
 } QuantificationPrivate;
 
 enum
 {
   PROP_LOWER_BOUND = 1,
   PROP_UPPER_BOUND,
+  PROP_POSITION,
   N_PROPERTIES
 };
 
 static GParamSpec *obj_properties[N_PROPERTIES] = { NULL };
 
-static FsmConvertible *quantification_build_acceptor (AstNode        *self,
-                                                      FsmConvertible *operand_acceptor);
+static FsmConvertible *quantification_build_acceptor (AstNode         *self,
+                                                      FsmConvertible  *operand_acceptor);
 
-static void            quantification_set_property   (GObject        *object,
-                                                      guint           property_id,
-                                                      const GValue   *value,
-                                                      GParamSpec     *pspec);
+static gboolean        quantification_is_valid       (AstNode         *self,
+                                                      GError         **error);
+
+static void            quantification_connect        (State           *state,
+                                                      State           *output_state,
+                                                      State           *alternative_output_state);
+
+static void            quantification_get_property   (GObject         *object,
+                                                      guint            property_id,
+                                                      GValue          *value,
+                                                      GParamSpec      *pspec);
+
+static void            quantification_set_property   (GObject         *object,
+                                                      guint            property_id,
+                                                      const GValue    *value,
+                                                      GParamSpec      *pspec);
+
+G_DEFINE_QUARK (semantic-analysis-quantification-error-quark, semantic_analysis_quantification_error)
+#define SEMANTIC_ANALYSIS_QUANTIFICATION_ERROR (semantic_analysis_quantification_error_quark ())
 
 G_DEFINE_TYPE_WITH_PRIVATE (Quantification, quantification, AST_NODES_TYPE_UNARY_OPERATOR)
 
@@ -38,29 +56,42 @@ static void
 quantification_class_init (QuantificationClass *klass)
 {
   UnaryOperatorClass *unary_operator_class = AST_NODES_UNARY_OPERATOR_CLASS (klass);
+  AstNodeClass *ast_node_class = AST_NODES_AST_NODE_CLASS (klass);
   GObjectClass *object_class = G_OBJECT_CLASS (klass);
 
   unary_operator_class->build_acceptor = quantification_build_acceptor;
 
+  ast_node_class->is_valid = quantification_is_valid;
+
+  object_class->get_property = quantification_get_property;
   object_class->set_property = quantification_set_property;
 
   obj_properties[PROP_LOWER_BOUND] =
     g_param_spec_uint (PROP_QUANTIFICATION_LOWER_BOUND,
                        "Lower bound",
-                       "Lower bound of the quantification operator.",
-                       QUANTIFICATION_BOUND_TYPE_UNDEFINED,
-                       QUANTIFICATION_BOUND_TYPE_INFINITY,
-                       QUANTIFICATION_BOUND_TYPE_UNDEFINED,
-                       G_PARAM_CONSTRUCT | G_PARAM_WRITABLE);
+                       "Minimal number of repetitions of the operand.",
+                       0,
+                       QUANTIFICATION_BOUND_INFINITY,
+                       0,
+                       G_PARAM_CONSTRUCT | G_PARAM_READWRITE);
 
   obj_properties[PROP_UPPER_BOUND] =
     g_param_spec_uint (PROP_QUANTIFICATION_UPPER_BOUND,
                        "Upper bound",
-                       "Upper bound of the quantification operator.",
-                       QUANTIFICATION_BOUND_TYPE_UNDEFINED,
-                       QUANTIFICATION_BOUND_TYPE_INFINITY,
-                       QUANTIFICATION_BOUND_TYPE_UNDEFINED,
-                       G_PARAM_CONSTRUCT | G_PARAM_WRITABLE);
+                       "Maximal number of repetitions of the operand.",
+                       0,
+                       QUANTIFICATION_BOUND_INFINITY,
+                       QUANTIFICATION_BOUND_INFINITY,
+                       G_PARAM_CONSTRUCT | G_PARAM_READWRITE);
+
+  obj_properties[PROP_POSITION] =
+    g_param_spec_uint (PROP_QUANTIFICATION_POSITION,
+                       "Position",
+                       "Position of the quantification operator relative to the beginning of the input.",
+                       0,
+                       G_MAXUINT32,
+                       0,
+                       G_PARAM_CONSTRUCT_ONLY | G_PARAM_READWRITE);
 
   g_object_class_install_properties (object_class,
                                      N_PROPERTIES,
@@ -81,96 +112,162 @@ quantification_build_acceptor (AstNode        *self,
   g_return_val_if_fail (operand_acceptor != NULL, NULL);
 
   QuantificationPrivate *priv = quantification_get_instance_private (AST_NODES_QUANTIFICATION (self));
-  QuantificationBoundType lower_bound = priv->lower_bound;
-  QuantificationBoundType upper_bound = priv->upper_bound;
-
-  g_autoptr (GPtrArray) all_states = NULL;
-  g_autoptr (State) start = NULL;
-  g_autoptr (State) final = NULL;
+  guint lower_bound = priv->lower_bound;
+  guint upper_bound = priv->upper_bound;
+  gboolean is_unbounded = (upper_bound == QUANTIFICATION_BOUND_INFINITY);
 
+  g_autoptr (AstNode) operand = NULL;
   g_autoptr (GPtrArray) quantification_all_states = g_ptr_array_new_with_free_func (g_object_unref);
   State *quantification_start = state_new (PROP_STATE_TYPE_FLAGS, STATE_TYPE_START);
   State *quantification_final = state_new (PROP_STATE_TYPE_FLAGS, STATE_TYPE_FINAL);
 
-  g_object_get (operand_acceptor,
-                PROP_FSM_INITIALIZABLE_ALL_STATES, &all_states,
-                PROP_FSM_INITIALIZABLE_START_STATE, &start,
-                PROP_EPSILON_NFA_FINAL_STATE, &final,
+  g_object_get (self,
+                PROP_UNARY_OPERATOR_OPERAND, &operand,
                 NULL);
 
-  g_autoptr (GPtrArray) quantification_start_transitions = g_ptr_array_new_with_free_func (g_object_unref);
-  g_autoptr (GPtrArray) final_transitions = g_ptr_array_new_with_free_func (g_object_unref);
-  Transition *quantification_start_on_epsilon = NULL;
-  Transition *final_on_epsilon = NULL;
+  /* The operand is repeated as many times as the explicitly given bounds require while an
+   * unbounded repetition only needs to loop over its last copy (at least one is always needed).
+   */
+  guint copies_count = is_unbounded ? MAX (lower_bound, 1) : upper_bound;
+  State *current = quantification_start;
+  g_autoptr (State) copy_start = NULL;
 
-  switch (lower_bound)
-    {
-    case QUANTIFICATION_BOUND_TYPE_ZERO:
-      {
-        g_autoptr (GPtrArray) quantification_start_output_states = g_ptr_array_new ();
+  g_ptr_array_add_multiple (quantification_all_states,
+                            quantification_start, quantification_final,
+                            NULL);
 
-        g_ptr_array_add_multiple (quantification_start_output_states,
-                                  start, quantification_final,
-                                  NULL);
+  for (guint i = 0; i < copies_count; ++i)
+    {
+      g_autoptr (FsmConvertible) copy_acceptor = NULL;
+      g_autoptr (GPtrArray) all_states = NULL;
+      g_autoptr (State) copy_final = NULL;
+
+      /* Every copy past the first one is built from the same (shared) abstract syntax tree node. */
+      if (i == 0)
+        copy_acceptor = g_object_ref (operand_acceptor);
+      else
+        copy_acceptor = ast_node_build_acceptor (operand);
+
+      g_clear_object (&copy_start);
+
+      g_object_get (copy_acceptor,
+                    PROP_FSM_INITIALIZABLE_ALL_STATES, &all_states,
+                    PROP_FSM_INITIALIZABLE_START_STATE, &copy_start,
+                    PROP_EPSILON_NFA_FINAL_STATE, &copy_final,
+                    NULL);
+
+      g_object_set (copy_start,
+                    PROP_STATE_TYPE_FLAGS, STATE_TYPE_DEFAULT,
+                    NULL);
+      g_object_set (copy_final,
+                    PROP_STATE_TYPE_FLAGS, STATE_TYPE_DEFAULT,
+                    NULL);
+
+      /* Copies which are not mandatory can be skipped entirely. */
+      quantification_connect (current,
+                              copy_start,
+                              i >= lower_bound ? quantification_final : NULL);
+
+      g_ptr_array_add_range (quantification_all_states,
+                             all_states,
+                             g_object_ref);
+
+      current = copy_final;
+    }
 
-        quantification_start_on_epsilon = create_nondeterministic_transition (EPSILON, quantification_start_output_states);
-      }
-      break;
+  /* The last copy loops back onto itself in case of an unbounded repetition. */
+  if (is_unbounded)
+    quantification_connect (current, copy_start, quantification_final);
+  else
+    quantification_connect (current, quantification_final, NULL);
 
-    case QUANTIFICATION_BOUND_TYPE_ONE:
-      quantification_start_on_epsilon = create_deterministic_transition (EPSILON, start);
-      break;
+  return epsilon_nfa_new (PROP_FSM_INITIALIZABLE_ALL_STATES, quantification_all_states);
+}
 
-    default:
-      g_return_val_if_reached (NULL);
-    }
+static gboolean
+quantification_is_valid (AstNode  *self,
+                         GError  **error)
+{
+  g_return_val_if_fail (AST_NODES_IS_QUANTIFICATION (self), FALSE);
 
-  g_ptr_array_add (quantification_start_transitions, quantification_start_on_epsilon);
+  if (!AST_NODES_AST_NODE_CLASS (quantification_parent_class)->is_valid (self, error))
+    return FALSE;
 
-  g_object_set (quantification_start,
-                PROP_STATE_TRANSITIONS, quantification_start_transitions,
-                NULL);
+  QuantificationPrivate *priv = quantification_get_instance_private (AST_NODES_QUANTIFICATION (self));
+  guint lower_bound = priv->lower_bound;
+  guint upper_bound = priv->upper_bound;
 
-  switch (upper_bound)
+  if (lower_bound > QUANTIFICATION_BOUND_MAXIMUM ||
+      (upper_bound != QUANTIFICATION_BOUND_INFINITY && upper_bound > QUANTIFICATION_BOUND_MAXIMUM) ||
+      lower_bound > upper_bound)
     {
-    case QUANTIFICATION_BOUND_TYPE_INFINITY:
-      {
-        g_autoptr (GPtrArray) final_output_states = g_ptr_array_new ();
+      g_set_error (error,
+                   SEMANTIC_ANALYSIS_QUANTIFICATION_ERROR,
+                   SEMANTIC_ANALYSIS_QUANTIFICATION_ERROR_INVALID_BOUNDS,
+                   "Invalid quantification bounds (position - %d)", priv->position);
 
-        g_ptr_array_add_multiple (final_output_states,
-                                  start, quantification_final,
-                                  NULL);
+      return FALSE;
+    }
 
-        final_on_epsilon = create_nondeterministic_transition (EPSILON, final_output_states);
-      }
-      break;
+  return TRUE;
+}
 
-    case QUANTIFICATION_BOUND_TYPE_ONE:
-      final_on_epsilon = create_deterministic_transition (EPSILON, quantification_final);
-      break;
+static void
+quantification_connect (State *state,
+                        State *output_state,
+                        State *alternative_output_state)
+{
+  g_autoptr (GPtrArray) transitions = g_ptr_array_new_with_free_func (g_object_unref);
+  Transition *transition = NULL;
 
-    default:
-      g_return_val_if_reached (NULL);
+  if (alternative_output_state == NULL)
+    {
+      transition = create_deterministic_transition (EPSILON, output_state);
     }
+  else
+    {
+      g_autoptr (GPtrArray) output_states = g_ptr_array_new ();
 
-  g_ptr_array_add (final_transitions, final_on_epsilon);
+      g_ptr_array_add_multiple (output_states,
+                                output_state, alternative_output_state,
+                                NULL);
 
-  g_object_set (start,
-                PROP_STATE_TYPE_FLAGS, STATE_TYPE_DEFAULT,
-                NULL);
-  g_object_set (final,
-                PROP_STATE_TYPE_FLAGS, STATE_TYPE_DEFAULT,
-                PROP_STATE_TRANSITIONS, final_transitions,
+      transition = create_nondeterministic_transition (EPSILON, output_states);
+    }
+
+  g_ptr_array_add (transitions, transition);
+
+  g_object_set (state,
+                PROP_STATE_TRANSITIONS, transitions,
                 NULL);
+}
 
-  g_ptr_array_add_multiple (quantification_all_states,
-                            quantification_start, quantification_final,
-                            NULL);
-  g_ptr_array_add_range (quantification_all_states,
-                         all_states,
-                         g_object_ref);
+static void
+quantification_get_property (GObject    *object,
+                             guint       property_id,
+                             GValue     *value,
+                             GParamSpec *pspec)
+{
+  QuantificationPrivate *priv = quantification_get_instance_private (AST_NODES_QUANTIFICATION (object));
 
-  return epsilon_nfa_new (PROP_FSM_INITIALIZABLE_ALL_STATES, quantification_all_states);
+  switch (property_id)
+    {
+    case PROP_LOWER_BOUND:
+      g_value_set_uint (value, priv->lower_bound);
+      break;
+
+    case PROP_UPPER_BOUND:
+      g_value_set_uint (value, priv->upper_bound);
+      break;
+
+    case PROP_POSITION:
+      g_value_set_uint (value, priv->position);
+      break;
+
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
+      break;
+    }
 }
 
 static void
@@ -184,11 +281,15 @@ quantification_set_property (GObject      *object,
   switch (property_id)
     {
     case PROP_LOWER_BOUND:
-      priv->lower_bound = (QuantificationBoundType) g_value_get_uint (value);
+      priv->lower_bound = g_value_get_uint (value);
       break;
 
     case PROP_UPPER_BOUND:
-      priv->upper_bound = (QuantificationBoundType) g_value_get_uint (value);
+      priv->upper_bound = g_value_get_uint (value);
+      break;
+
+    case PROP_POSITION:
+      priv->position = g_value_get_uint (value);
       break;
 
     default:
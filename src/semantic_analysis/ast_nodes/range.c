@@ -1,5 +1,6 @@
 #include "internal/semantic_analysis/ast_nodes/range.h"
 #include "internal/semantic_analysis/ast_nodes/constant.h"
+#include "internal/semantic_analysis/utf8_sequences.h"
 #include "internal/state_machines/acceptors/epsilon_nfa.h"
 #include "internal/state_machines/fsm_initializable.h"
 #include "internal/state_machines/transitions/transition_factory.h"
@@ -52,8 +53,8 @@ range_build_acceptor (AstNode *self)
   Constant *left_constant = AST_NODES_CONSTANT (left_operand);
   Constant *right_constant = AST_NODES_CONSTANT (right_operand);
 
-  gchar lower_value = 0;
-  gchar upper_value = 0;
+  gunichar lower_value = 0;
+  gunichar upper_value = 0;
 
   g_object_get (left_constant,
                 PROP_CONSTANT_VALUE, &lower_value,
@@ -62,18 +63,27 @@ range_build_acceptor (AstNode *self)
                 PROP_CONSTANT_VALUE, &upper_value,
                 NULL);
 
+  /* Non-ASCII characters are matched by sequences of bytes. */
+  if (upper_value > G_MAXINT8)
+    {
+      g_autoptr (GPtrArray) sequences = create_utf8_range_sequences (lower_value, upper_value);
+
+      return build_utf8_sequences_acceptor (sequences);
+    }
+
   g_autoptr (GPtrArray) all_states = g_ptr_array_new_with_free_func (g_object_unref);
   State *start = state_new (PROP_STATE_TYPE_FLAGS, STATE_TYPE_START);
   State *final = state_new (PROP_STATE_TYPE_FLAGS, STATE_TYPE_FINAL);
   g_autoptr (GPtrArray) start_transitions = g_ptr_array_new_with_free_func (g_object_unref);
+  g_autoptr (CharacterSet) expected_characters = character_set_new ();
 
-  for (gchar expected_character = lower_value; expected_character <= upper_value; ++expected_character)
-    {
-      Transition *start_on_value = create_deterministic_transition (expected_character,
-                                                                    final);
+  /* The whole range is represented by a single transition instead of one for each value. */
+  character_set_add_range (expected_characters, (gchar) lower_value, (gchar) upper_value);
 
-      g_ptr_array_add (start_transitions, start_on_value);
-    }
+  Transition *start_on_values = create_deterministic_set_transition (expected_characters,
+                                                                     final);
+
+  g_ptr_array_add (start_transitions, start_on_values);
 
   g_object_set (start,
                 PROP_STATE_TRANSITIONS, start_transitions,
@@ -106,7 +116,7 @@ range_is_valid (AstNode  *self,
   Constant *left_constant = AST_NODES_CONSTANT (left_operand);
   Constant *right_constant = AST_NODES_CONSTANT (right_operand);
 
-  gchar left_value = 0, right_value = 0;
+  gunichar left_value = 0, right_value = 0;
   guint left_position = 0, right_position = 0;
 
   g_object_get (left_constant,
@@ -0,0 +1,1310 @@
+#include "internal/semantic_analysis/position_automaton.h"
+#include "internal/semantic_analysis/ast_nodes/alternation.h"
+#include "internal/semantic_analysis/ast_nodes/anchor.h"
+#include "internal/semantic_analysis/ast_nodes/bracket_expression.h"
+#include "internal/semantic_analysis/ast_nodes/concatenation.h"
+#include "internal/semantic_analysis/ast_nodes/constant.h"
+#include "internal/semantic_analysis/ast_nodes/empty.h"
+#include "internal/semantic_analysis/ast_nodes/group.h"
+#include "internal/semantic_analysis/ast_nodes/quantification.h"
+#include "internal/semantic_analysis/ast_nodes/range.h"
+#include "internal/semantic_analysis/utf8_sequences.h"
+#include "internal/state_machines/acceptors/nfa.h"
+#include "internal/state_machines/acceptors/bit_parallel_nfa.h"
+#include "internal/state_machines/acceptors/tagged_nfa.h"
+#include "internal/state_machines/fsm_initializable.h"
+#include "internal/state_machines/transitions/transition_factory.h"
+#include "internal/common/helpers.h"
+
+#include <string.h>
+
+/* Positions are numbered in the order in which they are encountered (from left to right) and
+ * each one of them describes the characters that can be consumed when entering it - either a
+ * single character (constants and anchors) or a whole set of them (ranges and bracket expressions).
+ * The dot metacharacter, negated bracket expressions and non-ASCII characters are consumed byte by byte,
+ * each node of their UTF-8 sequences (the bytes they share counted only once) is a position.
+ *
+ * In case the capture groups are tracked, each position also remembers the groups enclosing it (from
+ * the outermost to the innermost one) and each follow pair becomes an edge which closes the groups being
+ * left and opens the ones being entered - the groups enclosing the node which defined the pair are neither.
+ * Nullable groups skipped over by an edge match the empty string at the edge's offset instead, which is why
+ * each first and last position also remembers the groups it skips (and so does the node matching nothing).
+ */
+typedef struct
+{
+  GArray     *characters;
+  GPtrArray  *character_sets;
+  GPtrArray  *follow_sets;
+
+  GHashTable *group_indices;
+  GArray     *group_stack;
+  GPtrArray  *enclosing_groups;
+  GPtrArray  *follow_edges;
+  GArray     *operations;
+} Positions;
+
+typedef struct
+{
+  gboolean   nullable;
+  GArray    *first;
+  GArray    *last;
+
+  GPtrArray *first_skipped_groups;
+  GPtrArray *last_skipped_groups;
+  GArray    *empty_groups;
+} PositionSets;
+
+static void            positions_init                           (Positions     *positions);
+
+static void            positions_clear                          (Positions     *positions);
+
+static void            positions_track_groups                   (Positions     *positions,
+                                                                 AstNode       *abstract_syntax_tree);
+
+static PositionSets   *position_sets_new                        (gboolean       nullable);
+
+static void            position_sets_free                       (PositionSets  *sets);
+
+static void            position_sets_append_first               (PositionSets  *sets,
+                                                                 PositionSets  *source_sets,
+                                                                 GArray        *preceding_groups);
+
+static void            position_sets_append_last                (PositionSets  *sets,
+                                                                 PositionSets  *source_sets,
+                                                                 GArray        *following_groups);
+
+G_DEFINE_AUTOPTR_CLEANUP_FUNC (PositionSets, position_sets_free)
+
+static PositionSets   *position_automaton_compute_sets          (AstNode       *node,
+                                                                 Positions     *positions,
+                                                                 gboolean       start_anchors_are_redundant,
+                                                                 gboolean       end_anchors_are_redundant);
+
+static PositionSets   *position_automaton_define_position       (Positions     *positions,
+                                                                 gchar          character,
+                                                                 CharacterSet  *character_set);
+
+static PositionSets   *position_automaton_compute_range         (AstNode       *node,
+                                                                 Positions     *positions);
+
+static GPtrArray      *position_automaton_fetch_sequences       (AstNode       *node);
+
+static PositionSets   *position_automaton_compute_sequences     (GPtrArray     *sequences,
+                                                                 Positions     *positions);
+
+static PositionSets   *position_automaton_compute_alternation   (PositionSets  *left_sets,
+                                                                 PositionSets  *right_sets);
+
+static PositionSets   *position_automaton_compute_concatenation (PositionSets  *left_sets,
+                                                                 PositionSets  *right_sets,
+                                                                 Positions     *positions);
+
+static void            position_automaton_define_follow         (Positions     *positions,
+                                                                 PositionSets  *from_sets,
+                                                                 PositionSets  *to_sets);
+
+static void            position_automaton_number_groups         (AstNode       *node,
+                                                                 GHashTable    *group_indices);
+
+static TaggedEdge      position_automaton_define_edge           (Positions     *positions,
+                                                                 gint           from_position,
+                                                                 gint           to_position,
+                                                                 guint          depth,
+                                                                 GArray        *skipped_groups);
+
+static GArray         *position_automaton_join_groups           (GArray        *left_groups,
+                                                                 GArray        *right_groups);
+
+static void            position_automaton_free_groups           (gpointer       groups);
+
+static GPtrArray      *position_automaton_fetch_character_sets  (Positions     *positions);
+
+static FsmConvertible *position_automaton_assemble              (Positions     *positions,
+                                                                 gboolean       nullable,
+                                                                 GArray        *initial_positions,
+                                                                 GArray        *final_positions,
+                                                                 GPtrArray     *follow_sets,
+                                                                 CharacterSet  *looping_characters);
+
+static GPtrArray      *position_automaton_reverse_follow_sets   (Positions     *positions);
+
+static void            position_automaton_define_transitions    (State         *state,
+                                                                 GHashTable    *output_positions,
+                                                                 GPtrArray     *position_states,
+                                                                 Positions     *positions,
+                                                                 CharacterSet  *looping_characters);
+
+static Transition     *position_automaton_create_transition     (Positions     *positions,
+                                                                 guint          position,
+                                                                 State         *output_state);
+
+static guint64         position_automaton_compute_mask          (GArray        *positions_array);
+
+static guint64         position_automaton_compute_follow_mask   (GHashTable    *follow_set);
+
+FsmConvertible *
+build_position_automaton (AstNode *abstract_syntax_tree)
+{
+  g_return_val_if_fail (AST_NODES_IS_AST_NODE (abstract_syntax_tree), NULL);
+
+  Positions positions;
+
+  positions_init (&positions);
+
+  g_autoptr (PositionSets) sets = position_automaton_compute_sets (abstract_syntax_tree,
+                                                                   &positions,
+                                                                   FALSE,
+                                                                   FALSE);
+  FsmConvertible *nfa = position_automaton_assemble (&positions,
+                                                     sets->nullable,
+                                                     sets->first,
+                                                     sets->last,
+                                                     positions.follow_sets,
+                                                     NULL);
+
+  positions_clear (&positions);
+
+  return nfa;
+}
+
+FsmConvertible *
+build_reverse_position_automaton (AstNode *abstract_syntax_tree)
+{
+  g_return_val_if_fail (AST_NODES_IS_AST_NODE (abstract_syntax_tree), NULL);
+
+  Positions positions;
+
+  positions_init (&positions);
+
+  g_autoptr (PositionSets) sets = position_automaton_compute_sets (abstract_syntax_tree,
+                                                                   &positions,
+                                                                   FALSE,
+                                                                   FALSE);
+  g_autoptr (GPtrArray) reversed_follow_sets = position_automaton_reverse_follow_sets (&positions);
+  g_autoptr (CharacterSet) looping_characters = character_set_new ();
+
+  /* Reading the input backwards - the positions which end the expression are entered first and
+   * the ones which begin it are the final ones. Looping on every byte in the initial state
+   * makes the automaton find every position at which a match begins in a single pass.
+   */
+  character_set_add_range (looping_characters, EPSILON + 1, (gchar) G_MAXUINT8);
+
+  FsmConvertible *nfa = position_automaton_assemble (&positions,
+                                                     sets->nullable,
+                                                     sets->last,
+                                                     sets->first,
+                                                     reversed_follow_sets,
+                                                     looping_characters);
+
+  positions_clear (&positions);
+
+  return nfa;
+}
+
+AcceptorRunnable *
+build_bit_parallel_automaton (AstNode *abstract_syntax_tree)
+{
+  g_return_val_if_fail (AST_NODES_IS_AST_NODE (abstract_syntax_tree), NULL);
+
+  /* The upper bound is checked first so that no positions are defined for long expressions. */
+  if (count_positions (abstract_syntax_tree) > BIT_PARALLEL_NFA_MAX_POSITIONS)
+    return NULL;
+
+  Positions positions;
+
+  positions_init (&positions);
+
+  g_autoptr (PositionSets) sets = position_automaton_compute_sets (abstract_syntax_tree,
+                                                                   &positions,
+                                                                   FALSE,
+                                                                   FALSE);
+  guint positions_count = positions.characters->len;
+  guint64 follow_sets[BIT_PARALLEL_NFA_MAX_POSITIONS] = { 0 };
+  guint64 signatures[G_MAXUINT8 + 1] = { 0 };
+  guint64 character_masks[G_MAXUINT8 + 1] = { 0 };
+  g_autoptr (State) scratch_state = state_new (PROP_STATE_TYPE_FLAGS, STATE_TYPE_DEFAULT);
+  g_autoptr (GPtrArray) transitions = g_ptr_array_new_with_free_func (g_object_unref);
+  g_autoptr (GHashTable) representatives = g_hash_table_new (g_int64_hash, g_int64_equal);
+
+  for (guint i = 0; i < positions_count; ++i)
+    {
+      guint64 position = G_GUINT64_CONSTANT (1) << i;
+      Transition *transition = position_automaton_create_transition (&positions, i, scratch_state);
+      g_autoptr (CharacterSet) expected_characters = transition_fetch_expected_characters (transition);
+
+      for (guint character = 0; character < G_N_ELEMENTS (signatures); ++character)
+        if (character_set_contains (expected_characters, (gchar) character))
+          signatures[character] |= position;
+
+      g_ptr_array_add (transitions, transition);
+
+      follow_sets[i] = position_automaton_compute_follow_mask (g_ptr_array_index (positions.follow_sets, i));
+    }
+
+  /* Characters expected by exactly the same positions form a single set of the position automaton's
+   * alphabet. The transitions are then checked against the set's lowest character only, exactly like
+   * the subset construction does (this keeps both of the automata equivalent).
+   */
+  for (guint character = 0; character < G_N_ELEMENTS (signatures); ++character)
+    {
+      if (signatures[character] == 0)
+        continue;
+
+      gpointer representative = NULL;
+
+      if (!g_hash_table_lookup_extended (representatives, &signatures[character], NULL, &representative))
+        {
+          representative = GUINT_TO_POINTER (character);
+
+          g_hash_table_insert (representatives, &signatures[character], representative);
+        }
+
+      for (guint i = 0; i < positions_count; ++i)
+        if (transition_is_possible (g_ptr_array_index (transitions, i), (gchar) GPOINTER_TO_UINT (representative)))
+          character_masks[character] |= G_GUINT64_CONSTANT (1) << i;
+    }
+
+  AcceptorRunnable *acceptor =
+    ACCEPTORS_ACCEPTOR_RUNNABLE (bit_parallel_nfa_new (PROP_BIT_PARALLEL_NFA_FIRST_POSITIONS, position_automaton_compute_mask (sets->first),
+                                                       PROP_BIT_PARALLEL_NFA_LAST_POSITIONS, position_automaton_compute_mask (sets->last),
+                                                       PROP_BIT_PARALLEL_NFA_NULLABLE, sets->nullable,
+                                                       PROP_BIT_PARALLEL_NFA_FOLLOW_SETS, follow_sets,
+                                                       PROP_BIT_PARALLEL_NFA_CHARACTER_MASKS, character_masks));
+
+  positions_clear (&positions);
+
+  return acceptor;
+}
+
+AcceptorRunnable *
+build_tagged_automaton (AstNode *abstract_syntax_tree)
+{
+  g_return_val_if_fail (AST_NODES_IS_AST_NODE (abstract_syntax_tree), NULL);
+
+  Positions positions;
+
+  positions_init (&positions);
+  positions_track_groups (&positions, abstract_syntax_tree);
+
+  g_autoptr (PositionSets) sets = position_automaton_compute_sets (abstract_syntax_tree,
+                                                                   &positions,
+                                                                   FALSE,
+                                                                   FALSE);
+  g_autoptr (GPtrArray) character_sets = position_automaton_fetch_character_sets (&positions);
+  g_autoptr (GArray) first_edges = g_array_new (FALSE, FALSE, sizeof (TaggedEdge));
+  g_autoptr (GArray) last_edges = g_array_new (FALSE, FALSE, sizeof (TaggedEdge));
+
+  /* Entering a position straight from the initial state opens every group enclosing it, leaving a position
+   * which ends the expression closes every one of them.
+   */
+  for (guint i = 0; i < sets->first->len; ++i)
+    {
+      TaggedEdge edge = position_automaton_define_edge (&positions,
+                                                        -1,
+                                                        g_array_index (sets->first, guint, i),
+                                                        0,
+                                                        g_ptr_array_index (sets->first_skipped_groups, i));
+
+      g_array_append_val (first_edges, edge);
+    }
+
+  for (guint i = 0; i < sets->last->len; ++i)
+    {
+      guint position = g_array_index (sets->last, guint, i);
+      TaggedEdge edge = position_automaton_define_edge (&positions,
+                                                        position,
+                                                        -1,
+                                                        0,
+                                                        g_ptr_array_index (sets->last_skipped_groups, i));
+
+      edge.target = position;
+
+      g_array_append_val (last_edges, edge);
+    }
+
+  /* Matching the empty string skips over the whole expression. */
+  TaggedEdge empty_edge = position_automaton_define_edge (&positions, -1, -1, 0, sets->empty_groups);
+
+  AcceptorRunnable *acceptor =
+    ACCEPTORS_ACCEPTOR_RUNNABLE (tagged_nfa_new (PROP_TAGGED_NFA_NULLABLE, sets->nullable,
+                                                 PROP_TAGGED_NFA_GROUPS_COUNT, g_hash_table_size (positions.group_indices),
+                                                 PROP_TAGGED_NFA_CHARACTER_SETS, character_sets,
+                                                 PROP_TAGGED_NFA_FIRST_EDGES, first_edges,
+                                                 PROP_TAGGED_NFA_FOLLOW_EDGES, positions.follow_edges,
+                                                 PROP_TAGGED_NFA_LAST_EDGES, last_edges,
+                                                 PROP_TAGGED_NFA_EMPTY_EDGE, &empty_edge,
+                                                 PROP_TAGGED_NFA_OPERATIONS, positions.operations));
+
+  positions_clear (&positions);
+
+  return acceptor;
+}
+
+guint
+count_positions (AstNode *abstract_syntax_tree)
+{
+  g_return_val_if_fail (AST_NODES_IS_AST_NODE (abstract_syntax_tree), 0);
+
+  AstNode *node = abstract_syntax_tree;
+  guint positions_count = 0;
+
+  /* Computed without defining any of the positions so that the size of the state machines can be
+   * estimated beforehand. Anchors are always counted (even the redundant ones) which makes the
+   * result an upper bound, it saturates instead of overflowing.
+   */
+  if (AST_NODES_IS_EMPTY (node))
+    {
+      positions_count = 0;
+    }
+  else if (AST_NODES_IS_CONSTANT (node) || AST_NODES_IS_RANGE (node) || AST_NODES_IS_BRACKET_EXPRESSION (node))
+    {
+      g_autoptr (GPtrArray) sequences = position_automaton_fetch_sequences (node);
+
+      positions_count = (sequences != NULL) ? count_utf8_sequences_positions (sequences) : 1;
+    }
+  else if (AST_NODES_IS_ALTERNATION (node) || AST_NODES_IS_CONCATENATION (node))
+    {
+      g_autoptr (AstNode) left_operand = NULL;
+      g_autoptr (AstNode) right_operand = NULL;
+
+      g_object_get (node,
+                    PROP_BINARY_OPERATOR_LEFT_OPERAND, &left_operand,
+                    PROP_BINARY_OPERATOR_RIGHT_OPERAND, &right_operand,
+                    NULL);
+
+      if (!g_uint_checked_add (&positions_count, count_positions (left_operand), count_positions (right_operand)))
+        positions_count = G_MAXUINT;
+    }
+  else if (AST_NODES_IS_QUANTIFICATION (node))
+    {
+      g_autoptr (AstNode) operand = NULL;
+      guint lower_bound = 0;
+      guint upper_bound = 0;
+
+      g_object_get (node,
+                    PROP_UNARY_OPERATOR_OPERAND, &operand,
+                    PROP_QUANTIFICATION_LOWER_BOUND, &lower_bound,
+                    PROP_QUANTIFICATION_UPPER_BOUND, &upper_bound,
+                    NULL);
+
+      guint copies_count = (upper_bound == QUANTIFICATION_BOUND_INFINITY) ? MAX (lower_bound, 1) : upper_bound;
+
+      if (!g_uint_checked_mul (&positions_count, count_positions (operand), copies_count))
+        positions_count = G_MAXUINT;
+    }
+  else if (AST_NODES_IS_ANCHOR (node))
+    {
+      g_autoptr (AstNode) operand = NULL;
+      const guint anchors_count = 2;
+
+      g_object_get (node,
+                    PROP_UNARY_OPERATOR_OPERAND, &operand,
+                    NULL);
+
+      if (!g_uint_checked_add (&positions_count, count_positions (operand), anchors_count))
+        positions_count = G_MAXUINT;
+    }
+  else if (AST_NODES_IS_GROUP (node))
+    {
+      g_autoptr (AstNode) operand = NULL;
+
+      g_object_get (node,
+                    PROP_UNARY_OPERATOR_OPERAND, &operand,
+                    NULL);
+
+      positions_count = count_positions (operand);
+    }
+  else
+    {
+      g_return_val_if_reached (0);
+    }
+
+  return positions_count;
+}
+
+guint
+count_nodes (AstNode *abstract_syntax_tree)
+{
+  g_return_val_if_fail (AST_NODES_IS_AST_NODE (abstract_syntax_tree), 0);
+
+  AstNode *node = abstract_syntax_tree;
+  guint nodes_count = 1;
+
+  if (AST_NODES_IS_BINARY_OPERATOR (node))
+    {
+      g_autoptr (AstNode) left_operand = NULL;
+      g_autoptr (AstNode) right_operand = NULL;
+
+      g_object_get (node,
+                    PROP_BINARY_OPERATOR_LEFT_OPERAND, &left_operand,
+                    PROP_BINARY_OPERATOR_RIGHT_OPERAND, &right_operand,
+                    NULL);
+
+      nodes_count += count_nodes (left_operand) + count_nodes (right_operand);
+    }
+  else if (AST_NODES_IS_UNARY_OPERATOR (node))
+    {
+      g_autoptr (AstNode) operand = NULL;
+
+      g_object_get (node,
+                    PROP_UNARY_OPERATOR_OPERAND, &operand,
+                    NULL);
+
+      nodes_count += count_nodes (operand);
+    }
+
+  return nodes_count;
+}
+
+static void
+positions_init (Positions *positions)
+{
+  positions->characters = g_array_new (FALSE, FALSE, sizeof (gchar));
+  positions->character_sets = g_ptr_array_new_with_free_func ((GDestroyNotify) character_set_free);
+  positions->follow_sets = g_ptr_array_new_with_free_func ((GDestroyNotify) g_hash_table_unref);
+  positions->group_indices = NULL;
+  positions->group_stack = NULL;
+  positions->enclosing_groups = NULL;
+  positions->follow_edges = NULL;
+  positions->operations = NULL;
+}
+
+static void
+positions_clear (Positions *positions)
+{
+  g_array_unref (positions->characters);
+  g_ptr_array_unref (positions->character_sets);
+  g_ptr_array_unref (positions->follow_sets);
+
+  if (positions->group_indices != NULL)
+    {
+      g_hash_table_unref (positions->group_indices);
+      g_array_unref (positions->group_stack);
+      g_ptr_array_unref (positions->enclosing_groups);
+      g_ptr_array_unref (positions->follow_edges);
+      g_array_unref (positions->operations);
+    }
+}
+
+static void
+positions_track_groups (Positions *positions,
+                        AstNode   *abstract_syntax_tree)
+{
+  positions->group_indices = g_hash_table_new (g_direct_hash, g_direct_equal);
+  positions->group_stack = g_array_new (FALSE, FALSE, sizeof (guint));
+  positions->enclosing_groups = g_ptr_array_new_with_free_func ((GDestroyNotify) g_array_unref);
+  positions->follow_edges = g_ptr_array_new_with_free_func ((GDestroyNotify) g_array_unref);
+  positions->operations = g_array_new (FALSE, FALSE, sizeof (guint));
+
+  /* Numbered up front, the groups found in operands repeated zero times are never turned into positions. */
+  position_automaton_number_groups (abstract_syntax_tree, positions->group_indices);
+}
+
+static PositionSets *
+position_sets_new (gboolean nullable)
+{
+  PositionSets *sets = g_new (PositionSets, 1);
+
+  sets->nullable = nullable;
+  sets->first = g_array_new (FALSE, FALSE, sizeof (guint));
+  sets->last = g_array_new (FALSE, FALSE, sizeof (guint));
+  sets->first_skipped_groups = g_ptr_array_new_with_free_func (position_automaton_free_groups);
+  sets->last_skipped_groups = g_ptr_array_new_with_free_func (position_automaton_free_groups);
+  sets->empty_groups = NULL;
+
+  return sets;
+}
+
+static void
+position_sets_free (PositionSets *sets)
+{
+  g_array_unref (sets->first);
+  g_array_unref (sets->last);
+  g_ptr_array_unref (sets->first_skipped_groups);
+  g_ptr_array_unref (sets->last_skipped_groups);
+  position_automaton_free_groups (sets->empty_groups);
+  g_free (sets);
+}
+
+static void
+position_sets_append_first (PositionSets *sets,
+                            PositionSets *source_sets,
+                            GArray       *preceding_groups)
+{
+  g_array_append_vals (sets->first, source_sets->first->data, source_sets->first->len);
+
+  for (guint i = 0; i < source_sets->first->len; ++i)
+    g_ptr_array_add (sets->first_skipped_groups,
+                     position_automaton_join_groups (preceding_groups,
+                                                     g_ptr_array_index (source_sets->first_skipped_groups, i)));
+}
+
+static void
+position_sets_append_last (PositionSets *sets,
+                           PositionSets *source_sets,
+                           GArray       *following_groups)
+{
+  g_array_append_vals (sets->last, source_sets->last->data, source_sets->last->len);
+
+  for (guint i = 0; i < source_sets->last->len; ++i)
+    g_ptr_array_add (sets->last_skipped_groups,
+                     position_automaton_join_groups (g_ptr_array_index (source_sets->last_skipped_groups, i),
+                                                     following_groups));
+}
+
+static PositionSets *
+position_automaton_compute_sets (AstNode   *node,
+                                 Positions *positions,
+                                 gboolean   start_anchors_are_redundant,
+                                 gboolean   end_anchors_are_redundant)
+{
+  if (AST_NODES_IS_EMPTY (node))
+    {
+      return position_sets_new (TRUE);
+    }
+  else if (AST_NODES_IS_CONSTANT (node) || AST_NODES_IS_RANGE (node) || AST_NODES_IS_BRACKET_EXPRESSION (node))
+    {
+      g_autoptr (GPtrArray) sequences = position_automaton_fetch_sequences (node);
+
+      if (sequences != NULL)
+        return position_automaton_compute_sequences (sequences, positions);
+    }
+
+  if (AST_NODES_IS_CONSTANT (node))
+    {
+      gunichar value = 0;
+
+      g_object_get (node,
+                    PROP_CONSTANT_VALUE, &value,
+                    NULL);
+
+      return position_automaton_define_position (positions, (gchar) value, NULL);
+    }
+  else if (AST_NODES_IS_RANGE (node))
+    {
+      return position_automaton_compute_range (node, positions);
+    }
+  else if (AST_NODES_IS_BRACKET_EXPRESSION (node))
+    {
+      CharacterSet *character_set = bracket_expression_fetch_character_set (AST_NODES_BRACKET_EXPRESSION (node));
+
+      return position_automaton_define_position (positions, 0, character_set);
+    }
+  else if (AST_NODES_IS_ALTERNATION (node) || AST_NODES_IS_CONCATENATION (node))
+    {
+      g_autoptr (AstNode) left_operand = NULL;
+      g_autoptr (AstNode) right_operand = NULL;
+
+      g_object_get (node,
+                    PROP_BINARY_OPERATOR_LEFT_OPERAND, &left_operand,
+                    PROP_BINARY_OPERATOR_RIGHT_OPERAND, &right_operand,
+                    NULL);
+
+      g_autoptr (PositionSets) left_sets = position_automaton_compute_sets (left_operand,
+                                                                            positions,
+                                                                            start_anchors_are_redundant,
+                                                                            end_anchors_are_redundant);
+      g_autoptr (PositionSets) right_sets = position_automaton_compute_sets (right_operand,
+                                                                             positions,
+                                                                             start_anchors_are_redundant,
+                                                                             end_anchors_are_redundant);
+
+      if (AST_NODES_IS_ALTERNATION (node))
+        return position_automaton_compute_alternation (left_sets, right_sets);
+      else
+        return position_automaton_compute_concatenation (left_sets, right_sets, positions);
+    }
+  else if (AST_NODES_IS_QUANTIFICATION (node))
+    {
+      g_autoptr (AstNode) operand = NULL;
+      guint lower_bound = 0;
+      guint upper_bound = 0;
+
+      g_object_get (node,
+                    PROP_UNARY_OPERATOR_OPERAND, &operand,
+                    PROP_QUANTIFICATION_LOWER_BOUND, &lower_bound,
+                    PROP_QUANTIFICATION_UPPER_BOUND, &upper_bound,
+                    NULL);
+
+      gboolean is_unbounded = (upper_bound == QUANTIFICATION_BOUND_INFINITY);
+      guint copies_count = is_unbounded ? MAX (lower_bound, 1) : upper_bound;
+      PositionSets *sets = position_sets_new (TRUE);
+
+      /* Each copy of the operand gets its own positions, copies which are not mandatory are
+       * simply made nullable.
+       */
+      for (guint i = 0; i < copies_count; ++i)
+        {
+          g_autoptr (PositionSets) copy_sets = position_automaton_compute_sets (operand,
+                                                                                positions,
+                                                                                start_anchors_are_redundant,
+                                                                                end_anchors_are_redundant);
+
+          if (i >= lower_bound)
+            copy_sets->nullable = TRUE;
+
+          /* Repetition allows each position that ends the last copy to be followed by each position that begins it. */
+          if (is_unbounded && i == copies_count - 1)
+            position_automaton_define_follow (positions, copy_sets, copy_sets);
+
+          PositionSets *concatenated_sets = position_automaton_compute_concatenation (sets, copy_sets, positions);
+
+          position_sets_free (sets);
+          sets = concatenated_sets;
+        }
+
+      return sets;
+    }
+  else if (AST_NODES_IS_ANCHOR (node))
+    {
+      g_autoptr (AstNode) operand = NULL;
+      AnchorType start_type = ANCHOR_TYPE_UNDEFINED;
+      AnchorType end_type = ANCHOR_TYPE_UNDEFINED;
+
+      g_object_get (node,
+                    PROP_UNARY_OPERATOR_OPERAND, &operand,
+                    PROP_ANCHOR_START_TYPE, &start_type,
+                    PROP_ANCHOR_END_TYPE, &end_type,
+                    NULL);
+
+      gboolean start_is_anchored = (start_type == ANCHOR_TYPE_ANCHORED);
+      gboolean end_is_anchored = (end_type == ANCHOR_TYPE_ANCHORED);
+
+      /* Inner anchors are made redundant by the outer ones (the Thompson construction converts
+       * them to epsilon transitions), they are therefore simply not turned into positions.
+       */
+      g_autoptr (PositionSets) sets = position_automaton_compute_sets (operand,
+                                                                       positions,
+                                                                       start_anchors_are_redundant || start_is_anchored,
+                                                                       end_anchors_are_redundant || end_is_anchored);
+
+      if (start_is_anchored && !start_anchors_are_redundant)
+        {
+          g_autoptr (PositionSets) start_sets = position_automaton_define_position (positions, START, NULL);
+          PositionSets *anchored_sets = position_automaton_compute_concatenation (start_sets, sets, positions);
+
+          position_sets_free (sets);
+          sets = anchored_sets;
+        }
+
+      if (end_is_anchored && !end_anchors_are_redundant)
+        {
+          g_autoptr (PositionSets) end_sets = position_automaton_define_position (positions, END, NULL);
+          PositionSets *anchored_sets = position_automaton_compute_concatenation (sets, end_sets, positions);
+
+          position_sets_free (sets);
+          sets = anchored_sets;
+        }
+
+      return g_steal_pointer (&sets);
+    }
+  else if (AST_NODES_IS_GROUP (node))
+    {
+      g_autoptr (AstNode) operand = NULL;
+
+      g_object_get (node,
+                    PROP_UNARY_OPERATOR_OPERAND, &operand,
+                    NULL);
+
+      guint group = 0;
+
+      /* Every copy of a repeated group shares its index, the last iteration is therefore the one being reported. */
+      if (positions->group_indices != NULL)
+        {
+          group = GPOINTER_TO_UINT (g_hash_table_lookup (positions->group_indices, node)) - 1;
+
+          g_array_append_val (positions->group_stack, group);
+        }
+
+      PositionSets *sets = position_automaton_compute_sets (operand,
+                                                            positions,
+                                                            start_anchors_are_redundant,
+                                                            end_anchors_are_redundant);
+
+      if (positions->group_indices != NULL)
+        {
+          g_array_set_size (positions->group_stack, positions->group_stack->len - 1);
+
+          /* The group itself matches the empty string whenever its operand does. */
+          if (sets->nullable)
+            {
+              GArray *empty_groups = g_array_new (FALSE, FALSE, sizeof (guint));
+
+              g_array_append_val (empty_groups, group);
+
+              if (sets->empty_groups != NULL)
+                g_array_append_vals (empty_groups, sets->empty_groups->data, sets->empty_groups->len);
+
+              position_automaton_free_groups (sets->empty_groups);
+              sets->empty_groups = empty_groups;
+            }
+        }
+
+      return sets;
+    }
+
+  g_return_val_if_reached (NULL);
+}
+
+static PositionSets *
+position_automaton_define_position (Positions    *positions,
+                                    gchar         character,
+                                    CharacterSet *character_set)
+{
+  PositionSets *sets = position_sets_new (FALSE);
+  guint position = positions->characters->len;
+
+  /* The character is ignored if a set is given, the set is owned by the positions from now on. */
+  g_array_append_val (positions->characters, character);
+  g_ptr_array_add (positions->character_sets, character_set);
+  g_ptr_array_add (positions->follow_sets, g_hash_table_new (g_direct_hash, g_direct_equal));
+
+  if (positions->group_indices != NULL)
+    {
+      GArray *enclosing_groups = g_array_sized_new (FALSE, FALSE, sizeof (guint), positions->group_stack->len);
+
+      g_array_append_vals (enclosing_groups, positions->group_stack->data, positions->group_stack->len);
+      g_ptr_array_add (positions->enclosing_groups, enclosing_groups);
+      g_ptr_array_add (positions->follow_edges, g_array_new (FALSE, FALSE, sizeof (TaggedEdge)));
+    }
+
+  g_array_append_val (sets->first, position);
+  g_array_append_val (sets->last, position);
+  g_ptr_array_add (sets->first_skipped_groups, NULL);
+  g_ptr_array_add (sets->last_skipped_groups, NULL);
+
+  return sets;
+}
+
+static PositionSets *
+position_automaton_compute_range (AstNode   *node,
+                                  Positions *positions)
+{
+  g_autoptr (AstNode) left_operand = NULL;
+  g_autoptr (AstNode) right_operand = NULL;
+  gunichar lower_value = 0;
+  gunichar upper_value = 0;
+
+  g_object_get (node,
+                PROP_BINARY_OPERATOR_LEFT_OPERAND, &left_operand,
+                PROP_BINARY_OPERATOR_RIGHT_OPERAND, &right_operand,
+                NULL);
+  g_object_get (left_operand,
+                PROP_CONSTANT_VALUE, &lower_value,
+                NULL);
+  g_object_get (right_operand,
+                PROP_CONSTANT_VALUE, &upper_value,
+                NULL);
+
+  /* The whole range is represented by a single position. */
+  CharacterSet *character_set = character_set_new ();
+
+  character_set_add_range (character_set, (gchar) lower_value, (gchar) upper_value);
+
+  return position_automaton_define_position (positions, 0, character_set);
+}
+
+static GPtrArray *
+position_automaton_fetch_sequences (AstNode *node)
+{
+  gunichar lower_value = 0;
+  gunichar upper_value = 0;
+
+  if (AST_NODES_IS_BRACKET_EXPRESSION (node))
+    return bracket_expression_fetch_sequences (AST_NODES_BRACKET_EXPRESSION (node));
+
+  if (AST_NODES_IS_CONSTANT (node))
+    return constant_fetch_sequences (AST_NODES_CONSTANT (node));
+
+  if (AST_NODES_IS_RANGE (node))
+    {
+      g_autoptr (AstNode) left_operand = NULL;
+      g_autoptr (AstNode) right_operand = NULL;
+
+      g_object_get (node,
+                    PROP_BINARY_OPERATOR_LEFT_OPERAND, &left_operand,
+                    PROP_BINARY_OPERATOR_RIGHT_OPERAND, &right_operand,
+                    NULL);
+      g_object_get (left_operand,
+                    PROP_CONSTANT_VALUE, &lower_value,
+                    NULL);
+      g_object_get (right_operand,
+                    PROP_CONSTANT_VALUE, &upper_value,
+                    NULL);
+    }
+
+  /* ASCII characters are consumed by a single position. */
+  if (upper_value <= G_MAXINT8)
+    return NULL;
+
+  return create_utf8_range_sequences (lower_value, upper_value);
+}
+
+static PositionSets *
+position_automaton_compute_sequences (GPtrArray *sequences,
+                                      Positions *positions)
+{
+  g_autoptr (GArray) nodes = create_utf8_sequence_nodes (sequences);
+  g_autoptr (GPtrArray) node_sets = g_ptr_array_new_full (nodes->len, (GDestroyNotify) position_sets_free);
+  PositionSets *sets = position_sets_new (FALSE);
+
+  /* Each node of the sequences is a position, the sequences are entered at their first bytes and left
+   * after their last ones while the rest of the bytes follow each other.
+   */
+  for (guint i = 0; i < nodes->len; ++i)
+    {
+      Utf8SequenceNode *node = &g_array_index (nodes, Utf8SequenceNode, i);
+      PositionSets *byte_sets = position_automaton_define_position (positions, 0, character_set_copy (node->character_set));
+
+      if (node->is_first)
+        position_sets_append_first (sets, byte_sets, NULL);
+
+      if (node->next == -1)
+        position_sets_append_last (sets, byte_sets, NULL);
+
+      g_ptr_array_add (node_sets, byte_sets);
+    }
+
+  for (guint i = 0; i < nodes->len; ++i)
+    {
+      Utf8SequenceNode *node = &g_array_index (nodes, Utf8SequenceNode, i);
+
+      if (node->next != -1)
+        position_automaton_define_follow (positions,
+                                          g_ptr_array_index (node_sets, i),
+                                          g_ptr_array_index (node_sets, node->next));
+    }
+
+  return sets;
+}
+
+static PositionSets *
+position_automaton_compute_alternation (PositionSets *left_sets,
+                                        PositionSets *right_sets)
+{
+  PositionSets *sets = position_sets_new (left_sets->nullable || right_sets->nullable);
+
+  /* Positions of different operands never overlap so no duplicates can be introduced. */
+  position_sets_append_first (sets, left_sets, NULL);
+  position_sets_append_first (sets, right_sets, NULL);
+  position_sets_append_last (sets, left_sets, NULL);
+  position_sets_append_last (sets, right_sets, NULL);
+
+  /* The empty string is matched by the leftmost operand which matches it. */
+  if (left_sets->nullable)
+    sets->empty_groups = position_automaton_join_groups (left_sets->empty_groups, NULL);
+  else if (right_sets->nullable)
+    sets->empty_groups = position_automaton_join_groups (right_sets->empty_groups, NULL);
+
+  return sets;
+}
+
+static PositionSets *
+position_automaton_compute_concatenation (PositionSets *left_sets,
+                                          PositionSets *right_sets,
+                                          Positions    *positions)
+{
+  PositionSets *sets = position_sets_new (left_sets->nullable && right_sets->nullable);
+
+  position_automaton_define_follow (positions, left_sets, right_sets);
+
+  /* Skipping over a nullable operand skips over its groups as well. */
+  position_sets_append_first (sets, left_sets, NULL);
+
+  if (left_sets->nullable)
+    position_sets_append_first (sets, right_sets, left_sets->empty_groups);
+
+  if (right_sets->nullable)
+    position_sets_append_last (sets, left_sets, right_sets->empty_groups);
+
+  position_sets_append_last (sets, right_sets, NULL);
+
+  if (sets->nullable)
+    sets->empty_groups = position_automaton_join_groups (left_sets->empty_groups, right_sets->empty_groups);
+
+  return sets;
+}
+
+static void
+position_automaton_define_follow (Positions    *positions,
+                                  PositionSets *from_sets,
+                                  PositionSets *to_sets)
+{
+  for (guint i = 0; i < from_sets->last->len; ++i)
+    {
+      guint from_position = g_array_index (from_sets->last, guint, i);
+      GHashTable *follow_set = g_ptr_array_index (positions->follow_sets, from_position);
+
+      /* Offsetting the positions by one so as not to store NULL pointers as keys. */
+      for (guint j = 0; j < to_sets->first->len; ++j)
+        {
+          guint to_position = g_array_index (to_sets->first, guint, j);
+          gboolean is_new = g_hash_table_add (follow_set, GUINT_TO_POINTER (to_position + 1));
+
+          /* The edges are kept in the order of their definition (the earlier ones take precedence) and
+           * only the groups found below the current node are closed or opened by them.
+           */
+          if (is_new && positions->follow_edges != NULL)
+            {
+              g_autoptr (GArray) skipped_groups =
+                position_automaton_join_groups (g_ptr_array_index (from_sets->last_skipped_groups, i),
+                                                g_ptr_array_index (to_sets->first_skipped_groups, j));
+              TaggedEdge edge = position_automaton_define_edge (positions,
+                                                                (gint) from_position,
+                                                                (gint) to_position,
+                                                                positions->group_stack->len,
+                                                                skipped_groups);
+
+              g_array_append_val (g_ptr_array_index (positions->follow_edges, from_position), edge);
+            }
+        }
+    }
+}
+
+static void
+position_automaton_number_groups (AstNode    *node,
+                                  GHashTable *group_indices)
+{
+  /* Groups are numbered by their opening parentheses, from left to right (starting with one so as
+   * not to store NULL pointers as values).
+   */
+  if (AST_NODES_IS_GROUP (node) && !g_hash_table_contains (group_indices, node))
+    g_hash_table_insert (group_indices, node, GUINT_TO_POINTER (g_hash_table_size (group_indices) + 1));
+
+  if (AST_NODES_IS_UNARY_OPERATOR (node))
+    {
+      g_autoptr (AstNode) operand = NULL;
+
+      g_object_get (node,
+                    PROP_UNARY_OPERATOR_OPERAND, &operand,
+                    NULL);
+
+      position_automaton_number_groups (operand, group_indices);
+    }
+  else if (AST_NODES_IS_BINARY_OPERATOR (node))
+    {
+      g_autoptr (AstNode) left_operand = NULL;
+      g_autoptr (AstNode) right_operand = NULL;
+
+      g_object_get (node,
+                    PROP_BINARY_OPERATOR_LEFT_OPERAND, &left_operand,
+                    PROP_BINARY_OPERATOR_RIGHT_OPERAND, &right_operand,
+                    NULL);
+
+      position_automaton_number_groups (left_operand, group_indices);
+      position_automaton_number_groups (right_operand, group_indices);
+    }
+}
+
+static TaggedEdge
+position_automaton_define_edge (Positions *positions,
+                                gint       from_position,
+                                gint       to_position,
+                                guint      depth,
+                                GArray    *skipped_groups)
+{
+  TaggedEdge edge = { 0 };
+
+  edge.target = (guint) MAX (to_position, 0);
+  edge.operations_begin = positions->operations->len;
+
+  /* Groups enclosing the position being left are closed from the innermost one outwards. */
+  if (from_position >= 0)
+    {
+      GArray *enclosing_groups = g_ptr_array_index (positions->enclosing_groups, from_position);
+
+      for (guint i = enclosing_groups->len; i > depth; --i)
+        {
+          guint tag = TAGGED_NFA_CLOSING_TAG (g_array_index (enclosing_groups, guint, i - 1));
+
+          g_array_append_val (positions->operations, tag);
+        }
+    }
+
+  /* Groups skipped over in between the two positions match the empty string (the tags of a group are set
+   * to the same offset as the other ones, the order of the operations is therefore irrelevant).
+   */
+  for (guint i = 0; skipped_groups != NULL && i < skipped_groups->len; ++i)
+    {
+      guint group = g_array_index (skipped_groups, guint, i);
+      guint opening_tag = TAGGED_NFA_OPENING_TAG (group);
+      guint closing_tag = TAGGED_NFA_CLOSING_TAG (group);
+
+      g_array_append_val (positions->operations, opening_tag);
+      g_array_append_val (positions->operations, closing_tag);
+    }
+
+  /* Groups enclosing the position being entered are opened from the outermost one inwards. */
+  if (to_position >= 0)
+    {
+      GArray *enclosing_groups = g_ptr_array_index (positions->enclosing_groups, to_position);
+
+      for (guint i = depth; i < enclosing_groups->len; ++i)
+        {
+          guint tag = TAGGED_NFA_OPENING_TAG (g_array_index (enclosing_groups, guint, i));
+
+          g_array_append_val (positions->operations, tag);
+        }
+    }
+
+  edge.operations_end = positions->operations->len;
+
+  return edge;
+}
+
+static GArray *
+position_automaton_join_groups (GArray *left_groups,
+                                GArray *right_groups)
+{
+  guint left_groups_count = (left_groups != NULL) ? left_groups->len : 0;
+  guint right_groups_count = (right_groups != NULL) ? right_groups->len : 0;
+
+  /* Most of the positions do not skip any groups, nothing is allocated for them. */
+  if (left_groups_count + right_groups_count == 0)
+    return NULL;
+
+  GArray *groups = g_array_sized_new (FALSE, FALSE, sizeof (guint), left_groups_count + right_groups_count);
+
+  if (left_groups_count > 0)
+    g_array_append_vals (groups, left_groups->data, left_groups_count);
+
+  if (right_groups_count > 0)
+    g_array_append_vals (groups, right_groups->data, right_groups_count);
+
+  return groups;
+}
+
+static void
+position_automaton_free_groups (gpointer groups)
+{
+  if (groups != NULL)
+    g_array_unref (groups);
+}
+
+static GPtrArray *
+position_automaton_fetch_character_sets (Positions *positions)
+{
+  guint positions_count = positions->characters->len;
+  gsize signature_size = positions_count / 8 + 1;
+  g_autofree guint8 *signature = g_new (guint8, signature_size);
+  g_autoptr (State) scratch_state = state_new (PROP_STATE_TYPE_FLAGS, STATE_TYPE_DEFAULT);
+  g_autoptr (GPtrArray) transitions = g_ptr_array_new_with_free_func (g_object_unref);
+  g_autoptr (GPtrArray) expected_characters = g_ptr_array_new_with_free_func ((GDestroyNotify) character_set_free);
+  g_autoptr (GHashTable) representatives = g_hash_table_new_full (g_bytes_hash,
+                                                                  g_bytes_equal,
+                                                                  (GDestroyNotify) g_bytes_unref,
+                                                                  NULL);
+  GPtrArray *character_sets = g_ptr_array_new_with_free_func ((GDestroyNotify) character_set_free);
+
+  for (guint i = 0; i < positions_count; ++i)
+    {
+      Transition *transition = position_automaton_create_transition (positions, i, scratch_state);
+
+      g_ptr_array_add (transitions, transition);
+      g_ptr_array_add (expected_characters, transition_fetch_expected_characters (transition));
+      g_ptr_array_add (character_sets, character_set_new ());
+    }
+
+  /* Exactly like in the case of the bit-parallel simulation, characters expected by the same positions
+   * form a single set of the alphabet and the transitions are checked against its lowest character only.
+   */
+  for (guint character = 0; character <= G_MAXUINT8; ++character)
+    {
+      gboolean is_expected = FALSE;
+
+      memset (signature, 0, signature_size);
+
+      for (guint i = 0; i < positions_count; ++i)
+        {
+          if (character_set_contains (g_ptr_array_index (expected_characters, i), (gchar) character))
+            {
+              signature[i / 8] |= 1 << (i % 8);
+              is_expected = TRUE;
+            }
+        }
+
+      if (!is_expected)
+        continue;
+
+      GBytes *key = g_bytes_new (signature, signature_size);
+      gpointer representative = NULL;
+
+      if (!g_hash_table_lookup_extended (representatives, key, NULL, &representative))
+        {
+          representative = GUINT_TO_POINTER (character);
+
+          g_hash_table_insert (representatives, g_bytes_ref (key), representative);
+        }
+
+      g_bytes_unref (key);
+
+      for (guint i = 0; i < positions_count; ++i)
+        if (transition_is_possible (g_ptr_array_index (transitions, i), (gchar) GPOINTER_TO_UINT (representative)))
+          character_set_add (g_ptr_array_index (character_sets, i), (gchar) character);
+    }
+
+  return character_sets;
+}
+
+static FsmConvertible *
+position_automaton_assemble (Positions    *positions,
+                             gboolean      nullable,
+                             GArray       *initial_positions,
+                             GArray       *final_positions,
+                             GPtrArray    *follow_sets,
+                             CharacterSet *looping_characters)
+{
+  g_autoptr (GPtrArray) all_states = g_ptr_array_new_with_free_func (g_object_unref);
+  g_autoptr (GPtrArray) position_states = g_ptr_array_new ();
+  g_autoptr (GHashTable) initial_positions_set = g_hash_table_new (g_direct_hash, g_direct_equal);
+  g_autoptr (GHashTable) final_positions_set = g_hash_table_new (g_direct_hash, g_direct_equal);
+  StateTypeFlags start_type_flags = STATE_TYPE_START;
+
+  /* The empty string is accepted by the initial state itself. */
+  if (nullable)
+    start_type_flags |= STATE_TYPE_FINAL;
+
+  State *start = state_new (PROP_STATE_TYPE_FLAGS, start_type_flags);
+
+  g_ptr_array_add (all_states, start);
+
+  for (guint i = 0; i < initial_positions->len; ++i)
+    g_hash_table_add (initial_positions_set,
+                      GUINT_TO_POINTER (g_array_index (initial_positions, guint, i) + 1));
+
+  for (guint i = 0; i < final_positions->len; ++i)
+    g_hash_table_add (final_positions_set,
+                      GUINT_TO_POINTER (g_array_index (final_positions, guint, i) + 1));
+
+  /* Exactly one state per position is needed, a position state is final only if the position
+   * can end the expression.
+   */
+  for (guint i = 0; i < positions->characters->len; ++i)
+    {
+      StateTypeFlags state_type_flags = STATE_TYPE_DEFAULT;
+
+      if (g_hash_table_contains (final_positions_set, GUINT_TO_POINTER (i + 1)))
+        state_type_flags = STATE_TYPE_FINAL;
+
+      State *position_state = state_new (PROP_STATE_TYPE_FLAGS, state_type_flags);
+
+      g_ptr_array_add (all_states, position_state);
+      g_ptr_array_add (position_states, position_state);
+    }
+
+  position_automaton_define_transitions (start,
+                                         initial_positions_set,
+                                         position_states,
+                                         positions,
+                                         looping_characters);
+
+  for (guint i = 0; i < position_states->len; ++i)
+    position_automaton_define_transitions (g_ptr_array_index (position_states, i),
+                                           g_ptr_array_index (follow_sets, i),
+                                           position_states,
+                                           positions,
+                                           NULL);
+
+  return nfa_new (PROP_FSM_INITIALIZABLE_ALL_STATES, all_states);
+}
+
+static GPtrArray *
+position_automaton_reverse_follow_sets (Positions *positions)
+{
+  guint positions_count = positions->follow_sets->len;
+  GPtrArray *reversed_follow_sets = g_ptr_array_new_with_free_func ((GDestroyNotify) g_hash_table_unref);
+
+  for (guint i = 0; i < positions_count; ++i)
+    g_ptr_array_add (reversed_follow_sets, g_hash_table_new (g_direct_hash, g_direct_equal));
+
+  /* A position follows another one in the reversed expression only if it precedes it in the original one. */
+  for (guint i = 0; i < positions_count; ++i)
+    {
+      GHashTable *follow_set = g_ptr_array_index (positions->follow_sets, i);
+      GHashTableIter iterator;
+      gpointer key = NULL;
+
+      g_hash_table_iter_init (&iterator, follow_set);
+
+      while (g_hash_table_iter_next (&iterator, &key, NULL))
+        g_hash_table_add (g_ptr_array_index (reversed_follow_sets, GPOINTER_TO_UINT (key) - 1),
+                          GUINT_TO_POINTER (i + 1));
+    }
+
+  return reversed_follow_sets;
+}
+
+static void
+position_automaton_define_transitions (State        *state,
+                                       GHashTable   *output_positions,
+                                       GPtrArray    *position_states,
+                                       Positions    *positions,
+                                       CharacterSet *looping_characters)
+{
+  if (!g_collection_has_items (output_positions) && looping_characters == NULL)
+    return;
+
+  g_autoptr (GPtrArray) transitions = g_ptr_array_new_with_free_func (g_object_unref);
+
+  if (looping_characters != NULL)
+    g_ptr_array_add (transitions, create_deterministic_set_transition (looping_characters, state));
+
+  /* Iterating over the positions in order (instead of over the hash table) keeps the resulting
+   * state machine independent of the hashing function.
+   */
+  for (guint i = 0; i < position_states->len; ++i)
+    {
+      if (g_hash_table_contains (output_positions, GUINT_TO_POINTER (i + 1)))
+        {
+          State *output_state = g_ptr_array_index (position_states, i);
+          Transition *transition = position_automaton_create_transition (positions, i, output_state);
+
+          g_ptr_array_add (transitions, transition);
+        }
+    }
+
+  g_object_set (state,
+                PROP_STATE_TRANSITIONS, transitions,
+                NULL);
+}
+
+static Transition *
+position_automaton_create_transition (Positions *positions,
+                                      guint      position,
+                                      State     *output_state)
+{
+  CharacterSet *character_set = g_ptr_array_index (positions->character_sets, position);
+
+  if (character_set != NULL)
+    return create_deterministic_set_transition (character_set, output_state);
+  else
+    return create_deterministic_transition (g_array_index (positions->characters, gchar, position),
+                                            output_state);
+}
+
+static guint64
+position_automaton_compute_mask (GArray *positions_array)
+{
+  guint64 mask = 0;
+
+  for (guint i = 0; i < positions_array->len; ++i)
+    mask |= G_GUINT64_CONSTANT (1) << g_array_index (positions_array, guint, i);
+
+  return mask;
+}
+
+static guint64
+position_automaton_compute_follow_mask (GHashTable *follow_set)
+{
+  GHashTableIter iterator;
+  gpointer key = NULL;
+  guint64 mask = 0;
+
+  /* The positions stored in the follow sets are offset by one. */
+  g_hash_table_iter_init (&iterator, follow_set);
+
+  while (g_hash_table_iter_next (&iterator, &key, NULL))
+    mask |= G_GUINT64_CONSTANT (1) << (GPOINTER_TO_UINT (key) - 1);
+
+  return mask;
+}
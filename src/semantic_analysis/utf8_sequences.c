@@ -0,0 +1,414 @@
+#include "internal/semantic_analysis/utf8_sequences.h"
+#include "internal/state_machines/acceptors/epsilon_nfa.h"
+#include "internal/state_machines/fsm_initializable.h"
+#include "internal/state_machines/transitions/transition_factory.h"
+#include "internal/common/helpers.h"
+
+#define UTF8_MAX_LENGTH      4
+#define UTF8_MAX_CODE_POINT  0x10FFFF
+#define UTF8_SURROGATE_LOWER 0xD800
+#define UTF8_SURROGATE_UPPER 0xDFFF
+
+static GArray    *utf8_sequences_normalize_ranges (GArray               *code_point_ranges,
+                                                   gboolean              complemented);
+
+static gint       utf8_sequences_compare_ranges   (gconstpointer         a,
+                                                   gconstpointer         b);
+
+static GArray    *utf8_sequences_subtract_range   (GArray               *ranges,
+                                                   gunichar              lower,
+                                                   gunichar              upper);
+
+static void       utf8_sequences_append_range     (GArray               *ranges,
+                                                   gunichar              lower,
+                                                   gunichar              upper);
+
+static gboolean   utf8_sequences_split_range      (const CodePointRange *range,
+                                                   GArray               *pending_ranges);
+
+static gboolean   utf8_sequences_push_halves      (const CodePointRange *range,
+                                                   gunichar              middle,
+                                                   GArray               *pending_ranges);
+
+static GPtrArray *utf8_sequences_encode_range     (const CodePointRange *range);
+
+static gint       utf8_sequences_share_node       (GArray               *nodes,
+                                                   const CharacterSet   *character_set,
+                                                   gint                  next,
+                                                   gboolean              is_first);
+
+static void       utf8_sequences_clear_node       (gpointer              node);
+
+GPtrArray *
+create_utf8_sequences (GArray   *code_point_ranges,
+                       gboolean  complemented)
+{
+  g_return_val_if_fail (code_point_ranges != NULL, NULL);
+
+  g_autoptr (GArray) ranges = utf8_sequences_normalize_ranges (code_point_ranges, complemented);
+  g_autoptr (GArray) pending_ranges = g_array_new (FALSE, FALSE, sizeof (CodePointRange));
+  g_autoptr (CharacterSet) ascii_characters = character_set_new ();
+  GPtrArray *sequences = g_ptr_array_new_with_free_func ((GDestroyNotify) g_ptr_array_unref);
+
+  /* Pushed in reverse so that the sequences come out sorted. */
+  for (guint i = ranges->len; i > 0; --i)
+    g_array_append_val (pending_ranges, g_array_index (ranges, CodePointRange, i - 1));
+
+  /* Ranges are split until the bytes of their bounds only differ in a way which can be described by
+   * contiguous ranges of bytes - each one of the pieces then becomes a sequence of its own.
+   */
+  while (pending_ranges->len > 0)
+    {
+      CodePointRange range = g_array_index (pending_ranges, CodePointRange, pending_ranges->len - 1);
+
+      g_array_set_size (pending_ranges, pending_ranges->len - 1);
+
+      if (utf8_sequences_split_range (&range, pending_ranges))
+        continue;
+
+      if (range.upper <= G_MAXINT8)
+        character_set_add_range (ascii_characters, (gchar) range.lower, (gchar) range.upper);
+      else
+        g_ptr_array_add (sequences, utf8_sequences_encode_range (&range));
+    }
+
+  if (!character_set_is_empty (ascii_characters))
+    {
+      GPtrArray *ascii_sequence = g_ptr_array_new_with_free_func ((GDestroyNotify) character_set_free);
+
+      g_ptr_array_add (ascii_sequence, g_steal_pointer (&ascii_characters));
+      g_ptr_array_insert (sequences, 0, ascii_sequence);
+    }
+
+  return sequences;
+}
+
+GPtrArray *
+create_utf8_range_sequences (gunichar lower,
+                             gunichar upper)
+{
+  g_autoptr (GArray) code_point_ranges = g_array_new (FALSE, FALSE, sizeof (CodePointRange));
+
+  utf8_sequences_append_range (code_point_ranges, lower, upper);
+
+  return create_utf8_sequences (code_point_ranges, FALSE);
+}
+
+GPtrArray *
+create_utf8_any_sequences (void)
+{
+  g_autoptr (GArray) code_point_ranges = g_array_new (FALSE, FALSE, sizeof (CodePointRange));
+
+  /* The complement of nothing at all. */
+  return create_utf8_sequences (code_point_ranges, TRUE);
+}
+
+GArray *
+create_utf8_sequence_nodes (GPtrArray *sequences)
+{
+  g_return_val_if_fail (sequences != NULL, NULL);
+
+  g_autoptr (GArray) reversed_nodes = g_array_new (FALSE, FALSE, sizeof (Utf8SequenceNode));
+  GArray *nodes = g_array_sized_new (FALSE, FALSE, sizeof (Utf8SequenceNode), sequences->len);
+
+  g_array_set_clear_func (nodes, utf8_sequences_clear_node);
+
+  /* Each sequence is walked from its last byte to its first one, a node following another one
+   * is therefore always defined first.
+   */
+  for (guint i = 0; i < sequences->len; ++i)
+    {
+      GPtrArray *sequence = g_ptr_array_index (sequences, i);
+      gint next = -1;
+
+      for (guint j = sequence->len; j > 0; --j)
+        next = utf8_sequences_share_node (reversed_nodes, g_ptr_array_index (sequence, j - 1), next, j == 1);
+    }
+
+  for (guint i = reversed_nodes->len; i > 0; --i)
+    {
+      Utf8SequenceNode node = g_array_index (reversed_nodes, Utf8SequenceNode, i - 1);
+
+      if (node.next != -1)
+        node.next = (gint) reversed_nodes->len - 1 - node.next;
+
+      g_array_append_val (nodes, node);
+    }
+
+  return nodes;
+}
+
+FsmConvertible *
+build_utf8_sequences_acceptor (GPtrArray *sequences)
+{
+  g_return_val_if_fail (sequences != NULL, NULL);
+
+  g_autoptr (GArray) nodes = create_utf8_sequence_nodes (sequences);
+  g_autoptr (GPtrArray) all_states = g_ptr_array_new_with_free_func (g_object_unref);
+  g_autoptr (GPtrArray) node_states = g_ptr_array_sized_new (nodes->len);
+  State *start = state_new (PROP_STATE_TYPE_FLAGS, STATE_TYPE_START);
+  State *final = state_new (PROP_STATE_TYPE_FLAGS, STATE_TYPE_FINAL);
+  g_autoptr (GPtrArray) start_transitions = g_ptr_array_new_with_free_func (g_object_unref);
+  g_autoptr (GPtrArray) start_output_states = g_ptr_array_new ();
+
+  g_ptr_array_add_multiple (all_states,
+                            start, final,
+                            NULL);
+
+  for (guint i = 0; i < nodes->len; ++i)
+    {
+      State *node_state = state_new (PROP_STATE_TYPE_FLAGS, STATE_TYPE_DEFAULT);
+
+      g_ptr_array_add (node_states, node_state);
+      g_ptr_array_add (all_states, node_state);
+    }
+
+  /* Each node is a state which consumes a single byte, the last bytes of the sequences lead straight
+   * to the final state while the first ones are entered from the start state.
+   */
+  for (guint i = 0; i < nodes->len; ++i)
+    {
+      Utf8SequenceNode *node = &g_array_index (nodes, Utf8SequenceNode, i);
+      State *current = g_ptr_array_index (node_states, i);
+      State *next = (node->next != -1) ? g_ptr_array_index (node_states, node->next) : final;
+      g_autoptr (GPtrArray) current_transitions = g_ptr_array_new_with_free_func (g_object_unref);
+      Transition *current_on_byte = create_deterministic_set_transition (node->character_set, next);
+
+      g_ptr_array_add (current_transitions, current_on_byte);
+      g_object_set (current,
+                    PROP_STATE_TRANSITIONS, current_transitions,
+                    NULL);
+
+      if (node->is_first)
+        g_ptr_array_add (start_output_states, current);
+    }
+
+  Transition *start_on_epsilon = create_nondeterministic_transition (EPSILON, start_output_states);
+
+  g_ptr_array_add (start_transitions, start_on_epsilon);
+  g_object_set (start,
+                PROP_STATE_TRANSITIONS, start_transitions,
+                NULL);
+
+  return epsilon_nfa_new (PROP_FSM_INITIALIZABLE_ALL_STATES, all_states);
+}
+
+guint
+count_utf8_sequences_positions (GPtrArray *sequences)
+{
+  g_return_val_if_fail (sequences != NULL, 0);
+
+  g_autoptr (GArray) nodes = create_utf8_sequence_nodes (sequences);
+
+  return nodes->len;
+}
+
+static GArray *
+utf8_sequences_normalize_ranges (GArray   *code_point_ranges,
+                                 gboolean  complemented)
+{
+  g_autoptr (GArray) sorted_ranges = g_array_sized_new (FALSE, FALSE, sizeof (CodePointRange), code_point_ranges->len);
+  GArray *ranges = g_array_new (FALSE, FALSE, sizeof (CodePointRange));
+
+  g_array_append_vals (sorted_ranges, code_point_ranges->data, code_point_ranges->len);
+  g_array_sort (sorted_ranges, utf8_sequences_compare_ranges);
+
+  /* Overlapping and adjacent ranges are merged. */
+  for (guint i = 0; i < sorted_ranges->len; ++i)
+    {
+      CodePointRange range = g_array_index (sorted_ranges, CodePointRange, i);
+      CodePointRange *previous = (ranges->len > 0) ? &g_array_index (ranges, CodePointRange, ranges->len - 1) : NULL;
+
+      if (previous != NULL && range.lower <= previous->upper + 1)
+        previous->upper = MAX (previous->upper, range.upper);
+      else
+        g_array_append_val (ranges, range);
+    }
+
+  if (complemented)
+    {
+      GArray *complement = g_array_new (FALSE, FALSE, sizeof (CodePointRange));
+      gunichar lower = EPSILON + 1;
+
+      for (guint i = 0; i < ranges->len; ++i)
+        {
+          CodePointRange range = g_array_index (ranges, CodePointRange, i);
+
+          if (range.lower > lower)
+            utf8_sequences_append_range (complement, lower, range.lower - 1);
+
+          lower = MAX (lower, range.upper + 1);
+        }
+
+      if (lower <= UTF8_MAX_CODE_POINT)
+        utf8_sequences_append_range (complement, lower, UTF8_MAX_CODE_POINT);
+
+      g_array_unref (ranges);
+      ranges = utf8_sequences_subtract_range (complement, START, END);
+    }
+
+  /* Surrogates are not characters, they can only be found inside of a range which spans them. */
+  return utf8_sequences_subtract_range (ranges, UTF8_SURROGATE_LOWER, UTF8_SURROGATE_UPPER);
+}
+
+static gint
+utf8_sequences_compare_ranges (gconstpointer a,
+                               gconstpointer b)
+{
+  const CodePointRange *left_range = a;
+  const CodePointRange *right_range = b;
+
+  if (left_range->lower != right_range->lower)
+    return (left_range->lower < right_range->lower) ? -1 : 1;
+
+  return 0;
+}
+
+static GArray *
+utf8_sequences_subtract_range (GArray   *ranges,
+                               gunichar  lower,
+                               gunichar  upper)
+{
+  GArray *remaining_ranges = g_array_sized_new (FALSE, FALSE, sizeof (CodePointRange), ranges->len + 1);
+
+  /* The given ranges are consumed. */
+  for (guint i = 0; i < ranges->len; ++i)
+    {
+      CodePointRange range = g_array_index (ranges, CodePointRange, i);
+
+      if (range.upper < lower || range.lower > upper)
+        {
+          g_array_append_val (remaining_ranges, range);
+
+          continue;
+        }
+
+      if (range.lower < lower)
+        utf8_sequences_append_range (remaining_ranges, range.lower, lower - 1);
+
+      if (range.upper > upper)
+        utf8_sequences_append_range (remaining_ranges, upper + 1, range.upper);
+    }
+
+  g_array_unref (ranges);
+
+  return remaining_ranges;
+}
+
+static void
+utf8_sequences_append_range (GArray   *ranges,
+                             gunichar  lower,
+                             gunichar  upper)
+{
+  CodePointRange range = { lower, upper };
+
+  g_array_append_val (ranges, range);
+}
+
+static gboolean
+utf8_sequences_split_range (const CodePointRange *range,
+                            GArray               *pending_ranges)
+{
+  const gunichar length_limits[] = { 0x7F, 0x7FF, 0xFFFF };
+
+  /* Both of the bounds have to be encoded using the same number of bytes. */
+  for (guint i = 0; i < G_N_ELEMENTS (length_limits); ++i)
+    if (range->lower <= length_limits[i] && length_limits[i] < range->upper)
+      return utf8_sequences_push_halves (range, length_limits[i], pending_ranges);
+
+  if (range->upper <= G_MAXINT8)
+    return FALSE;
+
+  /* Each continuation byte carries six bits of the code point. Once the bounds differ in a byte, every
+   * continuation byte following it has to span all of its values (otherwise the sequence would also
+   * cover the characters in between which are not a part of the range).
+   */
+  for (guint i = 1; i < UTF8_MAX_LENGTH; ++i)
+    {
+      gunichar mask = (1u << (6 * i)) - 1;
+
+      if ((range->lower & ~mask) == (range->upper & ~mask))
+        continue;
+
+      if ((range->lower & mask) != 0)
+        return utf8_sequences_push_halves (range, range->lower | mask, pending_ranges);
+
+      if ((range->upper & mask) != mask)
+        return utf8_sequences_push_halves (range, (range->upper & ~mask) - 1, pending_ranges);
+    }
+
+  return FALSE;
+}
+
+static gboolean
+utf8_sequences_push_halves (const CodePointRange *range,
+                            gunichar              middle,
+                            GArray               *pending_ranges)
+{
+  /* The lower half is pushed last so that it is the first one to be popped. */
+  utf8_sequences_append_range (pending_ranges, middle + 1, range->upper);
+  utf8_sequences_append_range (pending_ranges, range->lower, middle);
+
+  return TRUE;
+}
+
+static GPtrArray *
+utf8_sequences_encode_range (const CodePointRange *range)
+{
+  gchar lower_bytes[UTF8_MAX_LENGTH] = { 0 };
+  gchar upper_bytes[UTF8_MAX_LENGTH] = { 0 };
+  gint length = g_unichar_to_utf8 (range->lower, lower_bytes);
+  GPtrArray *sequence = g_ptr_array_new_with_free_func ((GDestroyNotify) character_set_free);
+
+  g_unichar_to_utf8 (range->upper, upper_bytes);
+
+  for (gint i = 0; i < length; ++i)
+    {
+      CharacterSet *byte_values = character_set_new ();
+
+      character_set_add_range (byte_values, lower_bytes[i], upper_bytes[i]);
+      g_ptr_array_add (sequence, byte_values);
+    }
+
+  return sequence;
+}
+
+static gint
+utf8_sequences_share_node (GArray             *nodes,
+                           const CharacterSet *character_set,
+                           gint                next,
+                           gboolean            is_first)
+{
+  /* A byte shares the node consuming the same characters and followed by the same node, the characters
+   * of the first bytes are added up instead since nothing precedes them.
+   */
+  for (guint i = 0; i < nodes->len; ++i)
+    {
+      Utf8SequenceNode *node = &g_array_index (nodes, Utf8SequenceNode, i);
+
+      if (node->next != next || node->is_first != is_first)
+        continue;
+
+      if (is_first)
+        {
+          character_set_add_set (node->character_set, character_set);
+
+          return (gint) i;
+        }
+
+      if (character_set_equal (node->character_set, character_set))
+        return (gint) i;
+    }
+
+  Utf8SequenceNode node = { character_set_copy (character_set), next, is_first };
+
+  g_array_append_val (nodes, node);
+
+  return (gint) nodes->len - 1;
+}
+
+static void
+utf8_sequences_clear_node (gpointer node)
+{
+  g_clear_pointer (&((Utf8SequenceNode *) node)->character_set, character_set_free);
+}
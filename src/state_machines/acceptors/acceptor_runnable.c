@@ -1,7 +1,9 @@
 #include "internal/state_machines/acceptors/acceptor_runnable.h"
-#include "internal/state_machines/fsm_initializable.h"
 
-G_DEFINE_INTERFACE (AcceptorRunnable, acceptor_runnable, STATE_MACHINES_TYPE_FSM_INITIALIZABLE)
+#include <string.h>
+
+/* Acceptors are not required to consist of state objects (e.g. the bit-parallel NFA). */
+G_DEFINE_INTERFACE (AcceptorRunnable, acceptor_runnable, G_TYPE_OBJECT)
 
 static void
 acceptor_runnable_default_init (AcceptorRunnableInterface *iface)
@@ -11,7 +13,8 @@ acceptor_runnable_default_init (AcceptorRunnableInterface *iface)
 
 GPtrArray *
 acceptor_runnable_run (AcceptorRunnable *self,
-                       const gchar      *input)
+                       const gchar      *input,
+                       MatchCounters    *counters)
 {
   AcceptorRunnableInterface *iface;
 
@@ -21,7 +24,7 @@ acceptor_runnable_run (AcceptorRunnable *self,
 
   g_return_val_if_fail (iface->run != NULL, NULL);
 
-  iface->run (self, input);
+  return iface->run (self, input, counters);
 }
 
 gboolean
@@ -37,3 +40,62 @@ acceptor_runnable_can_accept (AcceptorRunnable *self)
 
   return iface->can_accept (self);
 }
+
+void
+acceptor_runnable_measure (AcceptorRunnable *self,
+                           AutomatonStats   *stats)
+{
+  AcceptorRunnableInterface *iface;
+
+  g_return_if_fail (ACCEPTORS_IS_ACCEPTOR_RUNNABLE (self));
+  g_return_if_fail (stats != NULL);
+
+  iface = ACCEPTORS_ACCEPTOR_RUNNABLE_GET_IFACE (self);
+
+  g_return_if_fail (iface->measure != NULL);
+
+  memset (stats, 0, sizeof (AutomatonStats));
+
+  iface->measure (self, stats);
+}
+
+GString *
+acceptor_runnable_input_copy (const gchar *input,
+                              guint        begin,
+                              guint        end)
+{
+  g_return_val_if_fail (input != NULL, NULL);
+  g_return_val_if_fail (begin <= end, NULL);
+
+  GString *copy = g_string_sized_new (end - begin);
+
+  for (guint index = begin; index < end; ++index)
+    g_string_append_c (copy, acceptor_runnable_input_at (input, index));
+
+  return copy;
+}
+
+guint
+acceptor_runnable_input_find (const gchar *input,
+                              guint        index,
+                              gchar        character)
+{
+  g_return_val_if_fail (input != NULL, G_MAXUINT);
+  g_return_val_if_fail (character != END_OF_STRING, G_MAXUINT);
+
+  if (index == 0)
+    {
+      if (character == START)
+        return 0;
+
+      index = 1;
+    }
+
+  /* Already past the end of text character. */
+  if (index > 1 && input[index - 2] == END_OF_STRING)
+    return G_MAXUINT;
+
+  const gchar *occurrence = strchr (input + index - 1, character);
+
+  return (occurrence != NULL) ? (guint) (occurrence - input) + 1 : G_MAXUINT;
+}
@@ -0,0 +1,517 @@
+#include "internal/state_machines/acceptors/bit_parallel_nfa.h"
+#include "internal/state_machines/acceptors/acceptor_runnable.h"
+#include "internal/state_machines/transitions/transition.h"
+#include "internal/common/helpers.h"
+#include "core/match.h"
+
+#include <string.h>
+
+#define BIT_PARALLEL_NFA_CHUNK_BITS   8
+#define BIT_PARALLEL_NFA_CHUNKS       (BIT_PARALLEL_NFA_MAX_POSITIONS / BIT_PARALLEL_NFA_CHUNK_BITS)
+#define BIT_PARALLEL_NFA_CHUNK_VALUES (1 << BIT_PARALLEL_NFA_CHUNK_BITS)
+
+struct _BitParallelNfa
+{
+  GObject parent_instance;
+};
+
+/* The active positions are kept in a single machine word, the positions which can be entered next
+ * are looked up one byte of that word at a time (which is what makes a step independent of the
+ * number of active positions) and then masked by the positions that can consume the input character.
+ */
+typedef struct
+{
+  guint64  first_positions;
+  guint64  last_positions;
+  gboolean nullable;
+  guint64  follow_sets[BIT_PARALLEL_NFA_MAX_POSITIONS];
+  guint64  character_masks[G_MAXUINT8 + 1];
+  guint64  follow_tables[BIT_PARALLEL_NFA_CHUNKS][BIT_PARALLEL_NFA_CHUNK_VALUES];
+  gboolean is_start_anchored;
+  gboolean is_input_exhausted;
+} BitParallelNfaPrivate;
+
+enum
+{
+  PROP_FIRST_POSITIONS = 1,
+  PROP_LAST_POSITIONS,
+  PROP_NULLABLE,
+  PROP_FOLLOW_SETS,
+  PROP_CHARACTER_MASKS,
+  N_PROPERTIES
+};
+
+static GParamSpec *obj_properties[N_PROPERTIES] = { NULL };
+
+static void       bit_parallel_nfa_acceptor_runnable_interface_init (AcceptorRunnableInterface *iface);
+
+static void       bit_parallel_nfa_constructed                      (GObject                   *object);
+
+static GPtrArray *bit_parallel_nfa_run                              (AcceptorRunnable          *self,
+                                                                     const gchar               *input,
+                                                                     MatchCounters             *counters);
+
+static gboolean   bit_parallel_nfa_can_accept                       (AcceptorRunnable          *self);
+
+static void       bit_parallel_nfa_measure                          (AcceptorRunnable          *self,
+                                                                     AutomatonStats            *stats);
+
+static guint64    bit_parallel_nfa_step                             (BitParallelNfaPrivate     *priv,
+                                                                     gboolean                   is_at_start,
+                                                                     guint64                    current_positions,
+                                                                     gchar                      input_character);
+
+static void       bit_parallel_nfa_prune_dead_positions             (BitParallelNfaPrivate     *priv);
+
+static void       bit_parallel_nfa_build_follow_tables              (BitParallelNfaPrivate     *priv);
+
+static gboolean   bit_parallel_nfa_is_start_anchored                (BitParallelNfaPrivate     *priv);
+
+static void       bit_parallel_nfa_get_property                     (GObject                   *object,
+                                                                     guint                      property_id,
+                                                                     GValue                    *value,
+                                                                     GParamSpec                *pspec);
+
+static void       bit_parallel_nfa_set_property                     (GObject                   *object,
+                                                                     guint                      property_id,
+                                                                     const GValue              *value,
+                                                                     GParamSpec                *pspec);
+
+G_DEFINE_TYPE_WITH_CODE (BitParallelNfa, bit_parallel_nfa, G_TYPE_OBJECT,
+                         G_ADD_PRIVATE (BitParallelNfa)
+                         G_IMPLEMENT_INTERFACE (ACCEPTORS_TYPE_ACCEPTOR_RUNNABLE,
+                                                bit_parallel_nfa_acceptor_runnable_interface_init))
+
+static void
+bit_parallel_nfa_class_init (BitParallelNfaClass *klass)
+{
+  GObjectClass *object_class = G_OBJECT_CLASS (klass);
+
+  object_class->constructed = bit_parallel_nfa_constructed;
+  object_class->get_property = bit_parallel_nfa_get_property;
+  object_class->set_property = bit_parallel_nfa_set_property;
+
+  obj_properties[PROP_FIRST_POSITIONS] =
+    g_param_spec_uint64 (PROP_BIT_PARALLEL_NFA_FIRST_POSITIONS,
+                         "First positions",
+                         "Positions which can be entered from the initial state.",
+                         0,
+                         G_MAXUINT64,
+                         0,
+                         G_PARAM_CONSTRUCT_ONLY | G_PARAM_READWRITE);
+
+  obj_properties[PROP_LAST_POSITIONS] =
+    g_param_spec_uint64 (PROP_BIT_PARALLEL_NFA_LAST_POSITIONS,
+                         "Last positions",
+                         "Positions which can end the expression.",
+                         0,
+                         G_MAXUINT64,
+                         0,
+                         G_PARAM_CONSTRUCT_ONLY | G_PARAM_READWRITE);
+
+  obj_properties[PROP_NULLABLE] =
+    g_param_spec_boolean (PROP_BIT_PARALLEL_NFA_NULLABLE,
+                          "Nullable",
+                          "Whether the expression matches the empty string.",
+                          FALSE,
+                          G_PARAM_CONSTRUCT_ONLY | G_PARAM_READWRITE);
+
+  obj_properties[PROP_FOLLOW_SETS] =
+    g_param_spec_pointer (PROP_BIT_PARALLEL_NFA_FOLLOW_SETS,
+                          "Follow sets",
+                          "Positions which can follow each one of the positions (the array is copied).",
+                          G_PARAM_CONSTRUCT_ONLY | G_PARAM_WRITABLE);
+
+  obj_properties[PROP_CHARACTER_MASKS] =
+    g_param_spec_pointer (PROP_BIT_PARALLEL_NFA_CHARACTER_MASKS,
+                          "Character masks",
+                          "Positions which can consume each one of the characters (the array is copied).",
+                          G_PARAM_CONSTRUCT_ONLY | G_PARAM_WRITABLE);
+
+  g_object_class_install_properties (object_class,
+                                     N_PROPERTIES,
+                                     obj_properties);
+}
+
+static void
+bit_parallel_nfa_init (BitParallelNfa *self)
+{
+  /* NOP */
+}
+
+static void
+bit_parallel_nfa_acceptor_runnable_interface_init (AcceptorRunnableInterface *iface)
+{
+  iface->run = bit_parallel_nfa_run;
+  iface->can_accept = bit_parallel_nfa_can_accept;
+  iface->measure = bit_parallel_nfa_measure;
+}
+
+static void
+bit_parallel_nfa_constructed (GObject *object)
+{
+  BitParallelNfaPrivate *priv = bit_parallel_nfa_get_instance_private (ACCEPTORS_BIT_PARALLEL_NFA (object));
+
+  bit_parallel_nfa_prune_dead_positions (priv);
+  bit_parallel_nfa_build_follow_tables (priv);
+
+  priv->is_start_anchored = bit_parallel_nfa_is_start_anchored (priv);
+
+  G_OBJECT_CLASS (bit_parallel_nfa_parent_class)->constructed (object);
+}
+
+static GPtrArray *
+bit_parallel_nfa_run (AcceptorRunnable *self,
+                      const gchar      *input,
+                      MatchCounters    *counters)
+{
+  g_return_val_if_fail (ACCEPTORS_IS_BIT_PARALLEL_NFA (self), NULL);
+  g_return_val_if_fail (input != NULL, NULL);
+
+  BitParallelNfaPrivate *priv = bit_parallel_nfa_get_instance_private (ACCEPTORS_BIT_PARALLEL_NFA (self));
+  guint begin = 0, end = 0;
+  GPtrArray *matches = NULL;
+  MatchCounters run_counters = { 0 };
+  gboolean is_at_start = TRUE;
+  guint64 current_positions = 0;
+
+  priv->is_input_exhausted = FALSE;
+
+  /* The simulation mirrors the DFA's run exactly - a set of positions corresponds to a single
+   * DFA state while the empty set corresponds to the dead state.
+   */
+  while (TRUE)
+    {
+      gchar previous_character = 0;
+      gboolean is_rest_of_input_skipped = FALSE;
+
+      if (end != 0)
+        {
+          previous_character = acceptor_runnable_input_at (input, end - 1);
+
+          if (previous_character == END_OF_STRING)
+            {
+              priv->is_input_exhausted = TRUE;
+
+              break;
+            }
+        }
+
+      gchar current_character = acceptor_runnable_input_at (input, end);
+      guint64 next_positions = bit_parallel_nfa_step (priv, is_at_start, current_positions, current_character);
+      gboolean current_positions_are_final = is_at_start
+                                             ? priv->nullable
+                                             : (current_positions & priv->last_positions) != 0;
+      gboolean next_positions_are_dead = (next_positions == 0);
+      guint distance = end - begin;
+      g_autoptr (GString) match_value = NULL;
+      guint match_range_begin = 0, match_range_end = 0;
+
+      /* Handling empty matches. */
+      if (current_positions_are_final)
+        {
+          /* Ignoring empty matches that are a result of the start and end of text special characters. */
+          gboolean is_valid_empty_match =
+            (distance == 0 &&
+             (current_character != START && previous_character != END));
+
+          if (is_valid_empty_match)
+            {
+              match_value = g_string_new (EMPTY_STRING);
+              match_range_begin = match_range_end = end - 1;
+            }
+        }
+
+      /* Handling non-empty matches. */
+      if (next_positions_are_dead)
+        {
+          gboolean is_valid_non_empty_match =
+            (distance != 0 && current_positions_are_final);
+
+          if (is_valid_non_empty_match)
+            {
+              match_value = acceptor_runnable_input_copy (input, begin, end);
+              match_range_begin = begin - 1;
+              match_range_end = end - 1;
+            }
+
+          /* Moving onto the next character in the input in case no position was entered straight
+           * from the initial state without consuming a single character.
+           */
+          if (distance == 0)
+            {
+              end++;
+              run_counters.bytes_scanned++;
+            }
+
+          run_counters.dead_transitions++;
+
+          if (distance != 0)
+            run_counters.resets++;
+
+          /* Preparing for a new run. */
+          begin = end;
+          is_at_start = TRUE;
+          current_positions = 0;
+
+          /* A start-anchored expression cannot match anywhere else than at a start of text character,
+           * the characters in between are skipped altogether.
+           */
+          if (priv->is_start_anchored)
+            {
+              guint next_start_of_text = acceptor_runnable_input_find (input, end, START);
+
+              if (next_start_of_text != G_MAXUINT)
+                begin = end = next_start_of_text;
+              else
+                is_rest_of_input_skipped = TRUE;
+
+              run_counters.skips++;
+            }
+        }
+      else
+        {
+          /* Moving onto the next character in the input in case the NFA can continue with the current run. */
+          is_at_start = FALSE;
+          current_positions = next_positions;
+
+          end++;
+          run_counters.bytes_scanned++;
+        }
+
+      /* Adding a new match if possible. */
+      if (match_value != NULL)
+        {
+          if (matches == NULL)
+            matches = g_ptr_array_new_with_free_func (g_object_unref);
+
+          Match *match = match_new (PROP_MATCH_VALUE, match_value,
+                                    PROP_MATCH_RANGE_BEGIN, match_range_begin,
+                                    PROP_MATCH_RANGE_END, match_range_end);
+
+          g_ptr_array_add (matches, match);
+
+          run_counters.matches++;
+
+          if (match_value->len == 0)
+            run_counters.empty_matches++;
+        }
+
+      if (is_rest_of_input_skipped)
+        {
+          priv->is_input_exhausted = TRUE;
+
+          break;
+        }
+    }
+
+  if (counters != NULL)
+    match_counters_add (counters, &run_counters);
+
+  return matches;
+}
+
+static gboolean
+bit_parallel_nfa_can_accept (AcceptorRunnable *self)
+{
+  g_return_val_if_fail (ACCEPTORS_IS_BIT_PARALLEL_NFA (self), FALSE);
+
+  BitParallelNfaPrivate *priv = bit_parallel_nfa_get_instance_private (ACCEPTORS_BIT_PARALLEL_NFA (self));
+
+  return priv->is_input_exhausted;
+}
+
+static void
+bit_parallel_nfa_measure (AcceptorRunnable *self,
+                          AutomatonStats   *stats)
+{
+  g_return_if_fail (ACCEPTORS_IS_BIT_PARALLEL_NFA (self));
+
+  BitParallelNfaPrivate *priv = bit_parallel_nfa_get_instance_private (ACCEPTORS_BIT_PARALLEL_NFA (self));
+  g_autoptr (GHashTable) distinct_masks = g_hash_table_new (g_int64_hash, g_int64_equal);
+  guint64 all_positions = 0;
+
+  /* Each position is a state of its own (the initial state is the extra one), the characters consumed
+   * by exactly the same positions are indistinguishable.
+   */
+  for (guint character = 0; character < G_N_ELEMENTS (priv->character_masks); ++character)
+    {
+      all_positions |= priv->character_masks[character];
+
+      if (priv->character_masks[character] != 0)
+        g_hash_table_add (distinct_masks, &priv->character_masks[character]);
+    }
+
+  stats->states_count = (guint) __builtin_popcountll (all_positions) + 1;
+  stats->transitions_count = (guint) __builtin_popcountll (priv->first_positions);
+
+  for (guint i = 0; i < BIT_PARALLEL_NFA_MAX_POSITIONS; ++i)
+    if (all_positions & (G_GUINT64_CONSTANT (1) << i))
+      stats->transitions_count += (guint) __builtin_popcountll (priv->follow_sets[i]);
+
+  stats->alphabet_size = g_hash_table_size (distinct_masks);
+  stats->has_dead_state = FALSE;
+
+  /* All of the tables are embedded in the instance itself. */
+  stats->bytes = g_object_get_instance_size (self);
+}
+
+static guint64
+bit_parallel_nfa_step (BitParallelNfaPrivate *priv,
+                       gboolean               is_at_start,
+                       guint64                current_positions,
+                       gchar                  input_character)
+{
+  guint64 reachable_positions = 0;
+
+  if (is_at_start)
+    {
+      reachable_positions = priv->first_positions;
+    }
+  else
+    {
+      for (guint i = 0; current_positions != 0; ++i, current_positions >>= BIT_PARALLEL_NFA_CHUNK_BITS)
+        reachable_positions |= priv->follow_tables[i][current_positions & (BIT_PARALLEL_NFA_CHUNK_VALUES - 1)];
+    }
+
+  return reachable_positions & priv->character_masks[(guint8) input_character];
+}
+
+static void
+bit_parallel_nfa_prune_dead_positions (BitParallelNfaPrivate *priv)
+{
+  guint64 alive_positions = priv->last_positions;
+  gboolean is_changed = TRUE;
+
+  /* A position is alive only if a position that ends the expression can be reached from it - the
+   * remaining positions are what the minimized DFA merges into its dead state.
+   */
+  while (is_changed)
+    {
+      is_changed = FALSE;
+
+      for (guint i = 0; i < BIT_PARALLEL_NFA_MAX_POSITIONS; ++i)
+        {
+          guint64 position = G_GUINT64_CONSTANT (1) << i;
+
+          if (!(alive_positions & position) && (priv->follow_sets[i] & alive_positions))
+            {
+              alive_positions |= position;
+              is_changed = TRUE;
+            }
+        }
+    }
+
+  priv->first_positions &= alive_positions;
+
+  for (guint i = 0; i < BIT_PARALLEL_NFA_MAX_POSITIONS; ++i)
+    priv->follow_sets[i] &= alive_positions;
+}
+
+static void
+bit_parallel_nfa_build_follow_tables (BitParallelNfaPrivate *priv)
+{
+  for (guint i = 0; i < BIT_PARALLEL_NFA_CHUNKS; ++i)
+    {
+      guint64 *follow_table = priv->follow_tables[i];
+
+      follow_table[0] = 0;
+
+      /* Each entry extends an already computed one by its lowest set bit. */
+      for (guint value = 1; value < BIT_PARALLEL_NFA_CHUNK_VALUES; ++value)
+        {
+          guint lowest_bit = g_bit_nth_lsf (value, -1);
+
+          follow_table[value] = follow_table[value & (value - 1)] |
+                                priv->follow_sets[i * BIT_PARALLEL_NFA_CHUNK_BITS + lowest_bit];
+        }
+    }
+}
+
+static gboolean
+bit_parallel_nfa_is_start_anchored (BitParallelNfaPrivate *priv)
+{
+  if (priv->nullable)
+    return FALSE;
+
+  /* Only the start of text character can be consumed by any of the first positions. */
+  for (guint character = 0; character < G_N_ELEMENTS (priv->character_masks); ++character)
+    if ((gchar) character != START && (priv->first_positions & priv->character_masks[character]) != 0)
+      return FALSE;
+
+  return TRUE;
+}
+
+static void
+bit_parallel_nfa_get_property (GObject    *object,
+                               guint       property_id,
+                               GValue     *value,
+                               GParamSpec *pspec)
+{
+  BitParallelNfaPrivate *priv = bit_parallel_nfa_get_instance_private (ACCEPTORS_BIT_PARALLEL_NFA (object));
+
+  switch (property_id)
+    {
+    case PROP_FIRST_POSITIONS:
+      g_value_set_uint64 (value, priv->first_positions);
+      break;
+
+    case PROP_LAST_POSITIONS:
+      g_value_set_uint64 (value, priv->last_positions);
+      break;
+
+    case PROP_NULLABLE:
+      g_value_set_boolean (value, priv->nullable);
+      break;
+
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
+      break;
+    }
+}
+
+static void
+bit_parallel_nfa_set_property (GObject      *object,
+                               guint         property_id,
+                               const GValue *value,
+                               GParamSpec   *pspec)
+{
+  BitParallelNfaPrivate *priv = bit_parallel_nfa_get_instance_private (ACCEPTORS_BIT_PARALLEL_NFA (object));
+
+  switch (property_id)
+    {
+    case PROP_FIRST_POSITIONS:
+      priv->first_positions = g_value_get_uint64 (value);
+      break;
+
+    case PROP_LAST_POSITIONS:
+      priv->last_positions = g_value_get_uint64 (value);
+      break;
+
+    case PROP_NULLABLE:
+      priv->nullable = g_value_get_boolean (value);
+      break;
+
+    case PROP_FOLLOW_SETS:
+      {
+        const guint64 *follow_sets = g_value_get_pointer (value);
+
+        if (follow_sets != NULL)
+          memcpy (priv->follow_sets, follow_sets, sizeof (priv->follow_sets));
+      }
+      break;
+
+    case PROP_CHARACTER_MASKS:
+      {
+        const guint64 *character_masks = g_value_get_pointer (value);
+
+        if (character_masks != NULL)
+          memcpy (priv->character_masks, character_masks, sizeof (priv->character_masks));
+      }
+      break;
+
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
+      break;
+    }
+}
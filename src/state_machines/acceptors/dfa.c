@@ -1,10 +1,12 @@
 #include "internal/state_machines/acceptors/dfa.h"
+#include "internal/state_machines/acceptors/dfa_table.h"
 #include "internal/state_machines/acceptors/acceptor_runnable.h"
 #include "internal/state_machines/fsm_modifiable.h"
 #include "internal/state_machines/fsm_initializable.h"
 #include "internal/state_machines/transitions/deterministic_transition.h"
 #include "internal/state_machines/transitions/transition_factory.h"
 #include "internal/common/helpers.h"
+#include "internal/common/trace.h"
 #include "core/match.h"
 
 struct _Dfa
@@ -12,38 +14,60 @@ struct _Dfa
   Fsm parent_instance;
 };
 
+/* The states are flattened into a table before the first run, restarting a run then comes down to
+ * a single assignment and the dead state never has to be looked for.
+ */
 typedef struct
 {
-  State    *current_state;
-  gboolean  is_input_exhausted;
+  DfaTable   *table;
+  gboolean    is_start_anchored;
+  gboolean    is_input_exhausted;
+
+  /* Profiling */
+  gboolean    profiling;
+  DfaProfile *profile;
 } DfaPrivate;
 
+enum
+{
+  PROP_PROFILING = 1,
+  N_PROPERTIES
+};
+
+static GParamSpec *obj_properties[N_PROPERTIES] = { NULL };
+
 static void       dfa_fsm_modifiable_interface_init                   (FsmModifiableInterface    *iface);
 
 static void       dfa_acceptor_runnable_interface_init                (AcceptorRunnableInterface *iface);
 
-static void       dfa_minimize                                        (FsmModifiable             *self);
+static void       dfa_minimize                                        (FsmModifiable             *self,
+                                                                       CompilationBudget         *budget);
 
 static void       dfa_complement                                      (FsmModifiable             *self);
 
 static GPtrArray *dfa_run                                             (AcceptorRunnable          *self,
-                                                                       const gchar               *input);
+                                                                       const gchar               *input,
+                                                                       MatchCounters             *counters);
 
 static gboolean   dfa_can_accept                                      (AcceptorRunnable          *self);
 
-static void       dfa_reset                                           (Dfa                       *self);
+static void       dfa_measure                                         (AcceptorRunnable          *self,
+                                                                       AutomatonStats            *stats);
+
+static DfaTable  *dfa_fetch_table                                     (Dfa                       *self);
 
-static State     *dfa_transition_to_next_state                        (Dfa                       *self,
-                                                                       gchar                      input_character);
+static void       dfa_invalidate_table                                (Dfa                       *self);
 
 static void       dfa_remove_unreachable_states_if_needed             (Dfa                       *self);
 
 static GArray    *dfa_fetch_unreachable_states_from                   (GPtrArray                 *all_states);
 
-static void       dfa_compose_equivalent_states_if_needed             (Dfa                       *self);
+static void       dfa_compose_equivalent_states_if_needed             (Dfa                       *self,
+                                                                       CompilationBudget         *budget);
 
 static GPtrArray *dfa_fetch_equivalence_classes_from                  (GPtrArray                 *input_equivalence_classes,
-                                                                       GSList                    *alphabet);
+                                                                       GSList                    *alphabet,
+                                                                       CompilationBudget         *budget);
 
 static gboolean   dfa_can_states_transition_to_same_equivalence_class (State                     *first_state,
                                                                        State                     *second_state,
@@ -54,6 +78,16 @@ static GPtrArray *dfa_fetch_matched_equivalence_class_from            (GPtrArray
                                                                        GPtrArray                 *all_equivalence_classes,
                                                                        gchar                      expected_character);
 
+static void       dfa_get_property                                    (GObject                   *object,
+                                                                       guint                      property_id,
+                                                                       GValue                    *value,
+                                                                       GParamSpec                *pspec);
+
+static void       dfa_set_property                                    (GObject                   *object,
+                                                                       guint                      property_id,
+                                                                       const GValue              *value,
+                                                                       GParamSpec                *pspec);
+
 static void       dfa_dispose                                         (GObject                   *object);
 
 G_DEFINE_TYPE_WITH_CODE (Dfa, dfa, STATE_MACHINES_TYPE_FSM,
@@ -68,7 +102,20 @@ dfa_class_init (DfaClass *klass)
 {
   GObjectClass *object_class = G_OBJECT_CLASS (klass);
 
+  object_class->get_property = dfa_get_property;
+  object_class->set_property = dfa_set_property;
   object_class->dispose = dfa_dispose;
+
+  obj_properties[PROP_PROFILING] =
+    g_param_spec_boolean (PROP_DFA_PROFILING,
+                          "Profiling",
+                          "Whether the state visits and the transitions taken are counted during each run.",
+                          FALSE,
+                          G_PARAM_READWRITE);
+
+  g_object_class_install_properties (object_class,
+                                     N_PROPERTIES,
+                                     obj_properties);
 }
 
 static void
@@ -89,15 +136,19 @@ dfa_acceptor_runnable_interface_init (AcceptorRunnableInterface *iface)
 {
   iface->run = dfa_run;
   iface->can_accept = dfa_can_accept;
+  iface->measure = dfa_measure;
 }
 
 static void
-dfa_minimize (FsmModifiable *self)
+dfa_minimize (FsmModifiable     *self,
+              CompilationBudget *budget)
 {
   g_return_if_fail (ACCEPTORS_IS_DFA (self));
 
   Dfa *dfa = ACCEPTORS_DFA (self);
 
+  dfa_invalidate_table (dfa);
+
   /* Performing minimization firstly by removing unreachable states (if they exist) - i.e., states in to which
    * no other state can transition.
    */
@@ -106,7 +157,7 @@ dfa_minimize (FsmModifiable *self)
   /* Performing further minimization using the equivalence theorem - i.e., by composing classes containing
    * equivalent states (if they exist) into their corresponding composite states.
    */
-  dfa_compose_equivalent_states_if_needed (dfa);
+  dfa_compose_equivalent_states_if_needed (dfa, budget);
 }
 
 static void
@@ -116,6 +167,8 @@ dfa_complement (FsmModifiable *self)
 
   g_autoptr (GPtrArray) all_states = NULL;
 
+  dfa_invalidate_table (ACCEPTORS_DFA (self));
+
   g_object_get (self,
                 PROP_FSM_INITIALIZABLE_ALL_STATES, &all_states,
                 NULL);
@@ -162,7 +215,8 @@ dfa_complement (FsmModifiable *self)
 
 static GPtrArray *
 dfa_run (AcceptorRunnable *self,
-         const gchar      *input)
+         const gchar      *input,
+         MatchCounters    *counters)
 {
   g_return_val_if_fail (ACCEPTORS_IS_DFA (self), NULL);
   g_return_val_if_fail (input != NULL, NULL);
@@ -170,25 +224,23 @@ dfa_run (AcceptorRunnable *self,
   Dfa *dfa = ACCEPTORS_DFA (self);
   DfaPrivate *priv = dfa_get_instance_private (dfa);
 
-  dfa_reset (dfa);
-  g_return_val_if_fail (priv->current_state != NULL, NULL);
-
-  gchar start_of_text[] = { START, END_OF_STRING };
-  gchar end_of_text[] = { END, END_OF_STRING };
-  g_autofree gchar *adjusted_input = g_strconcat (start_of_text,
-                                                  input,
-                                                  end_of_text,
-                                                  NULL);
+  const DfaTable *table = dfa_fetch_table (dfa);
+  DfaProfile *profile = priv->profile;
   guint begin = 0, end = 0;
+  guint current_state = table->start;
   GPtrArray *matches = NULL;
+  MatchCounters run_counters = { 0 };
+
+  priv->is_input_exhausted = FALSE;
 
   while (TRUE)
     {
       gchar previous_character = 0;
+      gboolean is_rest_of_input_skipped = FALSE;
 
       if (end != 0)
         {
-          previous_character = adjusted_input[end - 1];
+          previous_character = acceptor_runnable_input_at (input, end - 1);
 
           if (previous_character == END_OF_STRING)
             {
@@ -198,23 +250,16 @@ dfa_run (AcceptorRunnable *self,
             }
         }
 
-      gchar current_character = adjusted_input[end];
-      State *current_state = priv->current_state;
-      StateTypeFlags current_state_type_flags = STATE_TYPE_UNDEFINED;
-      State *next_state = dfa_transition_to_next_state (dfa, current_character);
-      gboolean next_state_is_dead = FALSE;
-
-      g_object_get (current_state,
-                    PROP_STATE_TYPE_FLAGS, &current_state_type_flags,
-                    NULL);
+      /* The null terminator leads to the dead state as it does not belong to any set of the alphabet. */
+      gchar current_character = acceptor_runnable_input_at (input, end);
+      guint next_state = dfa_table_step (table, current_state, current_character);
 
-      gboolean current_state_is_start = (current_state_type_flags & STATE_TYPE_START);
-      gboolean current_state_is_final = (current_state_type_flags & STATE_TYPE_FINAL);
-
-      g_object_get (next_state,
-                    PROP_STATE_IS_DEAD, &next_state_is_dead,
-                    NULL);
+      if (G_UNLIKELY (profile != NULL))
+        dfa_profile_record (profile, current_state, table->character_classes[(guint8) current_character]);
 
+      gboolean current_state_is_start = (current_state == table->start);
+      gboolean current_state_is_final = table->finals[current_state];
+      gboolean next_state_is_dead = (next_state == table->dead);
       guint distance = end - begin;
       g_autoptr (GString) match_value = NULL;
       guint match_range_begin = 0, match_range_end = 0;
@@ -229,9 +274,7 @@ dfa_run (AcceptorRunnable *self,
 
           if (is_valid_empty_match)
             {
-              g_autofree gchar *value = g_strdup (EMPTY_STRING);
-
-              match_value = g_string_new (value);
+              match_value = g_string_new (EMPTY_STRING);
               match_range_begin = match_range_end = end - 1;
             }
         }
@@ -247,9 +290,7 @@ dfa_run (AcceptorRunnable *self,
 
           if (is_valid_non_empty_match)
             {
-              g_autofree gchar *value = g_strndup (adjusted_input + begin, distance);
-
-              match_value = g_string_new (value);
+              match_value = acceptor_runnable_input_copy (input, begin, end);
               match_range_begin = begin - 1;
               match_range_end = end - 1;
             }
@@ -258,17 +299,42 @@ dfa_run (AcceptorRunnable *self,
            * straight from the start state without consuming a single character.
            */
           if (current_state_is_start && distance == 0)
-            end++;
+            {
+              end++;
+              run_counters.bytes_scanned++;
+            }
+
+          run_counters.dead_transitions++;
+
+          if (distance != 0)
+            run_counters.resets++;
 
           /* Preparing for a new run. */
           begin = end;
+          current_state = table->start;
+
+          /* A start-anchored expression cannot match anywhere else than at a start of text character,
+           * the characters in between are skipped altogether.
+           */
+          if (priv->is_start_anchored)
+            {
+              guint next_start_of_text = acceptor_runnable_input_find (input, end, START);
 
-          dfa_reset (dfa);
+              if (next_start_of_text != G_MAXUINT)
+                begin = end = next_start_of_text;
+              else
+                is_rest_of_input_skipped = TRUE;
+
+              run_counters.skips++;
+            }
         }
       else
         {
           /* Moving onto the next character in the input in case the DFA can continue with the current run. */
+          current_state = next_state;
+
           end++;
+          run_counters.bytes_scanned++;
         }
 
       /* Adding a new match if possible. */
@@ -282,9 +348,24 @@ dfa_run (AcceptorRunnable *self,
                                     PROP_MATCH_RANGE_END, match_range_end);
 
           g_ptr_array_add (matches, match);
+
+          run_counters.matches++;
+
+          if (match_value->len == 0)
+            run_counters.empty_matches++;
+        }
+
+      if (is_rest_of_input_skipped)
+        {
+          priv->is_input_exhausted = TRUE;
+
+          break;
         }
     }
 
+  if (counters != NULL)
+    match_counters_add (counters, &run_counters);
+
   return matches;
 }
 
@@ -300,77 +381,108 @@ dfa_can_accept (AcceptorRunnable *self)
 }
 
 static void
-dfa_reset (Dfa *self)
+dfa_measure (AcceptorRunnable *self,
+             AutomatonStats   *stats)
 {
+  g_return_if_fail (ACCEPTORS_IS_DFA (self));
+
+  Dfa *dfa = ACCEPTORS_DFA (self);
+  DfaPrivate *priv = dfa_get_instance_private (dfa);
+
+  /* The table is built right away (it would have been before the first run anyway) so that the result
+   * does not depend on whether the DFA was run already.
+   */
+  DfaTable *table = dfa_fetch_table (dfa);
+
+  fsm_measure (STATE_MACHINES_FSM (dfa), stats);
+
+  stats->bytes += dfa_table_measure (table);
+
+  if (priv->profile != NULL)
+    stats->bytes += dfa_profile_measure (priv->profile);
+}
+
+gchar *
+dfa_export_profile (Dfa *self)
+{
+  g_return_val_if_fail (ACCEPTORS_IS_DFA (self), NULL);
+
   DfaPrivate *priv = dfa_get_instance_private (self);
+  const DfaTable *table = dfa_fetch_table (self);
 
-  if (priv->current_state != NULL)
-    g_object_unref (priv->current_state);
+  if (priv->profile == NULL)
+    return NULL;
 
-  State *start_state = NULL;
+  /* The profile is only meaningful for the same expression compiled anew, the original numbering is restored. */
+  if (table->layout != NULL)
+    {
+      g_autoptr (DfaProfile) original_profile = dfa_profile_renumber (priv->profile, table->layout);
 
-  g_object_get (self,
-                PROP_FSM_INITIALIZABLE_START_STATE, &start_state,
-                NULL);
+      return dfa_profile_serialize (original_profile);
+    }
 
-  priv->current_state = start_state;
-  priv->is_input_exhausted = FALSE;
+  return dfa_profile_serialize (priv->profile);
 }
 
-static State *
-dfa_transition_to_next_state (Dfa   *self,
-                              gchar  input_character)
+gboolean
+dfa_apply_profile (Dfa         *self,
+                   const gchar *serialized_profile)
 {
+  g_return_val_if_fail (ACCEPTORS_IS_DFA (self), FALSE);
+  g_return_val_if_fail (serialized_profile != NULL, FALSE);
+
   DfaPrivate *priv = dfa_get_instance_private (self);
-  State *current_state = priv->current_state;
-  g_autoptr (GPtrArray) transitions = NULL;
+  DfaTable *table = dfa_fetch_table (self);
+  g_autoptr (DfaProfile) profile = dfa_profile_deserialize (serialized_profile);
 
-  g_object_get (current_state,
-                PROP_STATE_TRANSITIONS, &transitions,
-                NULL);
+  if (profile == NULL ||
+      profile->states_count != table->states_count ||
+      profile->classes_count != table->classes_count)
+    return FALSE;
 
-  g_return_val_if_fail (g_collection_has_items (transitions), FALSE);
-  g_object_unref (current_state);
+  dfa_table_apply_profile (table, profile);
 
-  /* Ignoring the null terminator. */
-  if (input_character != END_OF_STRING)
+  /* The counts recorded so far are numbered the previous way. */
+  if (priv->profile != NULL)
     {
-      /* Trying to find an eligible transition found among the current state's transitions. */
-      for (guint i = 0; i < transitions->len; ++i)
-        {
-          Transition *transition = g_ptr_array_index (transitions, i);
-
-          g_return_val_if_fail (TRANSITIONS_IS_DETERMINISTIC_TRANSITION (transition), FALSE);
+      g_clear_pointer (&priv->profile, dfa_profile_free);
 
-          if (transition_is_allowed (transition, input_character))
-            {
-              State *next_state = NULL;
+      priv->profile = dfa_profile_new (table->states_count, table->classes_count);
+    }
 
-              g_object_get (transition,
-                            PROP_DETERMINISTIC_TRANSITION_OUTPUT_STATE, &next_state,
-                            NULL);
+  return TRUE;
+}
 
-              priv->current_state = next_state;
+static DfaTable *
+dfa_fetch_table (Dfa *self)
+{
+  DfaPrivate *priv = dfa_get_instance_private (self);
 
-              return next_state;
-            }
-        }
+  if (priv->table == NULL)
+    {
+      priv->table = dfa_table_new (self);
+      priv->is_start_anchored = dfa_table_is_anchored_on (priv->table, START);
     }
 
-  /* Transitioning to the dead state in case the input character is unrecognized.
-   * This means that it does not belong to the state machine's alphabet.
-   */
-  g_autoptr (GPtrArray) all_states = NULL;
+  if (priv->profiling && priv->profile == NULL)
+    priv->profile = dfa_profile_new (priv->table->states_count, priv->table->classes_count);
 
-  g_object_get (self,
-                PROP_FSM_INITIALIZABLE_ALL_STATES, &all_states,
-                NULL);
+  return priv->table;
+}
 
-  State *dead_state = fsm_get_or_create_dead_state (all_states);
+static void
+dfa_invalidate_table (Dfa *self)
+{
+  DfaPrivate *priv = dfa_get_instance_private (self);
 
-  priv->current_state = g_object_ref (dead_state);
+  /* The table is rebuilt before the next run in case the states were modified (the profile is then
+   * no longer valid either).
+   */
+  if (priv->table != NULL)
+    g_clear_pointer (&priv->table, dfa_table_free);
 
-  return dead_state;
+  if (priv->profile != NULL)
+    g_clear_pointer (&priv->profile, dfa_profile_free);
 }
 
 static void
@@ -468,7 +580,8 @@ dfa_fetch_unreachable_states_from (GPtrArray *all_states)
 }
 
 static void
-dfa_compose_equivalent_states_if_needed (Dfa *self)
+dfa_compose_equivalent_states_if_needed (Dfa               *self,
+                                         CompilationBudget *budget)
 {
   GSList *alphabet = NULL;
   g_autoptr (GPtrArray) final_states = NULL;
@@ -488,7 +601,12 @@ dfa_compose_equivalent_states_if_needed (Dfa *self)
                             NULL);
 
   g_autoptr (GPtrArray) final_equivalence_classes = dfa_fetch_equivalence_classes_from (initial_equivalence_classes,
-                                                                                        alphabet);
+                                                                                        alphabet,
+                                                                                        budget);
+
+  /* The equivalence classes are not final in case the refinement was abandoned. */
+  if (compilation_budget_is_exceeded (budget))
+    return;
   const guint acceptable_scalar_equivalence_class_size = 1;
   gboolean should_compose_equivalence_classes = FALSE;
 
@@ -510,7 +628,6 @@ dfa_compose_equivalent_states_if_needed (Dfa *self)
    */
   if (should_compose_equivalence_classes)
     {
-      guint alphabet_length = g_slist_length (alphabet);
       g_autoptr (GPtrArray) all_states = g_ptr_array_new_with_free_func (g_object_unref);
 
       for (guint i = 0; i < final_equivalence_classes->len; ++i)
@@ -537,9 +654,10 @@ dfa_compose_equivalent_states_if_needed (Dfa *self)
                 }
 
               /* Defining new transitions for the input state. */
-              for (guint j = 0; j < alphabet_length; ++j)
+              for (GSList *iterator = alphabet; iterator != NULL; iterator = iterator->next)
                 {
-                  gchar expected_character = (gchar) GPOINTER_TO_INT (g_slist_nth_data (alphabet, j));
+                  CharacterSet *expected_characters = iterator->data;
+                  gchar expected_character = character_set_get_representative (expected_characters);
                   State *output_state = NULL;
                   GPtrArray *matched_equivalence_class =
                     dfa_fetch_matched_equivalence_class_from (equivalence_class,
@@ -556,8 +674,8 @@ dfa_compose_equivalent_states_if_needed (Dfa *self)
                                                                       COMPOSITE_STATE_RESOLVE_TYPE_FLAGS_ALL,
                                                                       NULL);
 
-                  Transition *transition = create_deterministic_transition (expected_character,
-                                                                            output_state);
+                  Transition *transition = create_deterministic_set_transition (expected_characters,
+                                                                                output_state);
 
                   g_ptr_array_add (transitions, transition);
                 }
@@ -576,15 +694,24 @@ dfa_compose_equivalent_states_if_needed (Dfa *self)
 }
 
 static GPtrArray *
-dfa_fetch_equivalence_classes_from (GPtrArray *input_equivalence_classes,
-                                    GSList    *alphabet)
+dfa_fetch_equivalence_classes_from (GPtrArray         *input_equivalence_classes,
+                                    GSList            *alphabet,
+                                    CompilationBudget *budget)
 {
+  /* Abandoning the refinement as soon as the budget is exceeded. */
+  if (compilation_budget_is_exceeded (budget))
+    return input_equivalence_classes;
+
+  /* Each level of the recursion is traced as a separate span (rather than a nested one), the recursion
+   * itself is merely a loop refining the equivalence classes.
+   */
+  trace_begin ("compile", "refinement");
+
   GPtrArray *current_equivalence_classes = g_ptr_array_new_with_free_func ((GDestroyNotify) g_ptr_array_unref);
   g_autoptr (GHashTable) states_for_removal = g_hash_table_new_full (g_direct_hash,
                                                                      g_direct_equal,
                                                                      NULL,
                                                                      (GDestroyNotify) g_array_unref);
-  guint alphabet_length = g_slist_length (alphabet);
 
   for (guint i = 0; i < input_equivalence_classes->len; ++i)
     {
@@ -605,9 +732,9 @@ dfa_fetch_equivalence_classes_from (GPtrArray *input_equivalence_classes,
                 {
                   State *next_state = g_ptr_array_index (input_equivalence_class, j);
 
-                  for (guint k = 0; k < alphabet_length; ++k)
+                  for (GSList *iterator = alphabet; iterator != NULL; iterator = iterator->next)
                     {
-                      gchar expected_character = (gchar) GPOINTER_TO_INT (g_slist_nth_data (alphabet, k));
+                      gchar expected_character = character_set_get_representative (iterator->data);
 
                       /* Moving the next state into an additional equivalence class and also marking it for removal
                        * from the input equivalence class in case it cannot transition to a member of the same
@@ -669,6 +796,8 @@ dfa_fetch_equivalence_classes_from (GPtrArray *input_equivalence_classes,
                                                                                     input_equivalence_classes,
                                                                                     g_ptr_array_equal);
 
+  trace_end ("compile", "refinement", "\"classes\": %u", current_equivalence_classes->len);
+
   g_ptr_array_unref (input_equivalence_classes);
 
   /* Returning the current call's result in case it is equal to the previous call's result. */
@@ -676,7 +805,8 @@ dfa_fetch_equivalence_classes_from (GPtrArray *input_equivalence_classes,
     return current_equivalence_classes;
 
   return dfa_fetch_equivalence_classes_from (current_equivalence_classes,
-                                             alphabet);
+                                             alphabet,
+                                             budget);
 }
 
 static gboolean
@@ -765,13 +895,60 @@ dfa_fetch_matched_equivalence_class_from (GPtrArray *input_equivalence_class,
   return NULL;
 }
 
+static void
+dfa_get_property (GObject    *object,
+                  guint       property_id,
+                  GValue     *value,
+                  GParamSpec *pspec)
+{
+  DfaPrivate *priv = dfa_get_instance_private (ACCEPTORS_DFA (object));
+
+  switch (property_id)
+    {
+    case PROP_PROFILING:
+      g_value_set_boolean (value, priv->profiling);
+      break;
+
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
+      break;
+    }
+}
+
+static void
+dfa_set_property (GObject      *object,
+                  guint         property_id,
+                  const GValue *value,
+                  GParamSpec   *pspec)
+{
+  DfaPrivate *priv = dfa_get_instance_private (ACCEPTORS_DFA (object));
+
+  switch (property_id)
+    {
+    case PROP_PROFILING:
+      priv->profiling = g_value_get_boolean (value);
+
+      /* The profile is allocated along with the table (before the next run). */
+      if (!priv->profiling && priv->profile != NULL)
+        g_clear_pointer (&priv->profile, dfa_profile_free);
+      break;
+
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
+      break;
+    }
+}
+
 static void
 dfa_dispose (GObject *object)
 {
   DfaPrivate *priv = dfa_get_instance_private (ACCEPTORS_DFA (object));
 
-  if (priv->current_state != NULL)
-    g_clear_object (&priv->current_state);
+  if (priv->table != NULL)
+    g_clear_pointer (&priv->table, dfa_table_free);
+
+  if (priv->profile != NULL)
+    g_clear_pointer (&priv->profile, dfa_profile_free);
 
   G_OBJECT_CLASS (dfa_parent_class)->dispose (object);
 }
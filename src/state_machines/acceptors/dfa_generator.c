@@ -0,0 +1,338 @@
+#include "internal/state_machines/acceptors/dfa_generator.h"
+#include "internal/state_machines/transitions/transition.h"
+#include "internal/common/helpers.h"
+
+#include <string.h>
+
+#define DFA_GENERATOR_NAME_PLACEHOLDER       "@name@"
+#define DFA_GENERATOR_UPPER_NAME_PLACEHOLDER "@NAME@"
+#define DFA_GENERATOR_INDENT_PLACEHOLDER     "@indent@"
+#define DFA_GENERATOR_EXPRESSION_PLACEHOLDER "@expression@"
+#define DFA_GENERATOR_VALUES_PER_LINE        16
+
+/* The run mirrors the DFA's own one (including the special characters surrounding the input and the way
+ * the match ranges are adjusted afterwards), only the adjusted input is never actually allocated.
+ */
+static const gchar *dfa_generator_source_template =
+  "static unsigned char\n"
+  "@name@_character_at (const char *input,\n"
+  "@indent@               size_t      length,\n"
+  "@indent@               size_t      index)\n"
+  "{\n"
+  "  /* The input is surrounded by the start and end of text characters. */\n"
+  "  if (index == 0)\n"
+  "    return @NAME@_START_OF_TEXT;\n"
+  "  else if (index <= length)\n"
+  "    return (unsigned char) input[index - 1];\n"
+  "  else if (index == length + 1)\n"
+  "    return @NAME@_END_OF_TEXT;\n"
+  "\n"
+  "  return 0;\n"
+  "}\n"
+  "\n"
+  "static size_t\n"
+  "@name@_add_match (const char *input,\n"
+  "@indent@            size_t length,\n"
+  "@indent@            @name@_match *matches,\n"
+  "@indent@            size_t capacity,\n"
+  "@indent@            size_t count,\n"
+  "@indent@            size_t begin,\n"
+  "@indent@            size_t end)\n"
+  "{\n"
+  "  size_t match_begin = begin - 1, match_end = end - 1;\n"
+  "  int contains_start_of_text = 0, contains_end_of_text = 0;\n"
+  "\n"
+  "  /* The special characters are not a part of the reported range. */\n"
+  "  for (size_t i = begin; i < end; ++i)\n"
+  "    {\n"
+  "      unsigned char character = @name@_character_at (input, length, i);\n"
+  "\n"
+  "      contains_start_of_text |= (character == @NAME@_START_OF_TEXT);\n"
+  "      contains_end_of_text |= (character == @NAME@_END_OF_TEXT);\n"
+  "    }\n"
+  "\n"
+  "  if (contains_start_of_text)\n"
+  "    match_begin += 1;\n"
+  "\n"
+  "  if (contains_end_of_text)\n"
+  "    match_end -= 1;\n"
+  "\n"
+  "  if (count < capacity)\n"
+  "    {\n"
+  "      matches[count].begin = match_begin;\n"
+  "      matches[count].end = match_end;\n"
+  "    }\n"
+  "\n"
+  "  return count + 1;\n"
+  "}\n"
+  "\n"
+  "size_t\n"
+  "@name@_find (const char *input,\n"
+  "@indent@       @name@_match *matches,\n"
+  "@indent@       size_t capacity)\n"
+  "{\n"
+  "  size_t length = strlen (input);\n"
+  "  size_t begin = 0, end = 0, count = 0;\n"
+  "  unsigned int state = @NAME@_START_STATE;\n"
+  "\n"
+  "  for (;;)\n"
+  "    {\n"
+  "      unsigned char previous_character = 0;\n"
+  "\n"
+  "      if (end != 0)\n"
+  "        {\n"
+  "          previous_character = @name@_character_at (input, length, end - 1);\n"
+  "\n"
+  "          if (previous_character == 0)\n"
+  "            break;\n"
+  "        }\n"
+  "\n"
+  "      unsigned char current_character = @name@_character_at (input, length, end);\n"
+  "      unsigned int next_state =\n"
+  "        @name@_transitions[state * @NAME@_CLASSES_COUNT + @name@_classes[current_character]];\n"
+  "      int current_state_is_final = @name@_finals[state];\n"
+  "      size_t distance = end - begin;\n"
+  "\n"
+  "      /* Ignoring empty matches that are a result of the start and end of text characters. */\n"
+  "      if (current_state_is_final &&\n"
+  "          distance == 0 &&\n"
+  "          current_character != @NAME@_START_OF_TEXT &&\n"
+  "          previous_character != @NAME@_END_OF_TEXT)\n"
+  "        count = @name@_add_match (input, length, matches, capacity, count, end, end);\n"
+  "\n"
+  "      if (next_state == @NAME@_DEAD_STATE)\n"
+  "        {\n"
+  "          if (distance != 0 && current_state_is_final)\n"
+  "            count = @name@_add_match (input, length, matches, capacity, count, begin, end);\n"
+  "\n"
+  "          if (distance == 0)\n"
+  "            end++;\n"
+  "\n"
+  "          begin = end;\n"
+  "          state = @NAME@_START_STATE;\n"
+  "\n"
+  "          /* A start-anchored expression cannot match anywhere else than at a start of text character. */\n"
+  "          if (@NAME@_IS_START_ANCHORED)\n"
+  "            {\n"
+  "              const char *next_start_of_text = NULL;\n"
+  "\n"
+  "              if (end <= length)\n"
+  "                next_start_of_text = memchr (input + end - 1, @NAME@_START_OF_TEXT, length - end + 1);\n"
+  "\n"
+  "              if (next_start_of_text == NULL)\n"
+  "                break;\n"
+  "\n"
+  "              begin = end = (size_t) (next_start_of_text - input) + 1;\n"
+  "            }\n"
+  "        }\n"
+  "      else\n"
+  "        {\n"
+  "          state = next_state;\n"
+  "\n"
+  "          end++;\n"
+  "        }\n"
+  "    }\n"
+  "\n"
+  "  return count;\n"
+  "}\n";
+
+static const gchar *dfa_generator_header_template =
+  "/* Generated by regexperience-codegen, do not edit. */\n"
+  "\n"
+  "#ifndef @NAME@_H\n"
+  "#define @NAME@_H\n"
+  "\n"
+  "#include <stddef.h>\n"
+  "\n"
+  "#define @NAME@_EXPRESSION \"@expression@\"\n"
+  "\n"
+  "#ifdef __cplusplus\n"
+  "extern \"C\" {\n"
+  "#endif\n"
+  "\n"
+  "typedef struct\n"
+  "{\n"
+  "  size_t begin;\n"
+  "  size_t end;\n"
+  "} @name@_match;\n"
+  "\n"
+  "/* Finds the matches exactly like the library's default engine does and returns their number - only\n"
+  " * the first ones (up to the capacity) are stored, the matches may therefore be NULL if the capacity\n"
+  " * is zero. The input must be a null-terminated string.\n"
+  " */\n"
+  "size_t @name@_find (const char *input,\n"
+  "@indent@              @name@_match *matches,\n"
+  "@indent@              size_t capacity);\n"
+  "\n"
+  "#ifdef __cplusplus\n"
+  "}\n"
+  "#endif\n"
+  "\n"
+  "#endif /* @NAME@_H */\n";
+
+static gchar       *dfa_generator_expand         (const gchar *template,
+                                                  const gchar *matcher_name);
+
+static const gchar *dfa_generator_fetch_type     (guint        values_count);
+
+static void         dfa_generator_append_values  (GString     *source,
+                                                  const gchar *declaration,
+                                                  const guint *values,
+                                                  gsize        values_count);
+
+gchar *
+dfa_generator_emit_source (const DfaTable *table,
+                           gboolean        is_start_anchored,
+                           const gchar    *matcher_name)
+{
+  g_return_val_if_fail (table != NULL, NULL);
+  g_return_val_if_fail (dfa_generator_is_valid_name (matcher_name), NULL);
+
+  g_autoptr (GString) source = g_string_new (NULL);
+  g_autofree gchar *upper_matcher_name = g_ascii_strup (matcher_name, -1);
+  g_autofree gchar *run = dfa_generator_expand (dfa_generator_source_template, matcher_name);
+  g_autofree gchar *classes_declaration = NULL;
+  g_autofree gchar *transitions_declaration = NULL;
+  g_autofree gchar *finals_declaration = NULL;
+  g_autofree guint *finals = g_new (guint, table->states_count);
+  gsize transitions_count = (gsize) table->states_count * table->classes_count;
+
+  for (guint i = 0; i < table->states_count; ++i)
+    finals[i] = table->finals[i] ? 1 : 0;
+
+  classes_declaration = g_strdup_printf ("static const %s %s_classes[%u]",
+                                         dfa_generator_fetch_type (table->classes_count),
+                                         matcher_name,
+                                         (guint) G_N_ELEMENTS (table->character_classes));
+  transitions_declaration = g_strdup_printf ("static const %s %s_transitions[%" G_GSIZE_FORMAT "]",
+                                             dfa_generator_fetch_type (table->states_count),
+                                             matcher_name,
+                                             transitions_count);
+  finals_declaration = g_strdup_printf ("static const unsigned char %s_finals[%u]",
+                                        matcher_name,
+                                        table->states_count);
+
+  g_string_append_printf (source,
+                          "/* Generated by regexperience-codegen, do not edit. */\n"
+                          "\n"
+                          "#include \"%s.h\"\n"
+                          "\n"
+                          "#include <string.h>\n"
+                          "\n",
+                          matcher_name);
+
+  g_string_append_printf (source, "#define %s_START_OF_TEXT     %d\n", upper_matcher_name, START);
+  g_string_append_printf (source, "#define %s_END_OF_TEXT       %d\n", upper_matcher_name, END);
+  g_string_append_printf (source, "#define %s_START_STATE       %uU\n", upper_matcher_name, table->start);
+  g_string_append_printf (source, "#define %s_DEAD_STATE        %uU\n", upper_matcher_name, table->dead);
+  g_string_append_printf (source, "#define %s_CLASSES_COUNT     %uU\n", upper_matcher_name, table->classes_count);
+  g_string_append_printf (source, "#define %s_IS_START_ANCHORED %d\n\n", upper_matcher_name, is_start_anchored ? 1 : 0);
+
+  /* Each input character is mapped onto its class first, the rows of the transition table are indexed
+   * by the classes (the last one of them leads to the dead state from every state).
+   */
+  dfa_generator_append_values (source,
+                               classes_declaration,
+                               table->character_classes,
+                               G_N_ELEMENTS (table->character_classes));
+  dfa_generator_append_values (source,
+                               transitions_declaration,
+                               table->transitions,
+                               transitions_count);
+  dfa_generator_append_values (source,
+                               finals_declaration,
+                               finals,
+                               table->states_count);
+
+  g_string_append (source, run);
+
+  return g_string_free (g_steal_pointer (&source), FALSE);
+}
+
+gchar *
+dfa_generator_emit_header (const gchar *matcher_name,
+                           const gchar *expression)
+{
+  g_return_val_if_fail (dfa_generator_is_valid_name (matcher_name), NULL);
+  g_return_val_if_fail (expression != NULL, NULL);
+
+  g_autofree gchar *declarations = dfa_generator_expand (dfa_generator_header_template, matcher_name);
+  g_autofree gchar *escaped_expression = g_strescape (expression, NULL);
+  g_auto (GStrv) declarations_parts = g_strsplit (declarations, DFA_GENERATOR_EXPRESSION_PLACEHOLDER, -1);
+
+  /* The expression is kept as a string literal (instead of a comment) so that it never has to be sanitized,
+   * it is only inserted once the name is in place for the same reason.
+   */
+  return g_strjoinv (escaped_expression, declarations_parts);
+}
+
+gboolean
+dfa_generator_is_valid_name (const gchar *matcher_name)
+{
+  if (matcher_name == NULL || *matcher_name == END_OF_STRING || g_ascii_isdigit (*matcher_name))
+    return FALSE;
+
+  for (const gchar *character = matcher_name; *character != END_OF_STRING; ++character)
+    if (!g_ascii_isalnum (*character) && *character != '_')
+      return FALSE;
+
+  return TRUE;
+}
+
+static gchar *
+dfa_generator_expand (const gchar *template,
+                      const gchar *matcher_name)
+{
+  const gchar *placeholders[] = { DFA_GENERATOR_UPPER_NAME_PLACEHOLDER,
+                                  DFA_GENERATOR_NAME_PLACEHOLDER,
+                                  DFA_GENERATOR_INDENT_PLACEHOLDER };
+  g_autofree gchar *upper_matcher_name = g_ascii_strup (matcher_name, -1);
+  g_autofree gchar *indent = g_strnfill (strlen (matcher_name), ' ');
+  const gchar *replacements[] = { upper_matcher_name,
+                                  matcher_name,
+                                  indent };
+  gchar *expanded = g_strdup (template);
+
+  /* The continuation lines of the generated prototypes are indented by the name's length. */
+  for (guint i = 0; i < G_N_ELEMENTS (placeholders); ++i)
+    {
+      g_auto (GStrv) parts = g_strsplit (expanded, placeholders[i], -1);
+
+      g_free (expanded);
+
+      expanded = g_strjoinv (replacements[i], parts);
+    }
+
+  return expanded;
+}
+
+static const gchar *
+dfa_generator_fetch_type (guint values_count)
+{
+  /* The narrowest type keeps the tables as small as possible. */
+  if (values_count <= G_MAXUINT8 + 1)
+    return "unsigned char";
+  else if (values_count <= G_MAXUINT16 + 1)
+    return "unsigned short";
+
+  return "unsigned int";
+}
+
+static void
+dfa_generator_append_values (GString     *source,
+                             const gchar *declaration,
+                             const guint *values,
+                             gsize        values_count)
+{
+  g_string_append_printf (source, "%s =\n{", declaration);
+
+  for (gsize i = 0; i < values_count; ++i)
+    {
+      if (i % DFA_GENERATOR_VALUES_PER_LINE == 0)
+        g_string_append (source, "\n ");
+
+      g_string_append_printf (source, " %u%s", values[i], (i + 1 < values_count) ? "," : "");
+    }
+
+  g_string_append (source, "\n};\n\n");
+}
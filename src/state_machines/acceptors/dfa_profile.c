@@ -0,0 +1,132 @@
+#include "internal/state_machines/acceptors/dfa_profile.h"
+
+#include <string.h>
+
+/* The profile is serialized as a GVariant in its text form, so that it can be inspected and tuned by hand:
+ * the number of states, the number of classes, the visits and the transitions (row by row).
+ */
+#define DFA_PROFILE_FORMAT "(uuatat)"
+
+DfaProfile *
+dfa_profile_new (guint states_count,
+                 guint classes_count)
+{
+  DfaProfile *profile = g_new0 (DfaProfile, 1);
+
+  profile->states_count = states_count;
+  profile->classes_count = classes_count;
+  profile->visits = g_new0 (guint64, states_count);
+  profile->transitions = g_new0 (guint64, (gsize) states_count * classes_count);
+
+  return profile;
+}
+
+void
+dfa_profile_free (DfaProfile *self)
+{
+  g_return_if_fail (self != NULL);
+
+  g_free (self->visits);
+  g_free (self->transitions);
+  g_free (self);
+}
+
+DfaProfile *
+dfa_profile_renumber (const DfaProfile *self,
+                      const guint      *indices)
+{
+  g_return_val_if_fail (self != NULL, NULL);
+  g_return_val_if_fail (indices != NULL, NULL);
+
+  DfaProfile *profile = dfa_profile_new (self->states_count, self->classes_count);
+  gsize row_size = sizeof (guint64) * self->classes_count;
+
+  for (guint state = 0; state < self->states_count; ++state)
+    {
+      guint index = indices[state];
+
+      profile->visits[index] = self->visits[state];
+
+      memcpy (profile->transitions + (gsize) index * self->classes_count,
+              self->transitions + (gsize) state * self->classes_count,
+              row_size);
+    }
+
+  return profile;
+}
+
+gchar *
+dfa_profile_serialize (const DfaProfile *self)
+{
+  g_return_val_if_fail (self != NULL, NULL);
+
+  GVariant *visits = g_variant_new_fixed_array (G_VARIANT_TYPE_UINT64,
+                                                self->visits,
+                                                self->states_count,
+                                                sizeof (guint64));
+  GVariant *transitions = g_variant_new_fixed_array (G_VARIANT_TYPE_UINT64,
+                                                     self->transitions,
+                                                     (gsize) self->states_count * self->classes_count,
+                                                     sizeof (guint64));
+  g_autoptr (GVariant) serialized_profile = g_variant_ref_sink (g_variant_new ("(uu@at@at)",
+                                                                               self->states_count,
+                                                                               self->classes_count,
+                                                                               visits,
+                                                                               transitions));
+
+  return g_variant_print (serialized_profile, TRUE);
+}
+
+DfaProfile *
+dfa_profile_deserialize (const gchar *serialized_profile)
+{
+  g_return_val_if_fail (serialized_profile != NULL, NULL);
+
+  g_autoptr (GVariant) parsed_profile = g_variant_parse (G_VARIANT_TYPE (DFA_PROFILE_FORMAT),
+                                                         serialized_profile,
+                                                         NULL,
+                                                         NULL,
+                                                         NULL);
+
+  if (parsed_profile == NULL)
+    return NULL;
+
+  guint states_count = 0, classes_count = 0;
+  g_autoptr (GVariant) visits = NULL;
+  g_autoptr (GVariant) transitions = NULL;
+  gsize visits_count = 0, transitions_count = 0;
+
+  g_variant_get (parsed_profile,
+                 "(uu@at@at)",
+                 &states_count,
+                 &classes_count,
+                 &visits,
+                 &transitions);
+
+  const guint64 *visits_data = g_variant_get_fixed_array (visits, &visits_count, sizeof (guint64));
+  const guint64 *transitions_data = g_variant_get_fixed_array (transitions, &transitions_count, sizeof (guint64));
+
+  /* Both of the counts must match the table's dimensions. */
+  if (visits_count != states_count || transitions_count != (gsize) states_count * classes_count)
+    return NULL;
+
+  DfaProfile *profile = dfa_profile_new (states_count, classes_count);
+
+  if (visits_count != 0)
+    memcpy (profile->visits, visits_data, sizeof (guint64) * visits_count);
+
+  if (transitions_count != 0)
+    memcpy (profile->transitions, transitions_data, sizeof (guint64) * transitions_count);
+
+  return profile;
+}
+
+gsize
+dfa_profile_measure (const DfaProfile *self)
+{
+  g_return_val_if_fail (self != NULL, 0);
+
+  return sizeof (DfaProfile) +
+         sizeof (guint64) * self->states_count +
+         sizeof (guint64) * self->states_count * self->classes_count;
+}
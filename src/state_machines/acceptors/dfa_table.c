@@ -0,0 +1,362 @@
+#include "internal/state_machines/acceptors/dfa_table.h"
+#include "internal/state_machines/fsm_initializable.h"
+#include "internal/state_machines/transitions/deterministic_transition.h"
+#include "internal/common/helpers.h"
+
+static guint dfa_table_fetch_output_state (State         *state,
+                                           gchar          expected_character,
+                                           GHashTable    *state_indices,
+                                           guint          dead);
+
+static void  dfa_table_place_states       (DfaTable      *self,
+                                           const guint64 *visits,
+                                           const guint64 *transitions,
+                                           guint         *order,
+                                           gboolean      *is_placed);
+
+static gint  dfa_table_compare_counts     (gconstpointer  a,
+                                           gconstpointer  b,
+                                           gpointer       user_data);
+
+DfaTable *
+dfa_table_new (Dfa *dfa)
+{
+  g_return_val_if_fail (ACCEPTORS_IS_DFA (dfa), NULL);
+
+  GSList *alphabet = NULL;
+  g_autoptr (GPtrArray) all_states = NULL;
+  g_autoptr (State) start_state = NULL;
+
+  g_object_get (dfa,
+                PROP_FSM_INITIALIZABLE_ALPHABET, &alphabet,
+                PROP_FSM_INITIALIZABLE_ALL_STATES, &all_states,
+                PROP_FSM_INITIALIZABLE_START_STATE, &start_state,
+                NULL);
+
+  DfaTable *table = g_new0 (DfaTable, 1);
+  g_autoptr (GHashTable) state_indices = g_hash_table_new (g_direct_hash, g_direct_equal);
+  g_autoptr (GPtrArray) live_states = g_ptr_array_new ();
+  guint alphabet_size = g_slist_length (alphabet);
+
+  /* The DFA's own dead state (if any) is merged with the one every unrecognized character leads to. */
+  for (guint i = 0; i < all_states->len; ++i)
+    {
+      State *state = g_ptr_array_index (all_states, i);
+      gboolean state_is_dead = FALSE;
+
+      g_object_get (state,
+                    PROP_STATE_IS_DEAD, &state_is_dead,
+                    NULL);
+
+      if (!state_is_dead)
+        {
+          g_hash_table_insert (state_indices, state, GUINT_TO_POINTER (live_states->len));
+          g_ptr_array_add (live_states, state);
+        }
+    }
+
+  table->states_count = live_states->len + 1;
+  table->classes_count = alphabet_size + 1;
+  table->dead = live_states->len;
+  table->transitions = g_new (guint, (gsize) table->states_count * table->classes_count);
+  table->finals = g_new0 (gboolean, table->states_count);
+
+  for (guint i = 0; i < G_N_ELEMENTS (table->character_classes); ++i)
+    table->character_classes[i] = alphabet_size;
+
+  guint class = 0;
+
+  for (GSList *iterator = alphabet; iterator != NULL; iterator = iterator->next, ++class)
+    for (guint i = 0; i < G_N_ELEMENTS (table->character_classes); ++i)
+      if (character_set_contains (iterator->data, (gchar) i))
+        table->character_classes[i] = class;
+
+  /* The null terminator is never consumed. */
+  table->character_classes[END_OF_STRING] = alphabet_size;
+
+  for (guint i = 0; i < live_states->len; ++i)
+    {
+      State *state = g_ptr_array_index (live_states, i);
+      guint *row = table->transitions + (gsize) i * table->classes_count;
+      StateTypeFlags state_type_flags = STATE_TYPE_UNDEFINED;
+
+      g_object_get (state,
+                    PROP_STATE_TYPE_FLAGS, &state_type_flags,
+                    NULL);
+
+      table->finals[i] = (state_type_flags & STATE_TYPE_FINAL) != 0;
+
+      /* All of the characters found in the same set of the alphabet lead to the same state. */
+      class = 0;
+
+      for (GSList *iterator = alphabet; iterator != NULL; iterator = iterator->next, ++class)
+        row[class] = dfa_table_fetch_output_state (state,
+                                                   character_set_get_representative (iterator->data),
+                                                   state_indices,
+                                                   table->dead);
+
+      row[alphabet_size] = table->dead;
+    }
+
+  for (guint class = 0; class < table->classes_count; ++class)
+    table->transitions[(gsize) table->dead * table->classes_count + class] = table->dead;
+
+  gpointer start_index = NULL;
+
+  /* The start state itself is dead in case the DFA does not accept anything. */
+  if (g_hash_table_lookup_extended (state_indices, start_state, NULL, &start_index))
+    table->start = GPOINTER_TO_UINT (start_index);
+  else
+    table->start = table->dead;
+
+  return table;
+}
+
+void
+dfa_table_free (DfaTable *self)
+{
+  g_return_if_fail (self != NULL);
+
+  g_free (self->transitions);
+  g_free (self->finals);
+  g_free (self->layout);
+  g_free (self);
+}
+
+void
+dfa_table_apply_profile (DfaTable         *self,
+                         const DfaProfile *profile)
+{
+  g_return_if_fail (self != NULL);
+  g_return_if_fail (profile != NULL);
+  g_return_if_fail (profile->states_count == self->states_count);
+  g_return_if_fail (profile->classes_count == self->classes_count);
+
+  g_autoptr (DfaProfile) renumbered_profile = NULL;
+  g_autofree guint *order = g_new (guint, self->states_count);
+  g_autofree gboolean *is_placed = g_new0 (gboolean, self->states_count);
+
+  /* The profile has to be numbered the same way as the table itself in case it was already renumbered. */
+  if (self->layout != NULL)
+    {
+      g_autofree guint *inverse_layout = g_new (guint, self->states_count);
+
+      for (guint state = 0; state < self->states_count; ++state)
+        inverse_layout[self->layout[state]] = state;
+
+      renumbered_profile = dfa_profile_renumber (profile, inverse_layout);
+      profile = renumbered_profile;
+    }
+
+  dfa_table_place_states (self,
+                          profile->visits,
+                          profile->transitions,
+                          order,
+                          is_placed);
+
+  gsize transitions_count = (gsize) self->states_count * self->classes_count;
+  g_autofree guint *indices = g_new (guint, self->states_count);
+  guint *transitions = g_new (guint, transitions_count);
+  gboolean *finals = g_new0 (gboolean, self->states_count);
+  guint *layout = g_new (guint, self->states_count);
+
+  for (guint index = 0; index < self->states_count; ++index)
+    indices[order[index]] = index;
+
+  for (guint state = 0; state < self->states_count; ++state)
+    {
+      guint index = indices[state];
+      const guint *row = self->transitions + (gsize) state * self->classes_count;
+      guint *renumbered_row = transitions + (gsize) index * self->classes_count;
+
+      for (guint class = 0; class < self->classes_count; ++class)
+        renumbered_row[class] = indices[row[class]];
+
+      finals[index] = self->finals[state];
+      layout[index] = (self->layout != NULL) ? self->layout[state] : state;
+    }
+
+  g_free (self->transitions);
+  g_free (self->finals);
+  g_free (self->layout);
+
+  self->transitions = transitions;
+  self->finals = finals;
+  self->layout = layout;
+  self->start = indices[self->start];
+}
+
+gboolean
+dfa_table_is_anchored_on (const DfaTable *self,
+                          gchar           anchor)
+{
+  g_return_val_if_fail (self != NULL, FALSE);
+
+  if (self->finals[self->start])
+    return FALSE;
+
+  for (guint i = 0; i < G_N_ELEMENTS (self->character_classes); ++i)
+    if ((gchar) i != anchor && dfa_table_step (self, self->start, (gchar) i) != self->dead)
+      return FALSE;
+
+  return TRUE;
+}
+
+gboolean
+dfa_table_is_idle_unless (const DfaTable *self,
+                          gchar           anchor)
+{
+  g_return_val_if_fail (self != NULL, FALSE);
+
+  if (self->finals[self->start])
+    return FALSE;
+
+  /* Only the bytes found in the input matter, the null terminator is never consumed. */
+  for (guint i = 1; i <= G_MAXUINT8; ++i)
+    if ((gchar) i != anchor && dfa_table_step (self, self->start, (gchar) i) != self->start)
+      return FALSE;
+
+  return TRUE;
+}
+
+gsize
+dfa_table_measure (const DfaTable *self)
+{
+  g_return_val_if_fail (self != NULL, 0);
+
+  gsize bytes = sizeof (DfaTable) +
+                sizeof (guint) * self->states_count * self->classes_count +
+                sizeof (gboolean) * self->states_count;
+
+  if (self->layout != NULL)
+    bytes += sizeof (guint) * self->states_count;
+
+  return bytes;
+}
+
+static guint
+dfa_table_fetch_output_state (State      *state,
+                              gchar       expected_character,
+                              GHashTable *state_indices,
+                              guint       dead)
+{
+  g_autoptr (GPtrArray) transitions = NULL;
+
+  g_object_get (state,
+                PROP_STATE_TRANSITIONS, &transitions,
+                NULL);
+
+  if (!g_collection_has_items (transitions))
+    return dead;
+
+  /* Mirroring the DFA's own run - the first allowed transition is the one being taken. */
+  for (guint i = 0; i < transitions->len; ++i)
+    {
+      Transition *transition = g_ptr_array_index (transitions, i);
+
+      if (transition_is_allowed (transition, expected_character))
+        {
+          g_autoptr (State) output_state = NULL;
+          gpointer index = NULL;
+
+          g_object_get (transition,
+                        PROP_DETERMINISTIC_TRANSITION_OUTPUT_STATE, &output_state,
+                        NULL);
+
+          if (output_state != NULL &&
+              g_hash_table_lookup_extended (state_indices, output_state, NULL, &index))
+            return GPOINTER_TO_UINT (index);
+
+          return dead;
+        }
+    }
+
+  return dead;
+}
+
+static void
+dfa_table_place_states (DfaTable      *self,
+                        const guint64 *visits,
+                        const guint64 *transitions,
+                        guint         *order,
+                        gboolean      *is_placed)
+{
+  g_autoptr (GArray) classes = g_array_sized_new (FALSE, FALSE, sizeof (guint), self->classes_count);
+  guint placed_count = 0;
+
+  /* The dead state is always found right after the remaining ones. */
+  is_placed[self->dead] = TRUE;
+
+  /* The placed states double as the queue of the breadth-first traversal, the visited states are traversed
+   * first (only along the transitions that were actually taken, the most frequent ones first).
+   */
+  if (visits[self->start] != 0)
+    {
+      is_placed[self->start] = TRUE;
+      order[placed_count++] = self->start;
+    }
+
+  for (guint i = 0; i < placed_count; ++i)
+    {
+      guint state = order[i];
+      const guint64 *counts = transitions + (gsize) state * self->classes_count;
+
+      g_array_set_size (classes, 0);
+
+      for (guint class = 0; class < self->classes_count; ++class)
+        if (counts[class] != 0)
+          g_array_append_val (classes, class);
+
+      g_array_sort_with_data (classes, dfa_table_compare_counts, (gpointer) counts);
+
+      for (guint j = 0; j < classes->len; ++j)
+        {
+          guint class = g_array_index (classes, guint, j);
+          guint next_state = self->transitions[(gsize) state * self->classes_count + class];
+
+          if (!is_placed[next_state] && visits[next_state] != 0)
+            {
+              is_placed[next_state] = TRUE;
+              order[placed_count++] = next_state;
+            }
+        }
+    }
+
+  /* The states that were never visited follow in breadth-first order as well, unreachable ones (if any) last. */
+  if (!is_placed[self->start])
+    {
+      is_placed[self->start] = TRUE;
+      order[placed_count++] = self->start;
+    }
+
+  for (guint i = 0; i < placed_count; ++i)
+    for (guint class = 0; class < self->classes_count; ++class)
+      {
+        guint next_state = self->transitions[(gsize) order[i] * self->classes_count + class];
+
+        if (!is_placed[next_state])
+          {
+            is_placed[next_state] = TRUE;
+            order[placed_count++] = next_state;
+          }
+      }
+
+  for (guint state = 0; state < self->states_count; ++state)
+    if (!is_placed[state])
+      order[placed_count++] = state;
+
+  order[placed_count] = self->dead;
+}
+
+static gint
+dfa_table_compare_counts (gconstpointer a,
+                          gconstpointer b,
+                          gpointer      user_data)
+{
+  const guint64 *counts = user_data;
+  guint64 first_count = counts[*(const guint *) a];
+  guint64 second_count = counts[*(const guint *) b];
+
+  /* Descending order. */
+  return (first_count < second_count) - (first_count > second_count);
+}
@@ -33,14 +33,16 @@ static void epsilon_nfa_get_property (GObject    *object,
 
 static void            epsilon_nfa_fsm_convertible_interface_init          (FsmConvertibleInterface     *iface);
 
-static FsmConvertible *epsilon_nfa_compute_epsilon_closures                (FsmConvertible              *self);
+static FsmConvertible *epsilon_nfa_compute_epsilon_closures                (FsmConvertible              *self,
+                                                                            CompilationBudget           *budget);
 
-static FsmModifiable  *epsilon_nfa_construct_subset                        (FsmConvertible              *self);
+static FsmModifiable  *epsilon_nfa_construct_subset                        (FsmConvertible              *self,
+                                                                            CompilationBudget           *budget);
 
 static gboolean        epsilon_nfa_has_epsilon_transitions                 (GPtrArray                   *all_states);
 
 static Transition     *epsilon_nfa_build_epsilon_closed_transition         (State                       *state,
-                                                                            gchar                        explicit_character,
+                                                                            CharacterSet                *explicit_characters,
                                                                             GHashTable                  *input_output_combinations);
 
 static void            epsilon_nfa_initialize_epsilon_closed_output_states (GPtrArray                   *input_states,
@@ -120,7 +122,8 @@ epsilon_nfa_get_property (GObject    *object,
 }
 
 static FsmConvertible *
-epsilon_nfa_compute_epsilon_closures (FsmConvertible *self)
+epsilon_nfa_compute_epsilon_closures (FsmConvertible    *self,
+                                      CompilationBudget *budget)
 {
   g_return_val_if_fail (ACCEPTORS_IS_EPSILON_NFA (self), NULL);
 
@@ -132,12 +135,15 @@ epsilon_nfa_compute_epsilon_closures (FsmConvertible *self)
                 PROP_FSM_INITIALIZABLE_ALL_STATES, &all_states,
                 NULL);
 
+  /* The resulting NFA reuses all of the states, only their transitions are replaced. */
+  if (!compilation_budget_allows_states (budget, all_states->len))
+    return NULL;
+
   /* Performing the computations only if there is an actual need to do so - i.e., the state machine contains
    * at least one epsilon transition.
    */
   if (epsilon_nfa_has_epsilon_transitions (all_states))
     {
-      guint alphabet_length = g_slist_length (alphabet);
       g_autoptr (GHashTable) input_output_combinations = g_hash_table_new_full (g_str_hash,
                                                                                 g_str_equal,
                                                                                 g_free,
@@ -148,12 +154,12 @@ epsilon_nfa_compute_epsilon_closures (FsmConvertible *self)
           State *state = g_ptr_array_index (all_states, i);
           g_autoptr (GPtrArray) nfa_transitions = NULL;
 
-          for (guint j = 0; j < alphabet_length; ++j)
+          for (GSList *iterator = alphabet; iterator != NULL; iterator = iterator->next)
             {
-              gchar expected_character = (gchar) GPOINTER_TO_INT (g_slist_nth_data (alphabet, j));
+              CharacterSet *expected_characters = iterator->data;
               Transition *epsilon_closed_transition =
                 epsilon_nfa_build_epsilon_closed_transition (state,
-                                                             expected_character,
+                                                             expected_characters,
                                                              input_output_combinations);
 
               if (epsilon_closed_transition != NULL)
@@ -165,6 +171,10 @@ epsilon_nfa_compute_epsilon_closures (FsmConvertible *self)
                 }
             }
 
+          /* Giving up as soon as the budget is exceeded, the states are discarded along with the epsilon-NFA. */
+          if (!compilation_budget_charge (budget, 1, nfa_transitions != NULL ? nfa_transitions->len : 0))
+            return NULL;
+
           g_object_set (state,
                         PROP_STATE_TRANSITIONS, nfa_transitions,
                         NULL);
@@ -175,7 +185,8 @@ epsilon_nfa_compute_epsilon_closures (FsmConvertible *self)
 }
 
 static FsmModifiable *
-epsilon_nfa_construct_subset (FsmConvertible *self)
+epsilon_nfa_construct_subset (FsmConvertible    *self,
+                              CompilationBudget *budget)
 {
   g_return_val_if_fail (ACCEPTORS_IS_EPSILON_NFA (self), NULL);
   g_return_val_if_reached (NULL);
@@ -209,10 +220,12 @@ epsilon_nfa_has_epsilon_transitions (GPtrArray *all_states)
 }
 
 static Transition *
-epsilon_nfa_build_epsilon_closed_transition (State      *state,
-                                             gchar       explicit_character,
-                                             GHashTable *input_output_combinations)
+epsilon_nfa_build_epsilon_closed_transition (State        *state,
+                                             CharacterSet *explicit_characters,
+                                             GHashTable   *input_output_combinations)
 {
+  /* Every character found in the same set of the alphabet leads to the same output states. */
+  gchar explicit_character = character_set_get_representative (explicit_characters);
   g_autoptr (GPtrArray) initial_input_states = g_ptr_array_new ();
   g_autoptr (GPtrArray) visited_states = g_ptr_array_new ();
   g_autoptr (GPtrArray) epsilon_closed_transition_output_states = NULL;
@@ -234,13 +247,13 @@ epsilon_nfa_build_epsilon_closed_transition (State      *state,
         {
           State *epsilon_closed_transition_output_state = g_ptr_array_index (epsilon_closed_transition_output_states, 0);
 
-          return create_deterministic_transition (explicit_character,
-                                                  epsilon_closed_transition_output_state);
+          return create_deterministic_set_transition (explicit_characters,
+                                                      epsilon_closed_transition_output_state);
         }
       else
         {
-          return create_nondeterministic_transition (explicit_character,
-                                                     epsilon_closed_transition_output_states);
+          return create_nondeterministic_set_transition (explicit_characters,
+                                                         epsilon_closed_transition_output_states);
         }
     }
 
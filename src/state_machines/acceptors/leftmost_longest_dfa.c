@@ -0,0 +1,392 @@
+#include "internal/state_machines/acceptors/leftmost_longest_dfa.h"
+#include "internal/state_machines/acceptors/acceptor_runnable.h"
+#include "internal/state_machines/acceptors/dfa_table.h"
+#include "internal/state_machines/transitions/transition.h"
+#include "internal/common/helpers.h"
+#include "core/match.h"
+
+#include <string.h>
+
+struct _LeftmostLongestDfa
+{
+  GObject parent_instance;
+};
+
+/* The reverse DFA is run backwards over the whole input once, marking every position at which a match
+ * begins. The forward DFA is then only run from the marked positions - it never starts a run that cannot
+ * succeed, so inputs consisting mostly of near misses are not rescanned.
+ */
+typedef struct
+{
+  Dfa      *forward_dfa;
+  Dfa      *reverse_dfa;
+
+  DfaTable *forward_table;
+  DfaTable *reverse_table;
+  gboolean  is_start_anchored;
+  gboolean  is_end_anchored;
+  gboolean  is_input_exhausted;
+} LeftmostLongestDfaPrivate;
+
+enum
+{
+  PROP_FORWARD_DFA = 1,
+  PROP_REVERSE_DFA,
+  N_PROPERTIES
+};
+
+static GParamSpec *obj_properties[N_PROPERTIES] = { NULL };
+
+static void       leftmost_longest_dfa_acceptor_runnable_interface_init (AcceptorRunnableInterface *iface);
+
+static void       leftmost_longest_dfa_constructed                      (GObject                   *object);
+
+static GPtrArray *leftmost_longest_dfa_run                              (AcceptorRunnable          *self,
+                                                                         const gchar               *input,
+                                                                         MatchCounters             *counters);
+
+static gboolean   leftmost_longest_dfa_can_accept                       (AcceptorRunnable          *self);
+
+static void       leftmost_longest_dfa_measure                          (AcceptorRunnable          *self,
+                                                                         AutomatonStats            *stats);
+
+static gboolean  *leftmost_longest_dfa_find_match_beginnings            (LeftmostLongestDfaPrivate *priv,
+                                                                         const gchar               *input,
+                                                                         guint                      length,
+                                                                         MatchCounters             *counters);
+
+static gboolean   leftmost_longest_dfa_find_match_end                   (LeftmostLongestDfaPrivate *priv,
+                                                                         const gchar               *input,
+                                                                         guint                      begin,
+                                                                         guint                     *end,
+                                                                         MatchCounters             *counters);
+
+static void       leftmost_longest_dfa_set_property                     (GObject                   *object,
+                                                                         guint                      property_id,
+                                                                         const GValue              *value,
+                                                                         GParamSpec                *pspec);
+
+static void       leftmost_longest_dfa_dispose                          (GObject                   *object);
+
+G_DEFINE_TYPE_WITH_CODE (LeftmostLongestDfa, leftmost_longest_dfa, G_TYPE_OBJECT,
+                         G_ADD_PRIVATE (LeftmostLongestDfa)
+                         G_IMPLEMENT_INTERFACE (ACCEPTORS_TYPE_ACCEPTOR_RUNNABLE,
+                                                leftmost_longest_dfa_acceptor_runnable_interface_init))
+
+static void
+leftmost_longest_dfa_class_init (LeftmostLongestDfaClass *klass)
+{
+  GObjectClass *object_class = G_OBJECT_CLASS (klass);
+
+  object_class->constructed = leftmost_longest_dfa_constructed;
+  object_class->set_property = leftmost_longest_dfa_set_property;
+  object_class->dispose = leftmost_longest_dfa_dispose;
+
+  obj_properties[PROP_FORWARD_DFA] =
+    g_param_spec_object (PROP_LEFTMOST_LONGEST_DFA_FORWARD_DFA,
+                         "Forward DFA",
+                         "DFA which accepts the expression starting from the position it is run from.",
+                         ACCEPTORS_TYPE_DFA,
+                         G_PARAM_CONSTRUCT_ONLY | G_PARAM_WRITABLE);
+
+  obj_properties[PROP_REVERSE_DFA] =
+    g_param_spec_object (PROP_LEFTMOST_LONGEST_DFA_REVERSE_DFA,
+                         "Reverse DFA",
+                         "DFA which accepts any string ending with the reversed expression.",
+                         ACCEPTORS_TYPE_DFA,
+                         G_PARAM_CONSTRUCT_ONLY | G_PARAM_WRITABLE);
+
+  g_object_class_install_properties (object_class,
+                                     N_PROPERTIES,
+                                     obj_properties);
+}
+
+static void
+leftmost_longest_dfa_init (LeftmostLongestDfa *self)
+{
+  /* NOP */
+}
+
+static void
+leftmost_longest_dfa_acceptor_runnable_interface_init (AcceptorRunnableInterface *iface)
+{
+  iface->run = leftmost_longest_dfa_run;
+  iface->can_accept = leftmost_longest_dfa_can_accept;
+  iface->measure = leftmost_longest_dfa_measure;
+}
+
+static void
+leftmost_longest_dfa_constructed (GObject *object)
+{
+  LeftmostLongestDfaPrivate *priv = leftmost_longest_dfa_get_instance_private (ACCEPTORS_LEFTMOST_LONGEST_DFA (object));
+
+  /* Only the flattened tables are needed from now on. */
+  priv->forward_table = dfa_table_new (priv->forward_dfa);
+  priv->reverse_table = dfa_table_new (priv->reverse_dfa);
+
+  g_clear_object (&priv->forward_dfa);
+  g_clear_object (&priv->reverse_dfa);
+
+  /* A start-anchored expression can only match at a start of text character (no reverse scan is needed
+   * in that case), an end-anchored one can only match up to an end of text character.
+   */
+  priv->is_start_anchored = dfa_table_is_anchored_on (priv->forward_table, START);
+  priv->is_end_anchored = dfa_table_is_idle_unless (priv->reverse_table, END);
+
+  G_OBJECT_CLASS (leftmost_longest_dfa_parent_class)->constructed (object);
+}
+
+static GPtrArray *
+leftmost_longest_dfa_run (AcceptorRunnable *self,
+                          const gchar      *input,
+                          MatchCounters    *counters)
+{
+  g_return_val_if_fail (ACCEPTORS_IS_LEFTMOST_LONGEST_DFA (self), NULL);
+  g_return_val_if_fail (input != NULL, NULL);
+
+  LeftmostLongestDfaPrivate *priv = leftmost_longest_dfa_get_instance_private (ACCEPTORS_LEFTMOST_LONGEST_DFA (self));
+  /* The backward pass starts at the end of the input, which has to be found first - the start and end of text
+   * characters are not copied around the input, its length includes them nevertheless.
+   */
+  guint length = (guint) strlen (input) + 2;
+  MatchCounters run_counters = { 0 };
+  g_autofree gboolean *match_beginnings = leftmost_longest_dfa_find_match_beginnings (priv,
+                                                                                      input,
+                                                                                      length,
+                                                                                      &run_counters);
+  guint position = 0;
+  GPtrArray *matches = NULL;
+
+  while (position < length)
+    {
+      if (!match_beginnings[position])
+        {
+          position++;
+
+          continue;
+        }
+
+      guint begin = position, end = position;
+      g_autoptr (GString) match_value = NULL;
+      guint match_range_begin = 0, match_range_end = 0;
+
+      /* The reverse DFA's sets of the alphabet may be coarser than the forward one's, each beginning
+       * is therefore confirmed by the forward DFA.
+       */
+      if (!leftmost_longest_dfa_find_match_end (priv, input, begin, &end, &run_counters))
+        {
+          position++;
+        }
+      else if (end > begin)
+        {
+          match_value = acceptor_runnable_input_copy (input, begin, end);
+          match_range_begin = begin - 1;
+          match_range_end = end - 1;
+
+          position = end;
+        }
+      else
+        {
+          /* Ignoring empty matches that are a result of the start and end of text special characters. */
+          gboolean is_valid_empty_match =
+            (acceptor_runnable_input_at (input, begin) != START &&
+             (begin == 0 || acceptor_runnable_input_at (input, begin - 1) != END));
+
+          if (is_valid_empty_match)
+            {
+              match_value = g_string_new (EMPTY_STRING);
+              match_range_begin = match_range_end = begin - 1;
+            }
+
+          position++;
+        }
+
+      /* Adding a new match if possible. */
+      if (match_value != NULL)
+        {
+          if (matches == NULL)
+            matches = g_ptr_array_new_with_free_func (g_object_unref);
+
+          Match *match = match_new (PROP_MATCH_VALUE, match_value,
+                                    PROP_MATCH_RANGE_BEGIN, match_range_begin,
+                                    PROP_MATCH_RANGE_END, match_range_end);
+
+          g_ptr_array_add (matches, match);
+
+          run_counters.matches++;
+
+          if (match_value->len == 0)
+            run_counters.empty_matches++;
+        }
+    }
+
+  if (counters != NULL)
+    match_counters_add (counters, &run_counters);
+
+  priv->is_input_exhausted = TRUE;
+
+  return matches;
+}
+
+static gboolean
+leftmost_longest_dfa_can_accept (AcceptorRunnable *self)
+{
+  g_return_val_if_fail (ACCEPTORS_IS_LEFTMOST_LONGEST_DFA (self), FALSE);
+
+  LeftmostLongestDfaPrivate *priv = leftmost_longest_dfa_get_instance_private (ACCEPTORS_LEFTMOST_LONGEST_DFA (self));
+
+  return priv->is_input_exhausted;
+}
+
+static void
+leftmost_longest_dfa_measure (AcceptorRunnable *self,
+                              AutomatonStats   *stats)
+{
+  g_return_if_fail (ACCEPTORS_IS_LEFTMOST_LONGEST_DFA (self));
+
+  LeftmostLongestDfaPrivate *priv = leftmost_longest_dfa_get_instance_private (ACCEPTORS_LEFTMOST_LONGEST_DFA (self));
+  const DfaTable *forward_table = priv->forward_table;
+  const DfaTable *reverse_table = priv->reverse_table;
+
+  /* Both of the DFAs only exist as tables (each one of which has its dead state), the alphabet is the forward one's. */
+  stats->states_count = forward_table->states_count + reverse_table->states_count;
+  stats->transitions_count = forward_table->states_count * forward_table->classes_count +
+                             reverse_table->states_count * reverse_table->classes_count;
+  stats->alphabet_size = forward_table->classes_count;
+  stats->has_dead_state = TRUE;
+  stats->bytes = g_object_get_instance_size (self) +
+                 dfa_table_measure (forward_table) +
+                 dfa_table_measure (reverse_table);
+}
+
+static gboolean *
+leftmost_longest_dfa_find_match_beginnings (LeftmostLongestDfaPrivate *priv,
+                                            const gchar               *input,
+                                            guint                      length,
+                                            MatchCounters             *counters)
+{
+  const DfaTable *table = priv->reverse_table;
+  gboolean *match_beginnings = g_new0 (gboolean, length + 1);
+  guint state = table->start;
+
+  if (priv->is_start_anchored)
+    {
+      for (guint position = 0; position < length; ++position)
+        match_beginnings[position] = (acceptor_runnable_input_at (input, position) == START);
+
+      counters->skips++;
+
+      return match_beginnings;
+    }
+
+  /* The end of text character is always found at the end of the input, at the latest. */
+  const gchar *end_of_text = strchr (input, END);
+  guint first_end_of_text = (end_of_text != NULL) ? (guint) (end_of_text - input) + 1 : length - 1;
+
+  /* The reverse DFA's state after consuming the input from its end down to a position is final
+   * only if a match begins at that position.
+   */
+  for (guint position = length; position > 0; --position)
+    {
+      state = dfa_table_step (table, state, acceptor_runnable_input_at (input, position - 1));
+      counters->bytes_scanned++;
+
+      if (state == table->dead)
+        {
+          counters->dead_transitions++;
+
+          break;
+        }
+
+      match_beginnings[position - 1] = table->finals[state];
+
+      /* Scanning backwards from the end is over once the reverse DFA of an end-anchored expression is back
+       * in its start state and no other end of text character is left.
+       */
+      if (priv->is_end_anchored && state == table->start && position - 1 <= first_end_of_text)
+        {
+          counters->skips++;
+
+          break;
+        }
+    }
+
+  return match_beginnings;
+}
+
+static gboolean
+leftmost_longest_dfa_find_match_end (LeftmostLongestDfaPrivate *priv,
+                                     const gchar               *input,
+                                     guint                      begin,
+                                     guint                     *end,
+                                     MatchCounters             *counters)
+{
+  const DfaTable *table = priv->forward_table;
+  guint state = table->start;
+  gboolean is_matched = table->finals[state];
+
+  /* Remembering the last position at which the forward DFA was in a final state, the run itself
+   * continues until the DFA dies (or the input is exhausted).
+   */
+  for (guint position = begin; acceptor_runnable_input_at (input, position) != END_OF_STRING; ++position)
+    {
+      state = dfa_table_step (table, state, acceptor_runnable_input_at (input, position));
+      counters->bytes_scanned++;
+
+      if (state == table->dead)
+        {
+          counters->dead_transitions++;
+
+          if (position != begin)
+            counters->resets++;
+
+          break;
+        }
+
+      if (table->finals[state])
+        {
+          *end = position + 1;
+          is_matched = TRUE;
+        }
+    }
+
+  return is_matched;
+}
+
+static void
+leftmost_longest_dfa_set_property (GObject      *object,
+                                   guint         property_id,
+                                   const GValue *value,
+                                   GParamSpec   *pspec)
+{
+  LeftmostLongestDfaPrivate *priv = leftmost_longest_dfa_get_instance_private (ACCEPTORS_LEFTMOST_LONGEST_DFA (object));
+
+  switch (property_id)
+    {
+    case PROP_FORWARD_DFA:
+      priv->forward_dfa = g_value_dup_object (value);
+      break;
+
+    case PROP_REVERSE_DFA:
+      priv->reverse_dfa = g_value_dup_object (value);
+      break;
+
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
+      break;
+    }
+}
+
+static void
+leftmost_longest_dfa_dispose (GObject *object)
+{
+  LeftmostLongestDfaPrivate *priv = leftmost_longest_dfa_get_instance_private (ACCEPTORS_LEFTMOST_LONGEST_DFA (object));
+
+  if (priv->forward_table != NULL)
+    g_clear_pointer (&priv->forward_table, dfa_table_free);
+
+  if (priv->reverse_table != NULL)
+    g_clear_pointer (&priv->reverse_table, dfa_table_free);
+
+  G_OBJECT_CLASS (leftmost_longest_dfa_parent_class)->dispose (object);
+}
@@ -1,44 +1,124 @@
 #include "internal/state_machines/acceptors/nfa.h"
 #include "internal/state_machines/acceptors/dfa.h"
+#include "internal/state_machines/acceptors/acceptor_runnable.h"
 #include "internal/state_machines/fsm_initializable.h"
 #include "internal/state_machines/fsm_convertible.h"
 #include "internal/state_machines/transitions/transition_factory.h"
 #include "internal/common/helpers.h"
+#include "internal/common/trace.h"
+#include "core/match.h"
+
+#define NFA_NO_CHARACTER_CLASS G_MAXUINT
 
 struct _Nfa
 {
   Fsm parent_instance;
 };
 
+/* Sparse set of state indices - both the insertion and the membership test take constant time
+ * while clearing it takes no time at all.
+ */
+typedef struct
+{
+  guint *dense;
+  guint *sparse;
+  guint  count;
+} NfaStateList;
+
+/* Compact representation of the NFA used for its direct simulation. The output states of each state
+ * on each set of the alphabet (character class) are found in the targets array between two subsequent
+ * offsets, the character classes of all possible input characters are precomputed as well.
+ */
+typedef struct
+{
+  gboolean      is_prepared;
+  guint         states_count;
+  guint         classes_count;
+  guint         start;
+  gboolean     *finals;
+  guint        *offsets;
+  guint        *targets;
+  guint         character_classes[G_MAXUINT8 + 1];
+  gboolean      is_start_anchored;
+  gboolean      is_input_exhausted;
+} NfaPrivate;
+
 static void            nfa_fsm_convertible_interface_init   (FsmConvertibleInterface *iface);
 
-static FsmConvertible *nfa_compute_epsilon_closures         (FsmConvertible          *self);
+static void            nfa_acceptor_runnable_interface_init (AcceptorRunnableInterface *iface);
 
-static FsmModifiable  *nfa_construct_subset                 (FsmConvertible          *self);
+static FsmConvertible *nfa_compute_epsilon_closures         (FsmConvertible          *self,
+                                                             CompilationBudget       *budget);
 
-static void            nfa_define_dfa_states_from_scalar    (State                   *input_state,
-                                                             GSList                  *alphabet,
-                                                             GPtrArray               *dfa_states);
+static FsmModifiable  *nfa_construct_subset                 (FsmConvertible          *self,
+                                                             CompilationBudget       *budget);
+
+static gboolean        nfa_can_define_dfa_state             (GSList                  *alphabet,
+                                                             GPtrArray               *dfa_states,
+                                                             CompilationBudget       *budget);
 
 static void            nfa_define_dfa_states_from_composite (State                   *input_state,
                                                              GPtrArray               *composed_from_states,
                                                              GSList                  *alphabet,
-                                                             GPtrArray               *dfa_states);
+                                                             GPtrArray               *dfa_states,
+                                                             CompilationBudget       *budget);
 
 static void            nfa_define_transitions_for_dfa_state (GPtrArray               *output_states,
                                                              GSList                  *alphabet,
-                                                             gchar                    expected_character,
+                                                             CharacterSet            *expected_characters,
                                                              GPtrArray               *dfa_states,
-                                                             GPtrArray               *dfa_transitions);
+                                                             GPtrArray               *dfa_transitions,
+                                                             CompilationBudget       *budget);
+
+static GPtrArray      *nfa_run                              (AcceptorRunnable        *self,
+                                                             const gchar             *input,
+                                                             MatchCounters           *counters);
+
+static gboolean        nfa_can_accept                       (AcceptorRunnable        *self);
+
+static void            nfa_measure                          (AcceptorRunnable        *self,
+                                                             AutomatonStats          *stats);
+
+static void            nfa_prepare_simulation               (Nfa                     *self);
+
+static void            nfa_prune_dead_states                (NfaPrivate              *priv);
+
+static gboolean        nfa_is_start_anchored                (NfaPrivate              *priv);
+
+static void            nfa_step                             (NfaPrivate              *priv,
+                                                             NfaStateList            *current_states,
+                                                             NfaStateList            *next_states,
+                                                             gchar                    input_character);
+
+static gboolean        nfa_state_list_has_final             (NfaPrivate              *priv,
+                                                             NfaStateList            *state_list);
+
+static void            nfa_state_list_init                  (NfaStateList            *state_list,
+                                                             guint                    states_count);
+
+static void            nfa_state_list_clear                 (NfaStateList            *state_list);
+
+static void            nfa_state_list_reset                 (NfaStateList            *state_list,
+                                                             guint                    state);
+
+static void            nfa_state_list_add                   (NfaStateList            *state_list,
+                                                             guint                    state);
+
+static void            nfa_dispose                          (GObject                 *object);
 
 G_DEFINE_TYPE_WITH_CODE (Nfa, nfa, STATE_MACHINES_TYPE_FSM,
+                         G_ADD_PRIVATE (Nfa)
                          G_IMPLEMENT_INTERFACE (STATE_MACHINES_TYPE_FSM_CONVERTIBLE,
-                                                nfa_fsm_convertible_interface_init))
+                                                nfa_fsm_convertible_interface_init)
+                         G_IMPLEMENT_INTERFACE (ACCEPTORS_TYPE_ACCEPTOR_RUNNABLE,
+                                                nfa_acceptor_runnable_interface_init))
 
 static void
 nfa_class_init (NfaClass *klass)
 {
-  /* NOP */
+  GObjectClass *object_class = G_OBJECT_CLASS (klass);
+
+  object_class->dispose = nfa_dispose;
 }
 
 static void
@@ -54,20 +134,31 @@ nfa_fsm_convertible_interface_init (FsmConvertibleInterface *iface)
   iface->construct_subset = nfa_construct_subset;
 }
 
+static void
+nfa_acceptor_runnable_interface_init (AcceptorRunnableInterface *iface)
+{
+  iface->run = nfa_run;
+  iface->can_accept = nfa_can_accept;
+  iface->measure = nfa_measure;
+}
+
 static FsmConvertible *
-nfa_compute_epsilon_closures (FsmConvertible *self)
+nfa_compute_epsilon_closures (FsmConvertible    *self,
+                              CompilationBudget *budget)
 {
   g_return_val_if_fail (ACCEPTORS_IS_NFA (self), NULL);
   g_return_val_if_reached (NULL);
 }
 
 static FsmModifiable *
-nfa_construct_subset (FsmConvertible *self)
+nfa_construct_subset (FsmConvertible    *self,
+                      CompilationBudget *budget)
 {
   g_return_val_if_fail (ACCEPTORS_IS_NFA (self), NULL);
 
   GSList *alphabet = NULL;
   g_autoptr (State) start_state = NULL;
+  g_autoptr (GPtrArray) start_states = g_ptr_array_new ();
   g_autoptr (GPtrArray) dfa_states = g_ptr_array_new_with_free_func (g_object_unref);
 
   g_object_get (self,
@@ -75,55 +166,60 @@ nfa_construct_subset (FsmConvertible *self)
                 PROP_FSM_INITIALIZABLE_START_STATE, &start_state,
                 NULL);
 
-  /* Beginning the conversion using the NFA's start state. */
-  nfa_define_dfa_states_from_scalar (start_state,
-                                     alphabet,
-                                     dfa_states);
-
-  return dfa_new (PROP_FSM_INITIALIZABLE_ALL_STATES, dfa_states);
-}
+  g_ptr_array_add (start_states, start_state);
 
-static void
-nfa_define_dfa_states_from_scalar (State     *input_state,
-                                   GSList    *alphabet,
-                                   GPtrArray *dfa_states)
-{
-  /* Increasing the reference count due to the input state actually being a reused NFA state. */
-  g_ptr_array_add (dfa_states, g_object_ref (input_state));
+  /* Beginning the conversion using the NFA's start state. Even a single NFA state is wrapped in a composite
+   * state as its own transitions are still needed while defining the composite states it belongs to.
+   */
+  State *dfa_start_state = fsm_get_or_create_composite_state (dfa_states,
+                                                              start_states,
+                                                              COMPOSITE_STATE_RESOLVE_TYPE_FLAGS_ALL,
+                                                              NULL);
 
-  guint alphabet_length = g_slist_length (alphabet);
-  g_autoptr (GPtrArray) dfa_transitions = g_ptr_array_new_with_free_func (g_object_unref);
+  nfa_define_dfa_states_from_composite (dfa_start_state,
+                                        start_states,
+                                        alphabet,
+                                        dfa_states,
+                                        budget);
 
-  for (guint i = 0; i < alphabet_length; ++i)
-    {
-      gchar expected_character = (gchar) GPOINTER_TO_INT (g_slist_nth_data (alphabet, i));
-      g_autoptr (GPtrArray) output_states = fsm_fetch_output_states_from_single (input_state,
-                                                                                 expected_character);
+  /* A partially constructed DFA is of no use, it is simply discarded. */
+  if (compilation_budget_is_exceeded (budget))
+    return NULL;
 
-      nfa_define_transitions_for_dfa_state (output_states,
-                                            alphabet,
-                                            expected_character,
-                                            dfa_states,
-                                            dfa_transitions);
-    }
+  return dfa_new (PROP_FSM_INITIALIZABLE_ALL_STATES, dfa_states);
+}
 
-  g_object_set (input_state,
-                PROP_STATE_TRANSITIONS, dfa_transitions,
-                NULL);
+static gboolean
+nfa_can_define_dfa_state (GSList            *alphabet,
+                          GPtrArray         *dfa_states,
+                          CompilationBudget *budget)
+{
+  /* Each DFA state is charged along with one transition per set of the alphabet. */
+  return compilation_budget_allows_states (budget, dfa_states->len) &&
+         compilation_budget_charge (budget, 1, g_slist_length (alphabet));
 }
 
 static void
-nfa_define_dfa_states_from_composite (State     *input_state,
-                                      GPtrArray *composed_from_states,
-                                      GSList    *alphabet,
-                                      GPtrArray *dfa_states)
+nfa_define_dfa_states_from_composite (State             *input_state,
+                                      GPtrArray         *composed_from_states,
+                                      GSList            *alphabet,
+                                      GPtrArray         *dfa_states,
+                                      CompilationBudget *budget)
 {
-  guint alphabet_length = g_slist_length (alphabet);
+  if (!nfa_can_define_dfa_state (alphabet, dfa_states, budget))
+    return;
+
+  /* The spans of the states defined from this one are nested in its own span, the depth of the nesting
+   * therefore shows the states which were discovered but not yet defined.
+   */
+  trace_begin ("compile", "dfa state");
+
   g_autoptr (GPtrArray) dfa_transitions = g_ptr_array_new_with_free_func (g_object_unref);
 
-  for (guint i = 0; i < alphabet_length; ++i)
+  for (GSList *iterator = alphabet; iterator != NULL; iterator = iterator->next)
     {
-      gchar expected_character = (gchar) GPOINTER_TO_INT (g_slist_nth_data (alphabet, i));
+      CharacterSet *expected_characters = iterator->data;
+      gchar expected_character = character_set_get_representative (expected_characters);
 
       /* Fetching the union of states that represent the output of each state (on a given input)
        * found in states which were used to construct the composite state.
@@ -134,67 +230,49 @@ nfa_define_dfa_states_from_composite (State     *input_state,
 
       nfa_define_transitions_for_dfa_state (composed_from_states_output_states,
                                             alphabet,
-                                            expected_character,
+                                            expected_characters,
                                             dfa_states,
-                                            dfa_transitions);
+                                            dfa_transitions,
+                                            budget);
     }
 
   g_object_set (input_state,
                 PROP_STATE_TRANSITIONS, dfa_transitions,
                 NULL);
+
+  trace_end ("compile", "dfa state", "\"nfa_states\": %u, \"dfa_states\": %u", composed_from_states->len, dfa_states->len);
 }
 
 static void
-nfa_define_transitions_for_dfa_state (GPtrArray *output_states,
-                                      GSList    *alphabet,
-                                      gchar      expected_character,
-                                      GPtrArray *dfa_states,
-                                      GPtrArray *dfa_transitions)
+nfa_define_transitions_for_dfa_state (GPtrArray         *output_states,
+                                      GSList            *alphabet,
+                                      CharacterSet      *expected_characters,
+                                      GPtrArray         *dfa_states,
+                                      GPtrArray         *dfa_transitions,
+                                      CompilationBudget *budget)
 {
   if (g_collection_has_items (output_states))
     {
-      const guint acceptable_scalar_output_states_count = 1;
-      GEqualFunc state_equal_func = g_direct_equal;
-
-      if (output_states->len == acceptable_scalar_output_states_count)
-        {
-          State *output_state = g_ptr_array_index (output_states, 0);
-          Transition *dfa_transition = create_deterministic_transition (expected_character,
-                                                                        output_state);
-
-          g_ptr_array_add (dfa_transitions, dfa_transition);
-
-          /* Avoid defining states from a scalar state that is already found in states intended for the DFA. */
-          if (!g_ptr_array_find_with_equal_func (dfa_states,
-                                                 output_state,
-                                                 state_equal_func,
-                                                 NULL))
-            nfa_define_dfa_states_from_scalar (output_state,
-                                               alphabet,
-                                               dfa_states);
-        }
-      else
-        {
-          /* Constructing a new composite state or getting an existing one which was constructed
-           * using the exact same output states.
-           */
-          gboolean already_existed = FALSE;
-          State *composite_state = fsm_get_or_create_composite_state (dfa_states,
-                                                                      output_states,
-                                                                      COMPOSITE_STATE_RESOLVE_TYPE_FLAGS_FINAL,
-                                                                      &already_existed);
-          Transition *dfa_transition = create_deterministic_transition (expected_character,
+      /* Constructing a new composite state or getting an existing one which was constructed
+       * using the exact same output states (a single one included, the NFA's states are never reused).
+       */
+      gboolean already_existed = FALSE;
+      State *composite_state = fsm_get_or_create_composite_state (dfa_states,
+                                                                  output_states,
+                                                                  COMPOSITE_STATE_RESOLVE_TYPE_FLAGS_FINAL,
+                                                                  &already_existed);
+      Transition *dfa_transition = create_deterministic_set_transition (expected_characters,
                                                                         composite_state);
 
-          g_ptr_array_add (dfa_transitions, dfa_transition);
+      g_ptr_array_add (dfa_transitions, dfa_transition);
 
-          /* Avoid defining states from a composite state that is already found in states intended for the DFA. */
-          if (!already_existed)
-            nfa_define_dfa_states_from_composite (composite_state,
-                                                  output_states,
-                                                  alphabet,
-                                                  dfa_states);
-        }
+      /* Avoid defining states from a composite state that is already found in states intended for the DFA. */
+      if (!already_existed)
+        nfa_define_dfa_states_from_composite (composite_state,
+                                              output_states,
+                                              alphabet,
+                                              dfa_states,
+                                              budget);
     }
   else
     {
@@ -202,9 +280,481 @@ nfa_define_transitions_for_dfa_state (GPtrArray *output_states,
        * At most one dead state is required for any given state machine.
        */
       State *dead_state = fsm_get_or_create_dead_state (dfa_states);
-      Transition *dfa_transition = create_deterministic_transition (expected_character,
-                                                                    dead_state);
+      Transition *dfa_transition = create_deterministic_set_transition (expected_characters,
+                                                                        dead_state);
 
       g_ptr_array_add (dfa_transitions, dfa_transition);
     }
 }
+
+static GPtrArray *
+nfa_run (AcceptorRunnable *self,
+         const gchar      *input,
+         MatchCounters    *counters)
+{
+  g_return_val_if_fail (ACCEPTORS_IS_NFA (self), NULL);
+  g_return_val_if_fail (input != NULL, NULL);
+
+  Nfa *nfa = ACCEPTORS_NFA (self);
+  NfaPrivate *priv = nfa_get_instance_private (nfa);
+
+  /* The NFA is simulated instead of being converted to a DFA, its compact representation
+   * is therefore computed only once it is actually needed.
+   */
+  if (!priv->is_prepared)
+    nfa_prepare_simulation (nfa);
+
+  guint begin = 0, end = 0;
+  GPtrArray *matches = NULL;
+  MatchCounters run_counters = { 0 };
+
+  /* The state lists are owned by the run itself rather than by the NFA so that its compact
+   * representation is never written to while matching.
+   */
+  NfaStateList current_states, next_states;
+
+  nfa_state_list_init (&current_states, priv->states_count);
+  nfa_state_list_init (&next_states, priv->states_count);
+
+  priv->is_input_exhausted = FALSE;
+
+  nfa_state_list_reset (&current_states, priv->start);
+
+  /* The simulation mirrors the DFA's run exactly - a set of NFA states corresponds to a single
+   * DFA state while the empty set corresponds to the dead state.
+   */
+  while (TRUE)
+    {
+      gchar previous_character = 0;
+      gboolean is_rest_of_input_skipped = FALSE;
+
+      if (end != 0)
+        {
+          previous_character = acceptor_runnable_input_at (input, end - 1);
+
+          if (previous_character == END_OF_STRING)
+            {
+              priv->is_input_exhausted = TRUE;
+
+              break;
+            }
+        }
+
+      gchar current_character = acceptor_runnable_input_at (input, end);
+
+      nfa_step (priv, &current_states, &next_states, current_character);
+
+      gboolean current_states_are_final = nfa_state_list_has_final (priv, &current_states);
+      gboolean next_states_are_dead = (next_states.count == 0);
+      guint distance = end - begin;
+      g_autoptr (GString) match_value = NULL;
+      guint match_range_begin = 0, match_range_end = 0;
+
+      /* Handling empty matches. */
+      if (current_states_are_final)
+        {
+          /* Ignoring empty matches that are a result of the start and end of text special characters. */
+          gboolean is_valid_empty_match =
+            (distance == 0 &&
+             (current_character != START && previous_character != END));
+
+          if (is_valid_empty_match)
+            {
+              match_value = g_string_new (EMPTY_STRING);
+              match_range_begin = match_range_end = end - 1;
+            }
+        }
+
+      /* Handling non-empty matches. */
+      if (next_states_are_dead)
+        {
+          gboolean is_valid_non_empty_match =
+            (distance != 0 && current_states_are_final);
+
+          if (is_valid_non_empty_match)
+            {
+              match_value = acceptor_runnable_input_copy (input, begin, end);
+              match_range_begin = begin - 1;
+              match_range_end = end - 1;
+            }
+
+          /* Moving onto the next character in the input in case no state was reached straight
+           * from the start state without consuming a single character.
+           */
+          if (distance == 0)
+            {
+              end++;
+              run_counters.bytes_scanned++;
+            }
+
+          run_counters.dead_transitions++;
+
+          if (distance != 0)
+            run_counters.resets++;
+
+          /* Preparing for a new run. */
+          begin = end;
+
+          nfa_state_list_reset (&current_states, priv->start);
+
+          /* A start-anchored expression cannot match anywhere else than at a start of text character,
+           * the characters in between are skipped altogether.
+           */
+          if (priv->is_start_anchored)
+            {
+              guint next_start_of_text = acceptor_runnable_input_find (input, end, START);
+
+              if (next_start_of_text != G_MAXUINT)
+                begin = end = next_start_of_text;
+              else
+                is_rest_of_input_skipped = TRUE;
+
+              run_counters.skips++;
+            }
+        }
+      else
+        {
+          NfaStateList previous_states = current_states;
+
+          /* Moving onto the next character in the input in case the NFA can continue with the current run. */
+          current_states = next_states;
+          next_states = previous_states;
+
+          end++;
+          run_counters.bytes_scanned++;
+        }
+
+      /* Adding a new match if possible. */
+      if (match_value != NULL)
+        {
+          if (matches == NULL)
+            matches = g_ptr_array_new_with_free_func (g_object_unref);
+
+          Match *match = match_new (PROP_MATCH_VALUE, match_value,
+                                    PROP_MATCH_RANGE_BEGIN, match_range_begin,
+                                    PROP_MATCH_RANGE_END, match_range_end);
+
+          g_ptr_array_add (matches, match);
+
+          run_counters.matches++;
+
+          if (match_value->len == 0)
+            run_counters.empty_matches++;
+        }
+
+      if (is_rest_of_input_skipped)
+        {
+          priv->is_input_exhausted = TRUE;
+
+          break;
+        }
+    }
+
+  nfa_state_list_clear (&current_states);
+  nfa_state_list_clear (&next_states);
+
+  if (counters != NULL)
+    match_counters_add (counters, &run_counters);
+
+  return matches;
+}
+
+static gboolean
+nfa_can_accept (AcceptorRunnable *self)
+{
+  g_return_val_if_fail (ACCEPTORS_IS_NFA (self), FALSE);
+
+  NfaPrivate *priv = nfa_get_instance_private (ACCEPTORS_NFA (self));
+
+  return priv->is_input_exhausted;
+}
+
+static void
+nfa_measure (AcceptorRunnable *self,
+             AutomatonStats   *stats)
+{
+  g_return_if_fail (ACCEPTORS_IS_NFA (self));
+
+  Nfa *nfa = ACCEPTORS_NFA (self);
+  NfaPrivate *priv = nfa_get_instance_private (nfa);
+
+  /* Same as the DFA's table, the compact representation would have been prepared before the first run. */
+  if (!priv->is_prepared)
+    nfa_prepare_simulation (nfa);
+
+  gsize slots_count = (gsize) priv->states_count * priv->classes_count;
+
+  fsm_measure (STATE_MACHINES_FSM (nfa), stats);
+
+  stats->bytes += sizeof (gboolean) * priv->states_count +
+                  sizeof (guint) * (slots_count + 1) +
+                  sizeof (guint) * priv->offsets[slots_count] +
+                  sizeof (guint) * priv->states_count * 4;
+}
+
+static void
+nfa_prepare_simulation (Nfa *self)
+{
+  NfaPrivate *priv = nfa_get_instance_private (self);
+  GSList *alphabet = NULL;
+  g_autoptr (GPtrArray) all_states = NULL;
+  g_autoptr (State) start_state = NULL;
+
+  g_object_get (self,
+                PROP_FSM_INITIALIZABLE_ALPHABET, &alphabet,
+                PROP_FSM_INITIALIZABLE_ALL_STATES, &all_states,
+                PROP_FSM_INITIALIZABLE_START_STATE, &start_state,
+                NULL);
+
+  guint states_count = all_states->len;
+  guint classes_count = g_slist_length (alphabet);
+  g_autoptr (GHashTable) state_indices = g_hash_table_new (g_direct_hash, g_direct_equal);
+  g_autoptr (GArray) targets = g_array_new (FALSE, FALSE, sizeof (guint));
+
+  for (guint i = 0; i < states_count; ++i)
+    g_hash_table_insert (state_indices,
+                         g_ptr_array_index (all_states, i),
+                         GUINT_TO_POINTER (i));
+
+  /* Characters which do not belong to the alphabet cannot be consumed by any state. */
+  for (guint i = 0; i < G_N_ELEMENTS (priv->character_classes); ++i)
+    priv->character_classes[i] = NFA_NO_CHARACTER_CLASS;
+
+  guint class = 0;
+
+  for (GSList *iterator = alphabet; iterator != NULL; iterator = iterator->next, ++class)
+    for (guint i = 0; i < G_N_ELEMENTS (priv->character_classes); ++i)
+      if (character_set_contains (iterator->data, (gchar) i))
+        priv->character_classes[i] = class;
+
+  priv->finals = g_new0 (gboolean, states_count);
+  priv->offsets = g_new (guint, (gsize) states_count * classes_count + 1);
+
+  for (guint i = 0; i < states_count; ++i)
+    {
+      State *state = g_ptr_array_index (all_states, i);
+      StateTypeFlags state_type_flags = STATE_TYPE_UNDEFINED;
+
+      g_object_get (state,
+                    PROP_STATE_TYPE_FLAGS, &state_type_flags,
+                    NULL);
+
+      priv->finals[i] = (state_type_flags & STATE_TYPE_FINAL) != 0;
+
+      /* Each character found in the same set of the alphabet leads to the same output states,
+       * it is therefore sufficient to check only one of them (just like the subset construction does).
+       */
+      class = 0;
+
+      for (GSList *iterator = alphabet; iterator != NULL; iterator = iterator->next, ++class)
+        {
+          gchar expected_character = character_set_get_representative (iterator->data);
+          g_autoptr (GPtrArray) output_states = fsm_fetch_output_states_from_single (state,
+                                                                                     expected_character);
+
+          priv->offsets[i * classes_count + class] = targets->len;
+
+          for (guint j = 0; j < output_states->len; ++j)
+            {
+              guint target = GPOINTER_TO_UINT (g_hash_table_lookup (state_indices,
+                                                                    g_ptr_array_index (output_states, j)));
+
+              g_array_append_val (targets, target);
+            }
+        }
+    }
+
+  priv->offsets[(gsize) states_count * classes_count] = targets->len;
+  priv->targets = (guint *) g_array_free (g_steal_pointer (&targets), FALSE);
+  priv->states_count = states_count;
+  priv->classes_count = classes_count;
+  priv->start = GPOINTER_TO_UINT (g_hash_table_lookup (state_indices, start_state));
+
+  nfa_prune_dead_states (priv);
+
+  priv->is_start_anchored = nfa_is_start_anchored (priv);
+
+  priv->is_prepared = TRUE;
+}
+
+static void
+nfa_prune_dead_states (NfaPrivate *priv)
+{
+  guint states_count = priv->states_count;
+  gsize slots_count = (gsize) states_count * priv->classes_count;
+  guint transitions_count = priv->offsets[slots_count];
+  g_autofree gboolean *is_alive = g_new0 (gboolean, states_count);
+  g_autofree guint *input_offsets = g_new0 (guint, states_count + 1);
+  g_autofree guint *input_states = g_new (guint, transitions_count);
+  g_autofree guint *pending_states = g_new (guint, states_count);
+  guint pending_states_count = 0;
+
+  /* Indexing the transitions by their output states, i.e. reversing the NFA. */
+  for (guint i = 0; i < transitions_count; ++i)
+    input_offsets[priv->targets[i] + 1]++;
+
+  for (guint i = 0; i < states_count; ++i)
+    input_offsets[i + 1] += input_offsets[i];
+
+  g_autofree guint *input_positions = g_new (guint, states_count);
+
+  for (guint i = 0; i < states_count; ++i)
+    input_positions[i] = input_offsets[i];
+
+  for (guint i = 0; i < states_count; ++i)
+    {
+      guint begin = priv->offsets[(gsize) i * priv->classes_count];
+      guint end = priv->offsets[(gsize) (i + 1) * priv->classes_count];
+
+      for (guint j = begin; j < end; ++j)
+        input_states[input_positions[priv->targets[j]]++] = i;
+    }
+
+  /* A state is alive only if some final state can be reached from it - the remaining states are
+   * what the minimized DFA merges into its dead state, an empty set of states is therefore equivalent to it.
+   */
+  for (guint i = 0; i < states_count; ++i)
+    if (priv->finals[i])
+      {
+        is_alive[i] = TRUE;
+        pending_states[pending_states_count++] = i;
+      }
+
+  while (pending_states_count > 0)
+    {
+      guint state = pending_states[--pending_states_count];
+
+      for (guint i = input_offsets[state]; i < input_offsets[state + 1]; ++i)
+        if (!is_alive[input_states[i]])
+          {
+            is_alive[input_states[i]] = TRUE;
+            pending_states[pending_states_count++] = input_states[i];
+          }
+    }
+
+  /* Dropping the transitions which lead to dead states (the targets array is compacted in place). */
+  guint alive_transitions_count = 0;
+
+  for (gsize i = 0; i < slots_count; ++i)
+    {
+      guint begin = priv->offsets[i];
+      guint end = priv->offsets[i + 1];
+
+      priv->offsets[i] = alive_transitions_count;
+
+      for (guint j = begin; j < end; ++j)
+        if (is_alive[priv->targets[j]])
+          priv->targets[alive_transitions_count++] = priv->targets[j];
+    }
+
+  priv->offsets[slots_count] = alive_transitions_count;
+}
+
+static gboolean
+nfa_is_start_anchored (NfaPrivate *priv)
+{
+  if (priv->finals[priv->start])
+    return FALSE;
+
+  /* Only the start of text character can lead anywhere from the start state. */
+  for (guint character = 0; character < G_N_ELEMENTS (priv->character_classes); ++character)
+    {
+      guint class = priv->character_classes[character];
+
+      if ((gchar) character == START || class == NFA_NO_CHARACTER_CLASS)
+        continue;
+
+      gsize offset = (gsize) priv->start * priv->classes_count + class;
+
+      if (priv->offsets[offset] != priv->offsets[offset + 1])
+        return FALSE;
+    }
+
+  return TRUE;
+}
+
+static void
+nfa_step (NfaPrivate   *priv,
+          NfaStateList *current_states,
+          NfaStateList *next_states,
+          gchar         input_character)
+{
+  guint class = priv->character_classes[(guint8) input_character];
+
+  next_states->count = 0;
+
+  /* Ignoring the null terminator (it does not belong to the alphabet) and the unrecognized characters. */
+  if (class == NFA_NO_CHARACTER_CLASS)
+    return;
+
+  for (guint i = 0; i < current_states->count; ++i)
+    {
+      gsize offset = (gsize) current_states->dense[i] * priv->classes_count + class;
+
+      for (guint j = priv->offsets[offset]; j < priv->offsets[offset + 1]; ++j)
+        nfa_state_list_add (next_states, priv->targets[j]);
+    }
+}
+
+static gboolean
+nfa_state_list_has_final (NfaPrivate   *priv,
+                          NfaStateList *state_list)
+{
+  for (guint i = 0; i < state_list->count; ++i)
+    if (priv->finals[state_list->dense[i]])
+      return TRUE;
+
+  return FALSE;
+}
+
+static void
+nfa_state_list_init (NfaStateList *state_list,
+                     guint         states_count)
+{
+  state_list->dense = g_new0 (guint, states_count);
+  state_list->sparse = g_new0 (guint, states_count);
+  state_list->count = 0;
+}
+
+static void
+nfa_state_list_clear (NfaStateList *state_list)
+{
+  g_clear_pointer (&state_list->dense, g_free);
+  g_clear_pointer (&state_list->sparse, g_free);
+}
+
+static void
+nfa_state_list_reset (NfaStateList *state_list,
+                      guint         state)
+{
+  state_list->count = 0;
+
+  nfa_state_list_add (state_list, state);
+}
+
+static void
+nfa_state_list_add (NfaStateList *state_list,
+                    guint         state)
+{
+  guint index = state_list->sparse[state];
+
+  if (index < state_list->count && state_list->dense[index] == state)
+    return;
+
+  state_list->sparse[state] = state_list->count;
+  state_list->dense[state_list->count++] = state;
+}
+
+static void
+nfa_dispose (GObject *object)
+{
+  NfaPrivate *priv = nfa_get_instance_private (ACCEPTORS_NFA (object));
+
+  g_clear_pointer (&priv->finals, g_free);
+  g_clear_pointer (&priv->offsets, g_free);
+  g_clear_pointer (&priv->targets, g_free);
+
+  priv->is_prepared = FALSE;
+
+  G_OBJECT_CLASS (nfa_parent_class)->dispose (object);
+}
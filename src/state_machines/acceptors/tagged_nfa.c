@@ -0,0 +1,776 @@
+#include "internal/state_machines/acceptors/tagged_nfa.h"
+#include "internal/state_machines/acceptors/acceptor_runnable.h"
+#include "internal/state_machines/transitions/transition.h"
+#include "internal/common/helpers.h"
+#include "core/match.h"
+
+#include <string.h>
+
+struct _TaggedNfa
+{
+  GObject parent_instance;
+};
+
+/* Every active position is a thread which carries its own copy of the tags. Threads are kept in the
+ * order of their priority - a position entered by more than one thread keeps the tags of the one which
+ * got there first, and the first thread found in a position that ends the expression reports the groups.
+ */
+typedef struct
+{
+  gboolean   nullable;
+  guint      groups_count;
+  GPtrArray *character_sets;
+  GArray    *first_edges;
+  GPtrArray *follow_edges;
+  GArray    *last_edges;
+  TaggedEdge  empty_edge;
+  GArray    *operations;
+
+  gint      *last_edge_indices;
+  gboolean   is_start_anchored;
+  gboolean   is_input_exhausted;
+} TaggedNfaPrivate;
+
+typedef struct
+{
+  guint  count;
+  guint *positions;
+  gint  *tags;
+} TaggedThreads;
+
+enum
+{
+  PROP_NULLABLE = 1,
+  PROP_GROUPS_COUNT,
+  PROP_CHARACTER_SETS,
+  PROP_FIRST_EDGES,
+  PROP_FOLLOW_EDGES,
+  PROP_LAST_EDGES,
+  PROP_EMPTY_EDGE,
+  PROP_OPERATIONS,
+  N_PROPERTIES
+};
+
+static GParamSpec *obj_properties[N_PROPERTIES] = { NULL };
+
+static void       tagged_nfa_acceptor_runnable_interface_init (AcceptorRunnableInterface *iface);
+
+static void       tagged_nfa_constructed                      (GObject                   *object);
+
+static GPtrArray *tagged_nfa_run                              (AcceptorRunnable          *self,
+                                                               const gchar               *input,
+                                                               MatchCounters             *counters);
+
+static gboolean   tagged_nfa_can_accept                       (AcceptorRunnable          *self);
+
+static void       tagged_nfa_measure                          (AcceptorRunnable          *self,
+                                                               AutomatonStats            *stats);
+
+static void       tagged_nfa_step                             (TaggedNfaPrivate          *priv,
+                                                               TaggedThreads             *current_threads,
+                                                               TaggedThreads             *next_threads,
+                                                               gboolean                   is_at_start,
+                                                               gchar                      input_character,
+                                                               guint                      offset,
+                                                               guint                     *entered_at,
+                                                               guint                      step);
+
+static void       tagged_nfa_apply_operations                 (TaggedNfaPrivate          *priv,
+                                                               const TaggedEdge          *edge,
+                                                               gint                      *tags,
+                                                               guint                      offset);
+
+static GArray    *tagged_nfa_collect_captures                 (TaggedNfaPrivate          *priv,
+                                                               const TaggedThreads       *threads,
+                                                               gint                       thread,
+                                                               guint                      offset,
+                                                               guint                      input_length);
+
+static void       tagged_nfa_prune_dead_positions             (TaggedNfaPrivate          *priv);
+
+static gboolean   tagged_nfa_is_start_anchored                (TaggedNfaPrivate          *priv);
+
+static void       tagged_nfa_threads_init                     (TaggedThreads             *threads,
+                                                               guint                      positions_count,
+                                                               guint                      tags_count);
+
+static void       tagged_nfa_threads_clear                    (TaggedThreads             *threads);
+
+static void       tagged_nfa_set_property                     (GObject                   *object,
+                                                               guint                      property_id,
+                                                               const GValue              *value,
+                                                               GParamSpec                *pspec);
+
+static void       tagged_nfa_dispose                          (GObject                   *object);
+
+static void       tagged_nfa_finalize                         (GObject                   *object);
+
+G_DEFINE_TYPE_WITH_CODE (TaggedNfa, tagged_nfa, G_TYPE_OBJECT,
+                         G_ADD_PRIVATE (TaggedNfa)
+                         G_IMPLEMENT_INTERFACE (ACCEPTORS_TYPE_ACCEPTOR_RUNNABLE,
+                                                tagged_nfa_acceptor_runnable_interface_init))
+
+static void
+tagged_nfa_class_init (TaggedNfaClass *klass)
+{
+  GObjectClass *object_class = G_OBJECT_CLASS (klass);
+
+  object_class->constructed = tagged_nfa_constructed;
+  object_class->set_property = tagged_nfa_set_property;
+  object_class->dispose = tagged_nfa_dispose;
+  object_class->finalize = tagged_nfa_finalize;
+
+  obj_properties[PROP_NULLABLE] =
+    g_param_spec_boolean (PROP_TAGGED_NFA_NULLABLE,
+                          "Nullable",
+                          "Whether the expression matches the empty string.",
+                          FALSE,
+                          G_PARAM_CONSTRUCT_ONLY | G_PARAM_WRITABLE);
+
+  obj_properties[PROP_GROUPS_COUNT] =
+    g_param_spec_uint (PROP_TAGGED_NFA_GROUPS_COUNT,
+                       "Groups count",
+                       "Number of capture groups found in the expression.",
+                       0,
+                       G_MAXUINT,
+                       0,
+                       G_PARAM_CONSTRUCT_ONLY | G_PARAM_WRITABLE);
+
+  obj_properties[PROP_CHARACTER_SETS] =
+    g_param_spec_boxed (PROP_TAGGED_NFA_CHARACTER_SETS,
+                        "Character sets",
+                        "Characters which can be consumed when entering each one of the positions.",
+                        G_TYPE_PTR_ARRAY,
+                        G_PARAM_CONSTRUCT_ONLY | G_PARAM_WRITABLE);
+
+  obj_properties[PROP_FIRST_EDGES] =
+    g_param_spec_boxed (PROP_TAGGED_NFA_FIRST_EDGES,
+                        "First edges",
+                        "Edges which lead from the initial state to the positions that begin the expression.",
+                        G_TYPE_ARRAY,
+                        G_PARAM_CONSTRUCT_ONLY | G_PARAM_WRITABLE);
+
+  obj_properties[PROP_FOLLOW_EDGES] =
+    g_param_spec_boxed (PROP_TAGGED_NFA_FOLLOW_EDGES,
+                        "Follow edges",
+                        "Edges which lead from each one of the positions to the ones that can follow it.",
+                        G_TYPE_PTR_ARRAY,
+                        G_PARAM_CONSTRUCT_ONLY | G_PARAM_WRITABLE);
+
+  obj_properties[PROP_LAST_EDGES] =
+    g_param_spec_boxed (PROP_TAGGED_NFA_LAST_EDGES,
+                        "Last edges",
+                        "Edges which leave the positions that end the expression.",
+                        G_TYPE_ARRAY,
+                        G_PARAM_CONSTRUCT_ONLY | G_PARAM_WRITABLE);
+
+  obj_properties[PROP_EMPTY_EDGE] =
+    g_param_spec_pointer (PROP_TAGGED_NFA_EMPTY_EDGE,
+                          "Empty edge",
+                          "Edge whose operations are applied in case the expression matches the empty string (copied).",
+                          G_PARAM_CONSTRUCT_ONLY | G_PARAM_WRITABLE);
+
+  obj_properties[PROP_OPERATIONS] =
+    g_param_spec_boxed (PROP_TAGGED_NFA_OPERATIONS,
+                        "Operations",
+                        "Tags which are set by the edges.",
+                        G_TYPE_ARRAY,
+                        G_PARAM_CONSTRUCT_ONLY | G_PARAM_WRITABLE);
+
+  g_object_class_install_properties (object_class,
+                                     N_PROPERTIES,
+                                     obj_properties);
+}
+
+static void
+tagged_nfa_init (TaggedNfa *self)
+{
+  /* NOP */
+}
+
+static void
+tagged_nfa_acceptor_runnable_interface_init (AcceptorRunnableInterface *iface)
+{
+  iface->run = tagged_nfa_run;
+  iface->can_accept = tagged_nfa_can_accept;
+  iface->measure = tagged_nfa_measure;
+}
+
+static void
+tagged_nfa_constructed (GObject *object)
+{
+  TaggedNfaPrivate *priv = tagged_nfa_get_instance_private (ACCEPTORS_TAGGED_NFA (object));
+  guint positions_count = priv->character_sets->len;
+
+  priv->last_edge_indices = g_new (gint, positions_count);
+
+  for (guint i = 0; i < positions_count; ++i)
+    priv->last_edge_indices[i] = -1;
+
+  for (guint i = 0; i < priv->last_edges->len; ++i)
+    priv->last_edge_indices[g_array_index (priv->last_edges, TaggedEdge, i).target] = (gint) i;
+
+  tagged_nfa_prune_dead_positions (priv);
+
+  priv->is_start_anchored = tagged_nfa_is_start_anchored (priv);
+
+  G_OBJECT_CLASS (tagged_nfa_parent_class)->constructed (object);
+}
+
+static GPtrArray *
+tagged_nfa_run (AcceptorRunnable *self,
+                const gchar      *input,
+                MatchCounters    *counters)
+{
+  g_return_val_if_fail (ACCEPTORS_IS_TAGGED_NFA (self), NULL);
+  g_return_val_if_fail (input != NULL, NULL);
+
+  TaggedNfaPrivate *priv = tagged_nfa_get_instance_private (ACCEPTORS_TAGGED_NFA (self));
+  guint input_length = (guint) strlen (input);
+  guint positions_count = priv->character_sets->len;
+  guint tags_count = TAGGED_NFA_OPENING_TAG (priv->groups_count);
+  g_autofree guint *entered_at = g_new0 (guint, positions_count);
+  TaggedThreads current_threads, next_threads;
+  gboolean is_at_start = TRUE;
+  guint begin = 0, end = 0, step = 0;
+  GPtrArray *matches = NULL;
+  MatchCounters run_counters = { 0 };
+
+  tagged_nfa_threads_init (&current_threads, positions_count, tags_count);
+  tagged_nfa_threads_init (&next_threads, positions_count, tags_count);
+
+  priv->is_input_exhausted = FALSE;
+
+  /* The simulation mirrors the DFA's run exactly - a set of threads corresponds to a single DFA state
+   * while the empty set corresponds to the dead state. The tags are recorded along the way, which is
+   * why no other pass over the input is needed once a match is found.
+   */
+  while (TRUE)
+    {
+      gchar previous_character = 0;
+      gboolean is_rest_of_input_skipped = FALSE;
+
+      if (end != 0)
+        {
+          previous_character = acceptor_runnable_input_at (input, end - 1);
+
+          if (previous_character == END_OF_STRING)
+            {
+              priv->is_input_exhausted = TRUE;
+
+              break;
+            }
+        }
+
+      gchar current_character = acceptor_runnable_input_at (input, end);
+
+      tagged_nfa_step (priv,
+                       &current_threads,
+                       &next_threads,
+                       is_at_start,
+                       current_character,
+                       end,
+                       entered_at,
+                       ++step);
+
+      gint final_thread = -1;
+
+      for (guint i = 0; !is_at_start && i < current_threads.count; ++i)
+        {
+          if (priv->last_edge_indices[current_threads.positions[i]] != -1)
+            {
+              final_thread = (gint) i;
+
+              break;
+            }
+        }
+
+      gboolean current_threads_are_final = is_at_start ? priv->nullable : (final_thread != -1);
+      gboolean next_threads_are_dead = (next_threads.count == 0);
+      guint distance = end - begin;
+      g_autoptr (GString) match_value = NULL;
+      g_autoptr (GArray) match_captures = NULL;
+      guint match_range_begin = 0, match_range_end = 0;
+
+      /* Handling empty matches. */
+      if (current_threads_are_final)
+        {
+          /* Ignoring empty matches that are a result of the start and end of text special characters. */
+          gboolean is_valid_empty_match =
+            (distance == 0 &&
+             (current_character != START && previous_character != END));
+
+          if (is_valid_empty_match)
+            {
+              match_value = g_string_new (EMPTY_STRING);
+              match_captures = tagged_nfa_collect_captures (priv, NULL, -1, end, input_length);
+              match_range_begin = match_range_end = end - 1;
+            }
+        }
+
+      /* Handling non-empty matches. */
+      if (next_threads_are_dead)
+        {
+          gboolean is_valid_non_empty_match =
+            (distance != 0 && current_threads_are_final);
+
+          if (is_valid_non_empty_match)
+            {
+              match_value = acceptor_runnable_input_copy (input, begin, end);
+              match_captures = tagged_nfa_collect_captures (priv, &current_threads, final_thread, end, input_length);
+              match_range_begin = begin - 1;
+              match_range_end = end - 1;
+            }
+
+          /* Moving onto the next character in the input in case no position was entered straight
+           * from the initial state without consuming a single character.
+           */
+          if (distance == 0)
+            {
+              end++;
+              run_counters.bytes_scanned++;
+            }
+
+          run_counters.dead_transitions++;
+
+          if (distance != 0)
+            run_counters.resets++;
+
+          /* Preparing for a new run. */
+          begin = end;
+          is_at_start = TRUE;
+          current_threads.count = 0;
+
+          /* A start-anchored expression cannot match anywhere else than at a start of text character,
+           * the characters in between are skipped altogether.
+           */
+          if (priv->is_start_anchored)
+            {
+              guint next_start_of_text = acceptor_runnable_input_find (input, end, START);
+
+              if (next_start_of_text != G_MAXUINT)
+                begin = end = next_start_of_text;
+              else
+                is_rest_of_input_skipped = TRUE;
+
+              run_counters.skips++;
+            }
+        }
+      else
+        {
+          /* Moving onto the next character in the input in case the NFA can continue with the current run. */
+          TaggedThreads swapped_threads = current_threads;
+
+          current_threads = next_threads;
+          next_threads = swapped_threads;
+          is_at_start = FALSE;
+
+          end++;
+          run_counters.bytes_scanned++;
+        }
+
+      /* Adding a new match if possible. */
+      if (match_value != NULL)
+        {
+          if (matches == NULL)
+            matches = g_ptr_array_new_with_free_func (g_object_unref);
+
+          Match *match = match_new (PROP_MATCH_VALUE, match_value,
+                                    PROP_MATCH_RANGE_BEGIN, match_range_begin,
+                                    PROP_MATCH_RANGE_END, match_range_end,
+                                    PROP_MATCH_CAPTURES, match_captures);
+
+          g_ptr_array_add (matches, match);
+
+          run_counters.matches++;
+
+          if (match_value->len == 0)
+            run_counters.empty_matches++;
+        }
+
+      if (is_rest_of_input_skipped)
+        {
+          priv->is_input_exhausted = TRUE;
+
+          break;
+        }
+    }
+
+  if (counters != NULL)
+    match_counters_add (counters, &run_counters);
+
+  tagged_nfa_threads_clear (&current_threads);
+  tagged_nfa_threads_clear (&next_threads);
+
+  return matches;
+}
+
+static gboolean
+tagged_nfa_can_accept (AcceptorRunnable *self)
+{
+  g_return_val_if_fail (ACCEPTORS_IS_TAGGED_NFA (self), FALSE);
+
+  TaggedNfaPrivate *priv = tagged_nfa_get_instance_private (ACCEPTORS_TAGGED_NFA (self));
+
+  return priv->is_input_exhausted;
+}
+
+static void
+tagged_nfa_measure (AcceptorRunnable *self,
+                    AutomatonStats   *stats)
+{
+  g_return_if_fail (ACCEPTORS_IS_TAGGED_NFA (self));
+
+  TaggedNfaPrivate *priv = tagged_nfa_get_instance_private (ACCEPTORS_TAGGED_NFA (self));
+  guint positions_count = priv->character_sets->len;
+  g_autoptr (GPtrArray) distinct_character_sets = g_ptr_array_new ();
+
+  stats->states_count = positions_count + 1;
+  stats->transitions_count = priv->first_edges->len;
+  stats->bytes = g_object_get_instance_size (self) +
+                 sizeof (GPtrArray) + sizeof (gpointer) * positions_count +
+                 sizeof (GArray) + sizeof (TaggedEdge) * priv->first_edges->len +
+                 sizeof (GPtrArray) + sizeof (gpointer) * priv->follow_edges->len +
+                 sizeof (GArray) + sizeof (TaggedEdge) * priv->last_edges->len +
+                 sizeof (GArray) + sizeof (guint) * priv->operations->len +
+                 sizeof (gint) * positions_count;
+
+  for (guint i = 0; i < priv->follow_edges->len; ++i)
+    {
+      GArray *edges = g_ptr_array_index (priv->follow_edges, i);
+
+      stats->transitions_count += edges->len;
+      stats->bytes += sizeof (GArray) + sizeof (TaggedEdge) * edges->len;
+    }
+
+  /* The alphabet consists of the distinct sets of characters that the positions expect. */
+  for (guint i = 0; i < positions_count; ++i)
+    {
+      CharacterSet *character_set = g_ptr_array_index (priv->character_sets, i);
+
+      stats->bytes += character_set_measure (character_set);
+
+      g_ptr_array_add_if_not_exists (distinct_character_sets,
+                                     character_set,
+                                     (GEqualFunc) character_set_equal,
+                                     NULL);
+    }
+
+  stats->alphabet_size = distinct_character_sets->len;
+  stats->has_dead_state = FALSE;
+}
+
+static void
+tagged_nfa_step (TaggedNfaPrivate *priv,
+                 TaggedThreads    *current_threads,
+                 TaggedThreads    *next_threads,
+                 gboolean          is_at_start,
+                 gchar             input_character,
+                 guint             offset,
+                 guint            *entered_at,
+                 guint             step)
+{
+  guint tags_count = TAGGED_NFA_OPENING_TAG (priv->groups_count);
+  guint sources_count = is_at_start ? 1 : current_threads->count;
+
+  next_threads->count = 0;
+
+  /* The initial state is a single thread whose tags are all unset. */
+  for (guint i = 0; i < sources_count; ++i)
+    {
+      GArray *edges = is_at_start
+                      ? priv->first_edges
+                      : g_ptr_array_index (priv->follow_edges, current_threads->positions[i]);
+
+      for (guint j = 0; j < edges->len; ++j)
+        {
+          const TaggedEdge *edge = &g_array_index (edges, TaggedEdge, j);
+          guint target = edge->target;
+
+          if (entered_at[target] == step ||
+              !character_set_contains (g_ptr_array_index (priv->character_sets, target), input_character))
+            continue;
+
+          gint *tags = next_threads->tags + (gsize) next_threads->count * tags_count;
+
+          if (is_at_start)
+            {
+              for (guint k = 0; k < tags_count; ++k)
+                tags[k] = -1;
+            }
+          else
+            {
+              memcpy (tags,
+                      current_threads->tags + (gsize) i * tags_count,
+                      tags_count * sizeof (gint));
+            }
+
+          tagged_nfa_apply_operations (priv, edge, tags, offset);
+
+          entered_at[target] = step;
+          next_threads->positions[next_threads->count++] = target;
+        }
+    }
+}
+
+static void
+tagged_nfa_apply_operations (TaggedNfaPrivate *priv,
+                             const TaggedEdge *edge,
+                             gint             *tags,
+                             guint             offset)
+{
+  for (guint i = edge->operations_begin; i < edge->operations_end; ++i)
+    tags[g_array_index (priv->operations, guint, i)] = (gint) offset;
+}
+
+static GArray *
+tagged_nfa_collect_captures (TaggedNfaPrivate    *priv,
+                             const TaggedThreads *threads,
+                             gint                 thread,
+                             guint                offset,
+                             guint                input_length)
+{
+  guint tags_count = TAGGED_NFA_OPENING_TAG (priv->groups_count);
+  g_autofree gint *tags = g_new (gint, MAX (tags_count, 1));
+  GArray *captures = g_array_sized_new (FALSE, FALSE, sizeof (gint), tags_count);
+
+  /* Groups of an empty match are set by the empty edge (only the nullable ones match the empty string,
+   * the rest is left unset), the ones of a non-empty match are closed by leaving the final thread's position.
+   */
+  if (thread == -1)
+    {
+      for (guint i = 0; i < tags_count; ++i)
+        tags[i] = -1;
+
+      tagged_nfa_apply_operations (priv, &priv->empty_edge, tags, offset);
+    }
+  else
+    {
+      guint position = threads->positions[thread];
+      gint last_edge_index = priv->last_edge_indices[position];
+
+      memcpy (tags,
+              threads->tags + (gsize) thread * tags_count,
+              tags_count * sizeof (gint));
+
+      tagged_nfa_apply_operations (priv,
+                                   &g_array_index (priv->last_edges, TaggedEdge, last_edge_index),
+                                   tags,
+                                   offset);
+    }
+
+  /* The tags are offsets into the adjusted input, the start and end of text characters are not part
+   * of the original one.
+   */
+  for (guint group = 0; group < priv->groups_count; ++group)
+    {
+      gint opening_tag = tags[TAGGED_NFA_OPENING_TAG (group)];
+      gint closing_tag = tags[TAGGED_NFA_CLOSING_TAG (group)];
+      gint capture_begin = -1, capture_end = -1;
+
+      if (opening_tag != -1 && closing_tag != -1)
+        {
+          capture_begin = CLAMP (opening_tag - 1, 0, (gint) input_length);
+          capture_end = CLAMP (closing_tag - 1, 0, (gint) input_length);
+        }
+
+      g_array_append_val (captures, capture_begin);
+      g_array_append_val (captures, capture_end);
+    }
+
+  return captures;
+}
+
+static void
+tagged_nfa_prune_dead_positions (TaggedNfaPrivate *priv)
+{
+  guint positions_count = priv->character_sets->len;
+  g_autofree gboolean *alive_positions = g_new0 (gboolean, positions_count);
+  gboolean is_changed = TRUE;
+
+  for (guint i = 0; i < positions_count; ++i)
+    alive_positions[i] = (priv->last_edge_indices[i] != -1);
+
+  /* A position is alive only if a position that ends the expression can be reached from it - the
+   * remaining positions are what the minimized DFA merges into its dead state.
+   */
+  while (is_changed)
+    {
+      is_changed = FALSE;
+
+      for (guint i = 0; i < positions_count; ++i)
+        {
+          GArray *edges = g_ptr_array_index (priv->follow_edges, i);
+
+          if (alive_positions[i])
+            continue;
+
+          for (guint j = 0; j < edges->len; ++j)
+            {
+              if (alive_positions[g_array_index (edges, TaggedEdge, j).target])
+                {
+                  alive_positions[i] = TRUE;
+                  is_changed = TRUE;
+
+                  break;
+                }
+            }
+        }
+    }
+
+  /* The edges are copied (preserving their order) since the arrays may still be shared with the caller. */
+  g_autoptr (GPtrArray) all_edges = g_ptr_array_new_with_free_func ((GDestroyNotify) g_array_unref);
+
+  g_ptr_array_add (all_edges, g_array_ref (priv->first_edges));
+
+  for (guint i = 0; i < positions_count; ++i)
+    g_ptr_array_add (all_edges, g_array_ref (g_ptr_array_index (priv->follow_edges, i)));
+
+  g_clear_pointer (&priv->first_edges, g_array_unref);
+  g_clear_pointer (&priv->follow_edges, g_ptr_array_unref);
+
+  priv->follow_edges = g_ptr_array_new_with_free_func ((GDestroyNotify) g_array_unref);
+
+  for (guint i = 0; i < all_edges->len; ++i)
+    {
+      GArray *edges = g_ptr_array_index (all_edges, i);
+      GArray *alive_edges = g_array_new (FALSE, FALSE, sizeof (TaggedEdge));
+
+      for (guint j = 0; j < edges->len; ++j)
+        {
+          TaggedEdge edge = g_array_index (edges, TaggedEdge, j);
+
+          if (alive_positions[edge.target])
+            g_array_append_val (alive_edges, edge);
+        }
+
+      if (i == 0)
+        priv->first_edges = alive_edges;
+      else
+        g_ptr_array_add (priv->follow_edges, alive_edges);
+    }
+}
+
+static gboolean
+tagged_nfa_is_start_anchored (TaggedNfaPrivate *priv)
+{
+  if (priv->nullable)
+    return FALSE;
+
+  /* Only the start of text character can be consumed by any of the first positions. */
+  for (guint i = 0; i < priv->first_edges->len; ++i)
+    {
+      CharacterSet *character_set = g_ptr_array_index (priv->character_sets,
+                                                       g_array_index (priv->first_edges, TaggedEdge, i).target);
+
+      for (guint character = 0; character <= G_MAXUINT8; ++character)
+        if ((gchar) character != START && character_set_contains (character_set, (gchar) character))
+          return FALSE;
+    }
+
+  return TRUE;
+}
+
+static void
+tagged_nfa_threads_init (TaggedThreads *threads,
+                         guint          positions_count,
+                         guint          tags_count)
+{
+  /* Each position is entered by at most one thread per step. */
+  threads->count = 0;
+  threads->positions = g_new (guint, MAX (positions_count, 1));
+  threads->tags = g_new (gint, MAX ((gsize) positions_count * tags_count, 1));
+}
+
+static void
+tagged_nfa_threads_clear (TaggedThreads *threads)
+{
+  g_free (threads->positions);
+  g_free (threads->tags);
+}
+
+static void
+tagged_nfa_set_property (GObject      *object,
+                         guint         property_id,
+                         const GValue *value,
+                         GParamSpec   *pspec)
+{
+  TaggedNfaPrivate *priv = tagged_nfa_get_instance_private (ACCEPTORS_TAGGED_NFA (object));
+
+  switch (property_id)
+    {
+    case PROP_NULLABLE:
+      priv->nullable = g_value_get_boolean (value);
+      break;
+
+    case PROP_GROUPS_COUNT:
+      priv->groups_count = g_value_get_uint (value);
+      break;
+
+    case PROP_CHARACTER_SETS:
+      priv->character_sets = g_value_dup_boxed (value);
+      break;
+
+    case PROP_FIRST_EDGES:
+      priv->first_edges = g_value_dup_boxed (value);
+      break;
+
+    case PROP_FOLLOW_EDGES:
+      priv->follow_edges = g_value_dup_boxed (value);
+      break;
+
+    case PROP_LAST_EDGES:
+      priv->last_edges = g_value_dup_boxed (value);
+      break;
+
+    case PROP_EMPTY_EDGE:
+      {
+        const TaggedEdge *empty_edge = g_value_get_pointer (value);
+
+        if (empty_edge != NULL)
+          priv->empty_edge = *empty_edge;
+      }
+      break;
+
+    case PROP_OPERATIONS:
+      priv->operations = g_value_dup_boxed (value);
+      break;
+
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
+      break;
+    }
+}
+
+static void
+tagged_nfa_dispose (GObject *object)
+{
+  TaggedNfaPrivate *priv = tagged_nfa_get_instance_private (ACCEPTORS_TAGGED_NFA (object));
+
+  if (priv->character_sets != NULL)
+    g_clear_pointer (&priv->character_sets, g_ptr_array_unref);
+
+  if (priv->first_edges != NULL)
+    g_clear_pointer (&priv->first_edges, g_array_unref);
+
+  if (priv->follow_edges != NULL)
+    g_clear_pointer (&priv->follow_edges, g_ptr_array_unref);
+
+  if (priv->last_edges != NULL)
+    g_clear_pointer (&priv->last_edges, g_array_unref);
+
+  if (priv->operations != NULL)
+    g_clear_pointer (&priv->operations, g_array_unref);
+
+  G_OBJECT_CLASS (tagged_nfa_parent_class)->dispose (object);
+}
+
+static void
+tagged_nfa_finalize (GObject *object)
+{
+  TaggedNfaPrivate *priv = tagged_nfa_get_instance_private (ACCEPTORS_TAGGED_NFA (object));
+
+  g_free (priv->last_edge_indices);
+
+  G_OBJECT_CLASS (tagged_nfa_parent_class)->finalize (object);
+}
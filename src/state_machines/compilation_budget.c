@@ -0,0 +1,247 @@
+#include "internal/state_machines/compilation_budget.h"
+#include "internal/state_machines/state.h"
+#include "internal/state_machines/transitions/deterministic_transition.h"
+
+struct _CompilationBudget
+{
+  GObject parent_instance;
+};
+
+typedef struct
+{
+  guint                  max_states;
+  guint64                max_bytes;
+  gint64                 deadline;
+  guint64                charged_bytes;
+  CompilationBudgetLimit exceeded_limit;
+} CompilationBudgetPrivate;
+
+enum
+{
+  PROP_MAX_STATES = 1,
+  PROP_MAX_BYTES,
+  PROP_DEADLINE,
+  PROP_EXCEEDED_LIMIT,
+  N_PROPERTIES
+};
+
+static GParamSpec *obj_properties[N_PROPERTIES] = { NULL };
+
+/* Approximate amount of memory held by a single state and by a single transition, respectively. */
+static gsize state_bytes = 0;
+static gsize transition_bytes = 0;
+
+static gsize compilation_budget_query_instance_size (GType         type);
+
+static void  compilation_budget_get_property        (GObject      *object,
+                                                     guint         property_id,
+                                                     GValue       *value,
+                                                     GParamSpec   *pspec);
+
+static void  compilation_budget_set_property        (GObject      *object,
+                                                     guint         property_id,
+                                                     const GValue *value,
+                                                     GParamSpec   *pspec);
+
+G_DEFINE_TYPE_WITH_PRIVATE (CompilationBudget, compilation_budget, G_TYPE_OBJECT)
+
+static void
+compilation_budget_class_init (CompilationBudgetClass *klass)
+{
+  GObjectClass *object_class = G_OBJECT_CLASS (klass);
+
+  object_class->get_property = compilation_budget_get_property;
+  object_class->set_property = compilation_budget_set_property;
+
+  /* Each state owns an array of transitions, each set transition owns a character set (256 bits). */
+  state_bytes = compilation_budget_query_instance_size (STATE_MACHINES_TYPE_STATE) + sizeof (GPtrArray);
+  transition_bytes = compilation_budget_query_instance_size (TRANSITIONS_TYPE_DETERMINISTIC_TRANSITION) +
+                     sizeof (gpointer) +
+                     sizeof (guint64) * 4;
+
+  obj_properties[PROP_MAX_STATES] =
+    g_param_spec_uint (PROP_COMPILATION_BUDGET_MAX_STATES,
+                       "Max states",
+                       "Maximum number of states that any single state machine built during the compilation "
+                         "may consist of (zero stands for no limit).",
+                       0,
+                       G_MAXUINT,
+                       0,
+                       G_PARAM_CONSTRUCT_ONLY | G_PARAM_READWRITE);
+
+  obj_properties[PROP_MAX_BYTES] =
+    g_param_spec_uint64 (PROP_COMPILATION_BUDGET_MAX_BYTES,
+                         "Max bytes",
+                         "Maximum (approximate) number of bytes that the states and transitions built during "
+                           "the compilation may occupy (zero stands for no limit).",
+                         0,
+                         G_MAXUINT64,
+                         0,
+                         G_PARAM_CONSTRUCT_ONLY | G_PARAM_READWRITE);
+
+  obj_properties[PROP_DEADLINE] =
+    g_param_spec_int64 (PROP_COMPILATION_BUDGET_DEADLINE,
+                        "Deadline",
+                        "Monotonic time (in microseconds) by which the compilation must be finished "
+                          "(zero stands for no limit).",
+                        0,
+                        G_MAXINT64,
+                        0,
+                        G_PARAM_CONSTRUCT_ONLY | G_PARAM_READWRITE);
+
+  obj_properties[PROP_EXCEEDED_LIMIT] =
+    g_param_spec_uint (PROP_COMPILATION_BUDGET_EXCEEDED_LIMIT,
+                       "Exceeded limit",
+                       "The first limit which was exceeded during the compilation (if any).",
+                       COMPILATION_BUDGET_LIMIT_NONE,
+                       COMPILATION_BUDGET_LIMIT_DEADLINE,
+                       COMPILATION_BUDGET_LIMIT_NONE,
+                       G_PARAM_READABLE);
+
+  g_object_class_install_properties (object_class,
+                                     N_PROPERTIES,
+                                     obj_properties);
+}
+
+static void
+compilation_budget_init (CompilationBudget *self)
+{
+  /* NOP */
+}
+
+gboolean
+compilation_budget_allows_states (CompilationBudget *self,
+                                  guint              states_count)
+{
+  g_return_val_if_fail (STATE_MACHINES_IS_COMPILATION_BUDGET (self), FALSE);
+
+  CompilationBudgetPrivate *priv = compilation_budget_get_instance_private (self);
+
+  if (compilation_budget_is_exceeded (self))
+    return FALSE;
+
+  if (priv->max_states != 0 && states_count > priv->max_states)
+    {
+      priv->exceeded_limit = COMPILATION_BUDGET_LIMIT_STATES;
+
+      return FALSE;
+    }
+
+  return TRUE;
+}
+
+gboolean
+compilation_budget_charge (CompilationBudget *self,
+                           guint              states_count,
+                           guint              transitions_count)
+{
+  g_return_val_if_fail (STATE_MACHINES_IS_COMPILATION_BUDGET (self), FALSE);
+
+  CompilationBudgetPrivate *priv = compilation_budget_get_instance_private (self);
+
+  if (compilation_budget_is_exceeded (self))
+    return FALSE;
+
+  priv->charged_bytes += (guint64) states_count * state_bytes +
+                         (guint64) transitions_count * transition_bytes;
+
+  if (priv->max_bytes != 0 && priv->charged_bytes > priv->max_bytes)
+    {
+      priv->exceeded_limit = COMPILATION_BUDGET_LIMIT_BYTES;
+
+      return FALSE;
+    }
+
+  return TRUE;
+}
+
+gboolean
+compilation_budget_is_exceeded (CompilationBudget *self)
+{
+  g_return_val_if_fail (STATE_MACHINES_IS_COMPILATION_BUDGET (self), TRUE);
+
+  CompilationBudgetPrivate *priv = compilation_budget_get_instance_private (self);
+
+  /* Once exceeded, the budget stays exceeded - the first exceeded limit is the one being reported. */
+  if (priv->exceeded_limit != COMPILATION_BUDGET_LIMIT_NONE)
+    return TRUE;
+
+  if (priv->deadline != 0 && g_get_monotonic_time () > priv->deadline)
+    {
+      priv->exceeded_limit = COMPILATION_BUDGET_LIMIT_DEADLINE;
+
+      return TRUE;
+    }
+
+  return FALSE;
+}
+
+static gsize
+compilation_budget_query_instance_size (GType type)
+{
+  GTypeQuery query;
+
+  g_type_query (type, &query);
+
+  return query.instance_size;
+}
+
+static void
+compilation_budget_get_property (GObject    *object,
+                                 guint       property_id,
+                                 GValue     *value,
+                                 GParamSpec *pspec)
+{
+  CompilationBudgetPrivate *priv = compilation_budget_get_instance_private (STATE_MACHINES_COMPILATION_BUDGET (object));
+
+  switch (property_id)
+    {
+    case PROP_MAX_STATES:
+      g_value_set_uint (value, priv->max_states);
+      break;
+
+    case PROP_MAX_BYTES:
+      g_value_set_uint64 (value, priv->max_bytes);
+      break;
+
+    case PROP_DEADLINE:
+      g_value_set_int64 (value, priv->deadline);
+      break;
+
+    case PROP_EXCEEDED_LIMIT:
+      g_value_set_uint (value, priv->exceeded_limit);
+      break;
+
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
+      break;
+    }
+}
+
+static void
+compilation_budget_set_property (GObject      *object,
+                                 guint         property_id,
+                                 const GValue *value,
+                                 GParamSpec   *pspec)
+{
+  CompilationBudgetPrivate *priv = compilation_budget_get_instance_private (STATE_MACHINES_COMPILATION_BUDGET (object));
+
+  switch (property_id)
+    {
+    case PROP_MAX_STATES:
+      priv->max_states = g_value_get_uint (value);
+      break;
+
+    case PROP_MAX_BYTES:
+      priv->max_bytes = g_value_get_uint64 (value);
+      break;
+
+    case PROP_DEADLINE:
+      priv->deadline = g_value_get_int64 (value);
+      break;
+
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
+      break;
+    }
+}
@@ -29,6 +29,11 @@ static gboolean composite_state_can_be_marked_as (CompositeStatePrivate *priv,
 
 static void     composite_state_constructed      (GObject               *object);
 
+static void     composite_state_get_property     (GObject               *object,
+                                                  guint                  property_id,
+                                                  GValue                *value,
+                                                  GParamSpec            *pspec);
+
 static void     composite_state_set_property     (GObject               *object,
                                                   guint                  property_id,
                                                   const GValue          *value,
@@ -47,6 +52,7 @@ composite_state_class_init (CompositeStateClass *klass)
   state_class->is_composed_from = composite_state_is_composed_from;
 
   object_class->constructed = composite_state_constructed;
+  object_class->get_property = composite_state_get_property;
   object_class->set_property = composite_state_set_property;
   object_class->dispose = composite_state_dispose;
 
@@ -55,7 +61,7 @@ composite_state_class_init (CompositeStateClass *klass)
                         "Composed from states",
                         "States which serve as a basis for constructing the composite state.",
                         G_TYPE_PTR_ARRAY,
-                        G_PARAM_CONSTRUCT_ONLY | G_PARAM_WRITABLE);
+                        G_PARAM_CONSTRUCT_ONLY | G_PARAM_READWRITE);
 
   obj_properties[PROP_RESOLVE_TYPE_FLAGS] =
     g_param_spec_uint (PROP_COMPOSITE_STATE_RESOLVE_TYPE_FLAGS,
@@ -143,6 +149,26 @@ composite_state_can_be_marked_as (CompositeStatePrivate *priv,
   return FALSE;
 }
 
+static void
+composite_state_get_property (GObject    *object,
+                              guint       property_id,
+                              GValue     *value,
+                              GParamSpec *pspec)
+{
+  CompositeStatePrivate *priv = composite_state_get_instance_private (STATE_MACHINES_COMPOSITE_STATE (object));
+
+  switch (property_id)
+    {
+    case PROP_COMPOSED_FROM_STATES:
+      g_value_set_boxed (value, priv->composed_from_states);
+      break;
+
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
+      break;
+    }
+}
+
 static void
 composite_state_set_property (GObject      *object,
                               guint         property_id,
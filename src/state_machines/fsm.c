@@ -1,6 +1,8 @@
 #include "internal/state_machines/fsm.h"
 #include "internal/state_machines/fsm_initializable.h"
 #include "internal/state_machines/transitions/transition.h"
+#include "internal/state_machines/transitions/deterministic_transition.h"
+#include "internal/state_machines/transitions/nondeterministic_transition.h"
 #include "internal/state_machines/state_factory.h"
 #include "internal/common/helpers.h"
 
@@ -23,23 +25,31 @@ enum
   N_PROPERTIES
 };
 
-static void fsm_fsm_initializable_interface_init (FsmInitializableInterface *iface);
+static void    fsm_fsm_initializable_interface_init  (FsmInitializableInterface *iface);
 
-static void fsm_prepare_states                   (FsmPrivate                *priv);
+static void    fsm_prepare_states                    (FsmPrivate                *priv);
 
-static void fsm_prepare_alphabet                 (FsmPrivate                *priv);
+static void    fsm_prepare_alphabet                  (FsmPrivate                *priv);
 
-static void fsm_get_property                     (GObject                   *object,
-                                                  guint                      property_id,
-                                                  GValue                    *value,
-                                                  GParamSpec                *pspec);
+static GSList *fsm_refine_alphabet                   (GSList                    *alphabet,
+                                                      CharacterSet              *expected_characters);
 
-static void fsm_set_property                     (GObject                   *object,
-                                                  guint                      property_id,
-                                                  const GValue              *value,
-                                                  GParamSpec                *pspec);
+static gsize   fsm_measure_array                     (GPtrArray                 *array);
 
-static void fsm_dispose                          (GObject                   *object);
+static void    fsm_measure_state                     (State                     *state,
+                                                      AutomatonStats            *stats);
+
+static void    fsm_get_property                      (GObject                   *object,
+                                                      guint                      property_id,
+                                                      GValue                    *value,
+                                                      GParamSpec                *pspec);
+
+static void    fsm_set_property                      (GObject                   *object,
+                                                      guint                      property_id,
+                                                      const GValue              *value,
+                                                      GParamSpec                *pspec);
+
+static void    fsm_dispose                           (GObject                   *object);
 
 G_DEFINE_ABSTRACT_TYPE_WITH_CODE (Fsm, fsm, G_TYPE_OBJECT,
                                   G_ADD_PRIVATE (Fsm)
@@ -196,6 +206,107 @@ fsm_get_or_create_dead_state (GPtrArray *all_states)
   return dead_state;
 }
 
+void
+fsm_count_states_and_transitions (Fsm   *self,
+                                  guint *states_count,
+                                  guint *transitions_count)
+{
+  g_return_if_fail (STATE_MACHINES_IS_FSM (self));
+  g_return_if_fail (states_count != NULL);
+  g_return_if_fail (transitions_count != NULL);
+
+  FsmPrivate *priv = fsm_get_instance_private (self);
+  GPtrArray *all_states = priv->all_states;
+
+  *states_count = 0;
+  *transitions_count = 0;
+
+  if (!g_collection_has_items (all_states))
+    return;
+
+  *states_count = all_states->len;
+
+  for (guint i = 0; i < all_states->len; ++i)
+    {
+      g_autoptr (GPtrArray) transitions = NULL;
+
+      g_object_get (g_ptr_array_index (all_states, i),
+                    PROP_STATE_TRANSITIONS, &transitions,
+                    NULL);
+
+      if (!g_collection_has_items (transitions))
+        continue;
+
+      for (guint j = 0; j < transitions->len; ++j)
+        {
+          Transition *transition = g_ptr_array_index (transitions, j);
+
+          if (TRANSITIONS_IS_NONDETERMINISTIC_TRANSITION (transition))
+            {
+              g_autoptr (GPtrArray) output_states = NULL;
+
+              g_object_get (transition,
+                            PROP_NONDETERMINISTIC_TRANSITION_OUTPUT_STATES, &output_states,
+                            NULL);
+
+              if (output_states != NULL)
+                *transitions_count += output_states->len;
+            }
+          else if (TRANSITIONS_IS_DETERMINISTIC_TRANSITION (transition))
+            {
+              g_autoptr (State) output_state = NULL;
+
+              g_object_get (transition,
+                            PROP_DETERMINISTIC_TRANSITION_OUTPUT_STATE, &output_state,
+                            NULL);
+
+              if (output_state != NULL)
+                *transitions_count += 1;
+            }
+        }
+    }
+}
+
+void
+fsm_measure (Fsm            *self,
+             AutomatonStats *stats)
+{
+  g_return_if_fail (STATE_MACHINES_IS_FSM (self));
+  g_return_if_fail (stats != NULL);
+
+  FsmPrivate *priv = fsm_get_instance_private (self);
+
+  fsm_count_states_and_transitions (self,
+                                    &stats->states_count,
+                                    &stats->transitions_count);
+
+  stats->alphabet_size = g_slist_length (priv->alphabet);
+  stats->bytes += g_object_get_instance_size (self) +
+                  fsm_measure_array (priv->all_states) +
+                  fsm_measure_array (priv->final_states) +
+                  fsm_measure_array (priv->non_final_states);
+
+  for (GSList *iterator = priv->alphabet; iterator != NULL; iterator = iterator->next)
+    stats->bytes += sizeof (GSList) + character_set_measure (iterator->data);
+
+  if (!g_collection_has_items (priv->all_states))
+    return;
+
+  for (guint i = 0; i < priv->all_states->len; ++i)
+    {
+      State *state = g_ptr_array_index (priv->all_states, i);
+      gboolean is_dead = FALSE;
+
+      g_object_get (state,
+                    PROP_STATE_IS_DEAD, &is_dead,
+                    NULL);
+
+      stats->has_dead_state |= is_dead;
+
+      fsm_measure_state (state, stats);
+    }
+}
+
 static void
 fsm_fsm_initializable_interface_init (FsmInitializableInterface *iface)
 {
@@ -259,7 +370,7 @@ static void
 fsm_prepare_alphabet (FsmPrivate *priv)
 {
   if (priv->alphabet != NULL)
-    g_slist_free (priv->alphabet);
+    g_slist_free_full (priv->alphabet, (GDestroyNotify) character_set_free);
 
   GSList *alphabet = NULL;
   GPtrArray *all_states = priv->all_states;
@@ -283,17 +394,9 @@ fsm_prepare_alphabet (FsmPrivate *priv)
 
                   if (!transition_is_epsilon (transition))
                     {
-                      gchar expected_character;
-                      gpointer expected_character_as_pointer = NULL;
+                      g_autoptr (CharacterSet) expected_characters = transition_fetch_expected_characters (transition);
 
-                      g_object_get (transition,
-                                    PROP_TRANSITION_EXPECTED_CHARACTER, &expected_character,
-                                    NULL);
-
-                      expected_character_as_pointer = GINT_TO_POINTER (expected_character);
-
-                      if (g_slist_find (alphabet, expected_character_as_pointer) == NULL)
-                        alphabet = g_slist_append (alphabet, expected_character_as_pointer);
+                      alphabet = fsm_refine_alphabet (alphabet, expected_characters);
                     }
                 }
             }
@@ -303,6 +406,113 @@ fsm_prepare_alphabet (FsmPrivate *priv)
   priv->alphabet = alphabet;
 }
 
+static GSList *
+fsm_refine_alphabet (GSList       *alphabet,
+                     CharacterSet *expected_characters)
+{
+  /* The alphabet is kept as a partition of disjoint character sets, each transition's set of expected
+   * characters therefore splits every set that it only partially overlaps and the characters not found
+   * in any of the existing sets form a new one.
+   */
+  g_autoptr (CharacterSet) remaining_characters = character_set_copy (expected_characters);
+  GSList *refined_alphabet = NULL;
+
+  for (GSList *iterator = alphabet; iterator != NULL; iterator = iterator->next)
+    {
+      CharacterSet *characters = iterator->data;
+      CharacterSet *common_characters = character_set_intersect (characters, remaining_characters);
+
+      character_set_subtract (remaining_characters, characters);
+
+      if (character_set_is_empty (common_characters) || character_set_equal (common_characters, characters))
+        {
+          character_set_free (common_characters);
+        }
+      else
+        {
+          character_set_subtract (characters, common_characters);
+
+          refined_alphabet = g_slist_prepend (refined_alphabet, common_characters);
+        }
+
+      refined_alphabet = g_slist_prepend (refined_alphabet, characters);
+    }
+
+  if (!character_set_is_empty (remaining_characters))
+    refined_alphabet = g_slist_prepend (refined_alphabet, g_steal_pointer (&remaining_characters));
+
+  g_slist_free (alphabet);
+
+  return g_slist_reverse (refined_alphabet);
+}
+
+static gsize
+fsm_measure_array (GPtrArray *array)
+{
+  if (array == NULL)
+    return 0;
+
+  return sizeof (GPtrArray) + sizeof (gpointer) * array->len;
+}
+
+static void
+fsm_measure_state (State          *state,
+                   AutomatonStats *stats)
+{
+  g_autoptr (GPtrArray) transitions = NULL;
+
+  g_object_get (state,
+                PROP_STATE_TRANSITIONS, &transitions,
+                NULL);
+
+  stats->bytes += g_object_get_instance_size (state) + fsm_measure_array (transitions);
+
+  if (g_collection_has_items (transitions))
+    {
+      for (guint i = 0; i < transitions->len; ++i)
+        {
+          Transition *transition = g_ptr_array_index (transitions, i);
+          g_autoptr (CharacterSet) expected_characters = NULL;
+
+          g_object_get (transition,
+                        PROP_TRANSITION_EXPECTED_CHARACTERS, &expected_characters,
+                        NULL);
+
+          stats->bytes += g_object_get_instance_size (transition);
+
+          if (expected_characters != NULL)
+            stats->bytes += character_set_measure (expected_characters);
+
+          /* The output states are referenced weakly, they are kept alive by someone else (if at all). */
+          if (TRANSITIONS_IS_NONDETERMINISTIC_TRANSITION (transition))
+            {
+              g_autoptr (GPtrArray) output_states = NULL;
+
+              g_object_get (transition,
+                            PROP_NONDETERMINISTIC_TRANSITION_OUTPUT_STATES, &output_states,
+                            NULL);
+
+              if (output_states != NULL)
+                stats->bytes += sizeof (GWeakRef) * output_states->len;
+            }
+        }
+    }
+
+  if (STATE_MACHINES_IS_COMPOSITE_STATE (state))
+    {
+      g_autoptr (GPtrArray) composed_from_states = NULL;
+
+      g_object_get (state,
+                    PROP_COMPOSITE_STATE_COMPOSED_FROM_STATES, &composed_from_states,
+                    NULL);
+
+      /* The states a composite state was composed from are not referenced by it (they are usually gone
+       * by now, together with the state machine they belonged to), only the array itself is kept alive.
+       */
+      stats->bytes += fsm_measure_array (composed_from_states);
+    }
+}
+
 static void
 fsm_get_property (GObject    *object,
                   guint       property_id,
@@ -383,7 +593,11 @@ fsm_dispose (GObject *object)
     g_clear_pointer (&priv->non_final_states, g_ptr_array_unref);
 
   if (priv->alphabet != NULL)
-    g_clear_pointer (&priv->alphabet, g_slist_free);
+    {
+      g_slist_free_full (priv->alphabet, (GDestroyNotify) character_set_free);
+
+      priv->alphabet = NULL;
+    }
 
   G_OBJECT_CLASS (fsm_parent_class)->dispose (object);
 }
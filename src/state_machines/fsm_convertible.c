@@ -10,29 +10,33 @@ fsm_convertible_default_init (FsmConvertibleInterface *iface)
 }
 
 FsmConvertible *
-fsm_convertible_compute_epsilon_closures (FsmConvertible *self)
+fsm_convertible_compute_epsilon_closures (FsmConvertible    *self,
+                                          CompilationBudget *budget)
 {
   FsmConvertibleInterface *iface;
 
   g_return_val_if_fail (STATE_MACHINES_IS_FSM_CONVERTIBLE (self), NULL);
+  g_return_val_if_fail (STATE_MACHINES_IS_COMPILATION_BUDGET (budget), NULL);
 
   iface = STATE_MACHINES_FSM_CONVERTIBLE_GET_IFACE (self);
 
   g_return_val_if_fail (iface->compute_epsilon_closures != NULL, NULL);
 
-  return iface->compute_epsilon_closures (self);
+  return iface->compute_epsilon_closures (self, budget);
 }
 
 FsmModifiable *
-fsm_convertible_construct_subset (FsmConvertible *self)
+fsm_convertible_construct_subset (FsmConvertible    *self,
+                                  CompilationBudget *budget)
 {
   FsmConvertibleInterface *iface;
 
   g_return_val_if_fail (STATE_MACHINES_IS_FSM_CONVERTIBLE (self), NULL);
+  g_return_val_if_fail (STATE_MACHINES_IS_COMPILATION_BUDGET (budget), NULL);
 
   iface = STATE_MACHINES_FSM_CONVERTIBLE_GET_IFACE (self);
 
   g_return_val_if_fail (iface->construct_subset != NULL, NULL);
 
-  return iface->construct_subset (self);
+  return iface->construct_subset (self, budget);
 }
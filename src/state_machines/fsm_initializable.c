@@ -44,6 +44,7 @@ fsm_initializable_default_init (FsmInitializableInterface *iface)
                                        g_param_spec_pointer (PROP_FSM_INITIALIZABLE_ALPHABET,
                                                              "Alphabet",
                                                              "Finite set of characters that the state machine"
-                                                               "explicitly recognizes.",
+                                                               "explicitly recognizes, partitioned into disjoint"
+                                                               "character sets.",
                                                              G_PARAM_READABLE));
 }
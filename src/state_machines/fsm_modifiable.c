@@ -10,17 +10,19 @@ fsm_modifiable_default_init (FsmModifiableInterface *iface)
 }
 
 void
-fsm_modifiable_minimize (FsmModifiable *self)
+fsm_modifiable_minimize (FsmModifiable     *self,
+                         CompilationBudget *budget)
 {
   FsmModifiableInterface *iface;
 
   g_return_if_fail (STATE_MACHINES_IS_FSM_MODIFIABLE (self));
+  g_return_if_fail (STATE_MACHINES_IS_COMPILATION_BUDGET (budget));
 
   iface = STATE_MACHINES_FSM_MODIFIABLE_GET_IFACE (self);
 
   g_return_if_fail (iface->minimize != NULL);
 
-  iface->minimize (self);
+  iface->minimize (self, budget);
 }
 
 void
@@ -0,0 +1,166 @@
+#include "internal/state_machines/transitions/character_set.h"
+
+#define CHARACTER_SET_WORD_BITS  64
+#define CHARACTER_SET_WORD_COUNT 4 /* 256 bits - one for each possible byte value. */
+
+/* Bitset describing a set of characters, used as the label of a transition which can be
+ * taken on more than a single character (ranges, bracket expressions, etc.).
+ */
+struct _CharacterSet
+{
+  guint64 words[CHARACTER_SET_WORD_COUNT];
+};
+
+G_DEFINE_BOXED_TYPE (CharacterSet, character_set, character_set_copy, character_set_free)
+
+CharacterSet *
+character_set_new (void)
+{
+  return g_new0 (CharacterSet, 1);
+}
+
+CharacterSet *
+character_set_copy (const CharacterSet *self)
+{
+  g_return_val_if_fail (self != NULL, NULL);
+
+  CharacterSet *copy = g_new (CharacterSet, 1);
+
+  *copy = *self;
+
+  return copy;
+}
+
+void
+character_set_free (CharacterSet *self)
+{
+  g_free (self);
+}
+
+void
+character_set_add (CharacterSet *self,
+                   gchar         character)
+{
+  g_return_if_fail (self != NULL);
+
+  guint8 byte = (guint8) character;
+
+  self->words[byte / CHARACTER_SET_WORD_BITS] |= G_GUINT64_CONSTANT (1) << (byte % CHARACTER_SET_WORD_BITS);
+}
+
+void
+character_set_add_range (CharacterSet *self,
+                         gchar         lower_character,
+                         gchar         upper_character)
+{
+  g_return_if_fail (self != NULL);
+
+  for (guint byte = (guint8) lower_character; byte <= (guint8) upper_character; ++byte)
+    character_set_add (self, (gchar) byte);
+}
+
+void
+character_set_add_set (CharacterSet       *self,
+                       const CharacterSet *other)
+{
+  g_return_if_fail (self != NULL);
+  g_return_if_fail (other != NULL);
+
+  for (guint i = 0; i < CHARACTER_SET_WORD_COUNT; ++i)
+    self->words[i] |= other->words[i];
+}
+
+void
+character_set_remove (CharacterSet *self,
+                      gchar         character)
+{
+  g_return_if_fail (self != NULL);
+
+  guint8 byte = (guint8) character;
+
+  self->words[byte / CHARACTER_SET_WORD_BITS] &= ~(G_GUINT64_CONSTANT (1) << (byte % CHARACTER_SET_WORD_BITS));
+}
+
+void
+character_set_subtract (CharacterSet       *self,
+                        const CharacterSet *other)
+{
+  g_return_if_fail (self != NULL);
+  g_return_if_fail (other != NULL);
+
+  for (guint i = 0; i < CHARACTER_SET_WORD_COUNT; ++i)
+    self->words[i] &= ~other->words[i];
+}
+
+CharacterSet *
+character_set_intersect (const CharacterSet *self,
+                         const CharacterSet *other)
+{
+  g_return_val_if_fail (self != NULL, NULL);
+  g_return_val_if_fail (other != NULL, NULL);
+
+  CharacterSet *intersection = character_set_new ();
+
+  for (guint i = 0; i < CHARACTER_SET_WORD_COUNT; ++i)
+    intersection->words[i] = self->words[i] & other->words[i];
+
+  return intersection;
+}
+
+gboolean
+character_set_contains (const CharacterSet *self,
+                        gchar               character)
+{
+  g_return_val_if_fail (self != NULL, FALSE);
+
+  guint8 byte = (guint8) character;
+
+  return (self->words[byte / CHARACTER_SET_WORD_BITS] >> (byte % CHARACTER_SET_WORD_BITS)) & 1;
+}
+
+gboolean
+character_set_is_empty (const CharacterSet *self)
+{
+  g_return_val_if_fail (self != NULL, TRUE);
+
+  for (guint i = 0; i < CHARACTER_SET_WORD_COUNT; ++i)
+    if (self->words[i] != 0)
+      return FALSE;
+
+  return TRUE;
+}
+
+gboolean
+character_set_equal (const CharacterSet *self,
+                     const CharacterSet *other)
+{
+  g_return_val_if_fail (self != NULL, FALSE);
+  g_return_val_if_fail (other != NULL, FALSE);
+
+  for (guint i = 0; i < CHARACTER_SET_WORD_COUNT; ++i)
+    if (self->words[i] != other->words[i])
+      return FALSE;
+
+  return TRUE;
+}
+
+gchar
+character_set_get_representative (const CharacterSet *self)
+{
+  g_return_val_if_fail (self != NULL, 0);
+
+  /* Any member would do, the lowest one is used so that the result is deterministic. */
+  for (guint i = 0; i < CHARACTER_SET_WORD_COUNT; ++i)
+    if (self->words[i] != 0)
+      return (gchar) (i * CHARACTER_SET_WORD_BITS + (guint) __builtin_ctzll (self->words[i]));
+
+  g_return_val_if_reached (0);
+}
+
+gsize
+character_set_measure (const CharacterSet *self)
+{
+  g_return_val_if_fail (self != NULL, 0);
+
+  return sizeof (CharacterSet);
+}
@@ -4,6 +4,7 @@
 typedef struct
 {
   gchar                 expected_character;
+  CharacterSet         *expected_characters;
   gboolean              requires_input;
   EqualityConditionType condition_type;
 } TransitionPrivate;
@@ -11,6 +12,7 @@ typedef struct
 enum
 {
   PROP_EXPECTED_CHARACTER = 1,
+  PROP_EXPECTED_CHARACTERS,
   PROP_REQUIRES_INPUT,
   PROP_EQUALITY_CONDITION_TYPE,
   N_PROPERTIES
@@ -39,6 +41,8 @@ static void       transition_set_property              (GObject               *o
                                                         const GValue          *value,
                                                         GParamSpec            *pspec);
 
+static void       transition_dispose                   (GObject               *object);
+
 G_DEFINE_ABSTRACT_TYPE_WITH_PRIVATE (Transition, transition, G_TYPE_OBJECT)
 
 static void
@@ -48,16 +52,24 @@ transition_class_init (TransitionClass *klass)
 
   object_class->get_property = transition_get_property;
   object_class->set_property = transition_set_property;
+  object_class->dispose = transition_dispose;
 
   obj_properties[PROP_EXPECTED_CHARACTER] =
     g_param_spec_char (PROP_TRANSITION_EXPECTED_CHARACTER,
                        "Expected character",
                        "Expected character used to check if the equality condition is met.",
-                       0,
+                       G_MININT8,
                        G_MAXINT8,
                        0,
                        G_PARAM_CONSTRUCT_ONLY | G_PARAM_READWRITE);
 
+  obj_properties[PROP_EXPECTED_CHARACTERS] =
+    g_param_spec_boxed (PROP_TRANSITION_EXPECTED_CHARACTERS,
+                        "Expected characters",
+                        "Set of expected characters used to check if the membership condition is met.",
+                        TRANSITIONS_TYPE_CHARACTER_SET,
+                        G_PARAM_CONSTRUCT_ONLY | G_PARAM_READWRITE);
+
   obj_properties[PROP_REQUIRES_INPUT] =
     g_param_spec_boolean (PROP_TRANSITION_REQUIRES_INPUT,
                           "Requires input",
@@ -71,7 +83,7 @@ transition_class_init (TransitionClass *klass)
                        "Equality condition type",
                        "Type of equality condition that needs to be satisfied in order for the transition to occur.",
                        EQUALITY_CONDITION_TYPE_UNDEFINED,
-                       EQUALITY_CONDITION_TYPE_NOT_EQUAL,
+                       EQUALITY_CONDITION_TYPE_IN_SET,
                        EQUALITY_CONDITION_TYPE_EQUAL,
                        G_PARAM_CONSTRUCT_ONLY | G_PARAM_READWRITE);
 
@@ -110,6 +122,10 @@ transition_is_possible (Transition *self,
       TransitionPrivate *priv = transition_get_instance_private (self);
       gchar expected_character = priv->expected_character;
       EqualityConditionType condition_type = priv->condition_type;
+
+      if (condition_type == EQUALITY_CONDITION_TYPE_IN_SET)
+        return character_set_contains (priv->expected_characters, input_character);
+
       GEqualFunc equality_function = transition_discern_equality_function (condition_type);
 
       g_return_val_if_fail (equality_function != NULL, FALSE);
@@ -188,6 +204,48 @@ transition_convert_to_epsilon (Transition *self)
     }
 }
 
+CharacterSet *
+transition_fetch_expected_characters (Transition *self)
+{
+  g_return_val_if_fail (TRANSITIONS_IS_TRANSITION (self), NULL);
+
+  TransitionPrivate *priv = transition_get_instance_private (self);
+  CharacterSet *expected_characters = NULL;
+
+  switch (priv->condition_type)
+    {
+    case EQUALITY_CONDITION_TYPE_IN_SET:
+      expected_characters = character_set_copy (priv->expected_characters);
+      break;
+
+    case EQUALITY_CONDITION_TYPE_EQUAL:
+      expected_characters = character_set_new ();
+
+      character_set_add (expected_characters, priv->expected_character);
+      break;
+
+    case EQUALITY_CONDITION_TYPE_ANY:
+    case EQUALITY_CONDITION_TYPE_NOT_EQUAL:
+      /* Every byte is expected except the start and end of text special characters
+       * as they are not allowed to be covered by this type of equality.
+       */
+      expected_characters = character_set_new ();
+
+      character_set_add_range (expected_characters, EPSILON + 1, (gchar) G_MAXUINT8);
+      character_set_remove (expected_characters, START);
+      character_set_remove (expected_characters, END);
+
+      if (priv->condition_type == EQUALITY_CONDITION_TYPE_NOT_EQUAL)
+        character_set_remove (expected_characters, priv->expected_character);
+      break;
+
+    default:
+      g_return_val_if_reached (NULL);
+    }
+
+  return expected_characters;
+}
+
 gint
 transition_compare_equality_condition_type (Transition *a,
                                             Transition *b)
@@ -267,6 +325,10 @@ transition_get_property (GObject    *object,
       g_value_set_schar (value, priv->expected_character);
       break;
 
+    case PROP_EXPECTED_CHARACTERS:
+      g_value_set_boxed (value, priv->expected_characters);
+      break;
+
     case PROP_REQUIRES_INPUT:
       g_value_set_boolean (value, priv->requires_input);
       break;
@@ -295,6 +357,13 @@ transition_set_property (GObject      *object,
       priv->expected_character = g_value_get_schar (value);
       break;
 
+    case PROP_EXPECTED_CHARACTERS:
+      if (priv->expected_characters != NULL)
+        character_set_free (priv->expected_characters);
+
+      priv->expected_characters = g_value_dup_boxed (value);
+      break;
+
     case PROP_REQUIRES_INPUT:
       priv->requires_input = g_value_get_boolean (value);
       break;
@@ -308,3 +377,14 @@ transition_set_property (GObject      *object,
       break;
     }
 }
+
+static void
+transition_dispose (GObject *object)
+{
+  TransitionPrivate *priv = transition_get_instance_private (TRANSITIONS_TRANSITION (object));
+
+  if (priv->expected_characters != NULL)
+    g_clear_pointer (&priv->expected_characters, character_set_free);
+
+  G_OBJECT_CLASS (transition_parent_class)->dispose (object);
+}
@@ -46,6 +46,18 @@ create_nondeterministic_transition (gchar      expected_character,
                                           PROP_NONDETERMINISTIC_TRANSITION_OUTPUT_STATES, output_states);
 }
 
+Transition *
+create_nondeterministic_set_transition (CharacterSet *expected_characters,
+                                        GPtrArray    *output_states)
+{
+  g_return_val_if_fail (expected_characters != NULL, NULL);
+
+  return nondeterministic_transition_new (PROP_TRANSITION_EXPECTED_CHARACTERS, expected_characters,
+                                          PROP_TRANSITION_REQUIRES_INPUT, TRUE,
+                                          PROP_TRANSITION_EQUALITY_CONDITION_TYPE, EQUALITY_CONDITION_TYPE_IN_SET,
+                                          PROP_NONDETERMINISTIC_TRANSITION_OUTPUT_STATES, output_states);
+}
+
 Transition *
 create_deterministic_transition (gchar  expected_character,
                                  State *output_state)
@@ -63,6 +75,18 @@ create_deterministic_transition (gchar  expected_character,
                                        PROP_DETERMINISTIC_TRANSITION_OUTPUT_STATE, output_state);
 }
 
+Transition *
+create_deterministic_set_transition (CharacterSet *expected_characters,
+                                     State        *output_state)
+{
+  g_return_val_if_fail (expected_characters != NULL, NULL);
+
+  return deterministic_transition_new (PROP_TRANSITION_EXPECTED_CHARACTERS, expected_characters,
+                                       PROP_TRANSITION_REQUIRES_INPUT, TRUE,
+                                       PROP_TRANSITION_EQUALITY_CONDITION_TYPE, EQUALITY_CONDITION_TYPE_IN_SET,
+                                       PROP_DETERMINISTIC_TRANSITION_OUTPUT_STATE, output_state);
+}
+
 Transition *
 create_mealy_transition (gchar     expected_character,
                          State    *output_state,
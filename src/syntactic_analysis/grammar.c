@@ -245,6 +245,7 @@ grammar_define_productions (GPtrArray **productions,
           (gchar*[]) { STAR_QUANTIFICATION, NULL          },
           (gchar*[]) { PLUS_QUANTIFICATION, NULL          },
           (gchar*[]) { QUESTION_MARK_QUANTIFICATION, NULL },
+          (gchar*[]) { BOUNDED_QUANTIFICATION, NULL       },
           (gchar*[]) { EPSILON, NULL                      },
           NULL
         },
@@ -266,6 +267,45 @@ grammar_define_productions (GPtrArray **productions,
           (gchar*[]) { "?", NULL },
           NULL
         },
+      (gchar**[])
+        {
+          (gchar*[]) { BOUNDED_QUANTIFICATION },
+          (gchar*[]) { "{", QUANTIFICATION_BOUNDS, "}", NULL },
+          NULL
+        },
+      (gchar**[])
+        {
+          (gchar*[]) { QUANTIFICATION_BOUNDS },
+          (gchar*[]) { QUANTIFICATION_BOUND, QUANTIFICATION_BOUNDS_PRIME, NULL },
+          NULL
+        },
+      (gchar**[])
+        {
+          (gchar*[]) { QUANTIFICATION_BOUNDS_PRIME },
+          (gchar*[]) { ",", UPPER_QUANTIFICATION_BOUND, NULL },
+          (gchar*[]) { EPSILON, NULL                         },
+          NULL
+        },
+      (gchar**[])
+        {
+          (gchar*[]) { UPPER_QUANTIFICATION_BOUND },
+          (gchar*[]) { QUANTIFICATION_BOUND, NULL },
+          (gchar*[]) { EPSILON, NULL              },
+          NULL
+        },
+      (gchar**[])
+        {
+          (gchar*[]) { QUANTIFICATION_BOUND },
+          (gchar*[]) { QUANTIFICATION_BOUND_DIGIT, QUANTIFICATION_BOUND_PRIME, NULL },
+          NULL
+        },
+      (gchar**[])
+        {
+          (gchar*[]) { QUANTIFICATION_BOUND_PRIME },
+          (gchar*[]) { QUANTIFICATION_BOUND, NULL },
+          (gchar*[]) { EPSILON, NULL              },
+          NULL
+        },
       (gchar**[])
         {
           (gchar*[]) { ELEMENTARY_EXPRESSION },
@@ -276,6 +316,7 @@ grammar_define_productions (GPtrArray **productions,
           (gchar*[]) { LOWER_CASE_LETTER, NULL                 },
           (gchar*[]) { DIGIT, NULL                             },
           (gchar*[]) { SPECIAL_CHARACTER, NULL                 },
+          (gchar*[]) { NON_ASCII_CHARACTER, NULL               },
           (gchar*[]) { BRACKET_EXPRESSION_METACHARACTER, NULL  },
           (gchar*[]) { ANY_CHARACTER, NULL                     },
           (gchar*[]) { "\\", ELEMENTARY_EXPRESSION_PRIME, NULL },
@@ -297,7 +338,18 @@ grammar_define_productions (GPtrArray **productions,
       (gchar**[])
         {
           (gchar*[]) { BRACKET_EXPRESSION },
-          (gchar*[]) {"[", BRACKET_EXPRESSION_ITEMS, "]", NULL },
+          (gchar*[]) {"[", BRACKET_EXPRESSION_NEGATION, BRACKET_EXPRESSION_ITEMS, "]", NULL },
+          NULL
+        },
+      /* The caret is a regular metacharacter (and therefore an ordinary bracket expression item) unless
+       * it immediately follows the opening bracket, its own terminal symbol precedes the metacharacters'
+       * one which makes it the preferred parsing table key.
+       */
+      (gchar**[])
+        {
+          (gchar*[]) { BRACKET_EXPRESSION_NEGATION },
+          (gchar*[]) { "^", NULL     },
+          (gchar*[]) { EPSILON, NULL },
           NULL
         },
       (gchar**[])
@@ -319,6 +371,7 @@ grammar_define_productions (GPtrArray **productions,
           (gchar*[]) { UPPER_CASE_LETTER, UPPER_CASE_LETTER_RANGE, NULL },
           (gchar*[]) { LOWER_CASE_LETTER, LOWER_CASE_LETTER_RANGE, NULL },
           (gchar*[]) { DIGIT, DIGIT_RANGE, NULL                         },
+          (gchar*[]) { NON_ASCII_CHARACTER, NON_ASCII_CHARACTER_RANGE, NULL },
           (gchar*[]) { SPECIAL_CHARACTER, NULL                          },
           (gchar*[]) { REGULAR_METACHARACTER, NULL                      },
           (gchar*[]) { "\\", BRACKET_EXPRESSION_ITEM_PRIME, NULL        },
@@ -352,6 +405,13 @@ grammar_define_productions (GPtrArray **productions,
           (gchar*[]) { EPSILON, NULL    },
           NULL
         },
+      (gchar**[])
+        {
+          (gchar*[]) { NON_ASCII_CHARACTER_RANGE },
+          (gchar*[]) { "-", NON_ASCII_CHARACTER, NULL },
+          (gchar*[]) { EPSILON, NULL                  },
+          NULL
+        },
       (gchar**[])
         {
           (gchar*[]) { UPPER_CASE_LETTER },
@@ -379,6 +439,23 @@ grammar_define_productions (GPtrArray **productions,
                        "6" DELIMITER "7" DELIMITER "8" DELIMITER "9", NULL },
           NULL
         },
+      /* Non-ASCII characters are ordinary characters, the terminal symbol stands for all of them. */
+      (gchar**[])
+        {
+          (gchar*[]) { NON_ASCII_CHARACTER },
+          (gchar*[]) { TERMINAL_NON_ASCII_CHARACTER, NULL },
+          NULL
+        },
+      /* Digits of quantification bounds are not constants, a separate production (sharing the same
+       * terminal symbol) keeps them from being turned into abstract syntax tree nodes.
+       */
+      (gchar**[])
+        {
+          (gchar*[]) { QUANTIFICATION_BOUND_DIGIT },
+          (gchar*[]) { "0" DELIMITER "1" DELIMITER "2" DELIMITER "3" DELIMITER "4" DELIMITER "5" DELIMITER
+                       "6" DELIMITER "7" DELIMITER "8" DELIMITER "9", NULL },
+          NULL
+        },
       (gchar**[])
         {
           (gchar*[]) { SPECIAL_CHARACTER },
@@ -386,14 +463,14 @@ grammar_define_productions (GPtrArray **productions,
           (gchar*[]) { HORIZONTAL_TAB, NULL },
           (gchar*[]) { "!" DELIMITER "#" DELIMITER "%" DELIMITER "&" DELIMITER "," DELIMITER "/" DELIMITER
                        ":" DELIMITER ";" DELIMITER ">" DELIMITER "=" DELIMITER "<" DELIMITER "@" DELIMITER
-                       "_" DELIMITER "`" DELIMITER "{" DELIMITER "}" DELIMITER, NULL },
+                       "_" DELIMITER "`" DELIMITER "}" DELIMITER, NULL },
           NULL
         },
       (gchar**[])
         {
           (gchar*[]) { REGULAR_METACHARACTER },
           (gchar*[]) { "^" DELIMITER "$" DELIMITER "[" DELIMITER "(" DELIMITER ")" DELIMITER "*" DELIMITER
-                       "+" DELIMITER "?" DELIMITER "|" DELIMITER ".", NULL },
+                       "+" DELIMITER "?" DELIMITER "{" DELIMITER "|" DELIMITER ".", NULL },
           NULL
         },
       (gchar**[])
@@ -2,12 +2,12 @@
 #include "internal/syntactic_analysis/grammar.h"
 #include "internal/syntactic_analysis/production.h"
 #include "internal/syntactic_analysis/rule.h"
-#include "internal/syntactic_analysis/derivation_item.h"
 #include "internal/syntactic_analysis/parsing_table_key.h"
 #include "internal/syntactic_analysis/symbols/terminal.h"
 #include "internal/syntactic_analysis/symbols/non_terminal.h"
 #include "internal/lexical_analysis/token.h"
 #include "internal/lexical_analysis/lexeme.h"
+#include "internal/semantic_analysis/analyzer.h"
 #include "internal/common/helpers.h"
 #include "core/errors.h"
 
@@ -18,24 +18,28 @@ struct _Parser
 
 typedef struct
 {
-  GQueue  *analysis_queue;
-  GQueue  *prediction_queue;
-  Grammar *grammar;
+  GQueue    *prediction_queue;
+  GPtrArray *semantic_stack;
+  GArray    *semantic_frames;
+  Grammar   *grammar;
+  Analyzer  *analyzer;
 } ParserPrivate;
 
 static void       parser_prepare_for_parsing        (Parser          *self);
 
-static gboolean   parser_predict                    (Grammar         *grammar,
+static gboolean   parser_predict                    (Parser          *self,
                                                      Symbol          *non_terminal,
-                                                     Token           *token,
-                                                     GQueue          *analysis_queue,
-                                                     GQueue          *prediction_queue);
+                                                     Token           *token);
 
-static void       parser_expand_queues              (GQueue          *analysis_queue,
-                                                     GQueue          *prediction_queue,
+static void       parser_expand                     (Parser          *self,
                                                      Production      *production,
                                                      Rule            *rule);
 
+static void       parser_reduce                     (Parser          *self,
+                                                     Production      *production);
+
+static void       parser_clear_semantic_stack       (Parser          *self);
+
 static GPtrArray *parser_create_parsing_table_keys  (Grammar         *grammar,
                                                      Symbol          *non_terminal,
                                                      Token           *token,
@@ -44,11 +48,6 @@ static GPtrArray *parser_create_parsing_table_keys  (Grammar         *grammar,
 static gboolean   parser_can_accept                 (Symbol          *terminal,
                                                      Token           *token);
 
-static GNode     *parser_transform_analysis         (GQueue          *analysis_queue);
-
-static void       parser_insert_children            (GNode           *root,
-                                                     GQueue          *analysis_queue);
-
 static void       parser_report_error               (guint            token_position,
                                                      GPtrArray       *all_tokens,
                                                      gboolean         parsing_table_entry_found,
@@ -80,17 +79,21 @@ static void
 parser_init (Parser *self)
 {
   ParserPrivate *priv = parser_get_instance_private (SYNTACTIC_ANALYSIS_PARSER (self));
-  GQueue *analysis_queue = g_queue_new ();
   GQueue *prediction_queue = g_queue_new ();
+  GPtrArray *semantic_stack = g_ptr_array_new ();
+  GArray *semantic_frames = g_array_new (FALSE, FALSE, sizeof (guint));
   Grammar *grammar = grammar_new ();
+  Analyzer *analyzer = analyzer_new ();
 
-  priv->analysis_queue = analysis_queue;
   priv->prediction_queue = prediction_queue;
+  priv->semantic_stack = semantic_stack;
+  priv->semantic_frames = semantic_frames;
   priv->grammar = grammar;
+  priv->analyzer = analyzer;
 }
 
-GNode *
-parser_build_concrete_syntax_tree (Parser     *self,
+AstNode *
+parser_build_abstract_syntax_tree (Parser     *self,
                                    GPtrArray  *tokens,
                                    GError    **error)
 {
@@ -98,21 +101,22 @@ parser_build_concrete_syntax_tree (Parser     *self,
   g_return_val_if_fail (g_collection_has_items (tokens), NULL);
   g_return_val_if_fail (error == NULL || *error == NULL, NULL);
 
-  /* Preparing the prediction and analysis queues using
+  /* Preparing the prediction queue and the semantic stack using
    * the grammar's start production and its sole rule.
    */
   parser_prepare_for_parsing (self);
 
   ParserPrivate *priv = parser_get_instance_private (self);
   GQueue *prediction_queue = priv->prediction_queue;
-  GQueue *analysis_queue = priv->analysis_queue;
-  Grammar *grammar = priv->grammar;
+  GPtrArray *semantic_stack = priv->semantic_stack;
   guint token_position = 0;
-  Symbol *prediction_head = g_queue_pop_head (prediction_queue);
+  gpointer prediction_head = g_queue_pop_head (prediction_queue);
   gboolean parsing_table_entry_found = FALSE;
-  GNode *concrete_syntax_tree = NULL;
+  AstNode *abstract_syntax_tree = NULL;
 
-  /* LL(1) parsing. */
+  /* LL(1) parsing, the abstract syntax tree is built along the way by using
+   * the semantic actions provided by the analyzer.
+   */
   while (TRUE)
     {
       Token *token = g_ptr_array_index (tokens, token_position);
@@ -120,10 +124,10 @@ parser_build_concrete_syntax_tree (Parser     *self,
 
       if (SYMBOLS_IS_TERMINAL (prediction_head))
         {
-          /* Skipping the epsilon symbol. */
+          /* The epsilon symbol does not consume any input, its semantic value is missing. */
           if (!symbol_is_epsilon (prediction_head))
             {
-              g_queue_push_tail (analysis_queue, g_object_ref (token));
+              g_ptr_array_add (semantic_stack, g_object_ref (token));
 
               /* Checking if the input is exhausted by examining whether the
                * current token is an end of input marker and whether or not
@@ -131,11 +135,24 @@ parser_build_concrete_syntax_tree (Parser     *self,
                */
               if (parser_can_accept (prediction_head, token))
                 {
-                  /* Transforming the analysis queue (which actually represents
-                   * a leftmost derivation of the input, in reverse) into a
-                   * concrete syntax tree.
+                  /* Performing the remaining reductions (the start production's, at the very least)
+                   * which leaves the root of the abstract syntax tree as the sole semantic value.
                    */
-                  concrete_syntax_tree = parser_transform_analysis (analysis_queue);
+                  prediction_head = g_queue_pop_head (prediction_queue);
+
+                  while (SYNTACTIC_ANALYSIS_IS_PRODUCTION (prediction_head))
+                    {
+                      parser_reduce (self, prediction_head);
+
+                      prediction_head = g_queue_pop_head (prediction_queue);
+                    }
+
+                  abstract_syntax_tree = g_ptr_array_index (semantic_stack, 0);
+
+                  g_ptr_array_set_size (semantic_stack, 0);
+
+                  if (!ast_node_is_valid (abstract_syntax_tree, error))
+                    g_clear_object (&abstract_syntax_tree);
 
                   break;
                 }
@@ -143,6 +160,10 @@ parser_build_concrete_syntax_tree (Parser     *self,
               /* Moving on to the next token. */
               token_position++;
             }
+          else
+            {
+              g_ptr_array_add (semantic_stack, NULL);
+            }
 
           prediction_head = g_queue_pop_head (prediction_queue);
         }
@@ -150,18 +171,24 @@ parser_build_concrete_syntax_tree (Parser     *self,
         {
           /* Trying to find an eligible rule belonging to the prediction head's
            * underlying production.
-           * In case it is found both the prediction queue as well as the
-           * analysis queue are expanded accordingly.
+           * In case it is found the prediction queue is expanded accordingly.
            */
-          parsing_table_entry_found = parser_predict (grammar,
+          parsing_table_entry_found = parser_predict (self,
                                                       prediction_head,
-                                                      token,
-                                                      analysis_queue,
-                                                      prediction_queue);
+                                                      token);
 
           if (parsing_table_entry_found)
             prediction_head = g_queue_pop_head (prediction_queue);
         }
+      else if (SYNTACTIC_ANALYSIS_IS_PRODUCTION (prediction_head))
+        {
+          /* Every symbol of the production's chosen rule has been matched,
+           * the corresponding semantic action can now be performed.
+           */
+          parser_reduce (self, prediction_head);
+
+          prediction_head = g_queue_pop_head (prediction_queue);
+        }
 
       /* Reporting errors (if required). */
       parser_report_error (token_position,
@@ -178,21 +205,22 @@ parser_build_concrete_syntax_tree (Parser     *self,
         }
     }
 
-  return concrete_syntax_tree;
+  parser_clear_semantic_stack (self);
+
+  return abstract_syntax_tree;
 }
 
 static void
 parser_prepare_for_parsing (Parser *self)
 {
   ParserPrivate *priv = parser_get_instance_private (SYNTACTIC_ANALYSIS_PARSER (self));
-  GQueue *analysis_queue = priv->analysis_queue;
   GQueue *prediction_queue = priv->prediction_queue;
   Grammar *grammar = priv->grammar;
   g_autoptr (Production) start_production = NULL;
   g_autoptr (GPtrArray) rules = NULL;
 
-  g_queue_clear (analysis_queue);
   g_queue_clear (prediction_queue);
+  parser_clear_semantic_stack (self);
 
   g_object_get (grammar,
                 PROP_GRAMMAR_START_PRODUCTION, &start_production,
@@ -203,21 +231,20 @@ parser_prepare_for_parsing (Parser *self)
 
   Rule *first_rule = g_ptr_array_index (rules, 0);
 
-  parser_expand_queues (analysis_queue,
-                        prediction_queue,
-                        start_production,
-                        first_rule);
+  parser_expand (self,
+                 start_production,
+                 first_rule);
 }
 
 static gboolean
-parser_predict (Grammar *grammar,
-                Symbol  *non_terminal,
-                Token   *token,
-                GQueue  *analysis_queue,
-                GQueue  *prediction_queue)
+parser_predict (Parser *self,
+                Symbol *non_terminal,
+                Token  *token)
 {
   g_return_val_if_fail (SYMBOLS_IS_NON_TERMINAL (non_terminal), FALSE);
 
+  ParserPrivate *priv = parser_get_instance_private (self);
+  Grammar *grammar = priv->grammar;
   Production *extracted_production = NULL;
   g_autoptr (GPtrArray) parsing_table_keys = parser_create_parsing_table_keys (grammar,
                                                                                non_terminal,
@@ -236,10 +263,9 @@ parser_predict (Grammar *grammar,
 
       if (found_rule != NULL)
         {
-          parser_expand_queues (analysis_queue,
-                                prediction_queue,
-                                extracted_production,
-                                found_rule);
+          parser_expand (self,
+                         extracted_production,
+                         found_rule);
 
           return TRUE;
         }
@@ -249,21 +275,26 @@ parser_predict (Grammar *grammar,
 }
 
 static void
-parser_expand_queues (GQueue     *analysis_queue,
-                      GQueue     *prediction_queue,
-                      Production *production,
-                      Rule       *rule)
+parser_expand (Parser     *self,
+               Production *production,
+               Rule       *rule)
 {
+  ParserPrivate *priv = parser_get_instance_private (self);
+  GQueue *prediction_queue = priv->prediction_queue;
+  GPtrArray *semantic_stack = priv->semantic_stack;
+  GArray *semantic_frames = priv->semantic_frames;
   g_autoptr (GPtrArray) symbols = NULL;
 
   g_object_get (rule,
                 PROP_RULE_SYMBOLS, &symbols,
                 NULL);
 
-  DerivationItem *derivation_item = derivation_item_new (PROP_DERIVATION_ITEM_LEFT_HAND_SIDE, production,
-                                                         PROP_DERIVATION_ITEM_RIGHT_HAND_SIDE, rule);
-
-  g_queue_push_tail (analysis_queue, derivation_item);
+  /* The production itself is placed right after the rule's symbols and it marks the point
+   * at which its semantic action needs to be performed, using the semantic values that
+   * have been pushed onto the semantic stack since the current frame was opened.
+   */
+  g_queue_push_head (prediction_queue, production);
+  g_array_append_val (semantic_frames, semantic_stack->len);
 
   for (guint i = symbols->len - 1; i != G_MAXUINT; --i)
     {
@@ -273,6 +304,52 @@ parser_expand_queues (GQueue     *analysis_queue,
     }
 }
 
+static void
+parser_reduce (Parser     *self,
+               Production *production)
+{
+  ParserPrivate *priv = parser_get_instance_private (self);
+  GPtrArray *semantic_stack = priv->semantic_stack;
+  GArray *semantic_frames = priv->semantic_frames;
+
+  g_assert (g_collection_has_items (semantic_frames));
+
+  guint frame_start = g_array_index (semantic_frames, guint, semantic_frames->len - 1);
+  guint n_values = semantic_stack->len - frame_start;
+  gpointer *values = semantic_stack->pdata + frame_start;
+  GObject *reduced_value = analyzer_reduce (priv->analyzer,
+                                            production,
+                                            values,
+                                            n_values);
+
+  /* Replacing the frame's semantic values with the reduced one. */
+  for (guint i = 0; i < n_values; ++i)
+    if (values[i] != NULL)
+      g_object_unref (values[i]);
+
+  g_ptr_array_set_size (semantic_stack, frame_start);
+  g_ptr_array_add (semantic_stack, reduced_value);
+  g_array_set_size (semantic_frames, semantic_frames->len - 1);
+}
+
+static void
+parser_clear_semantic_stack (Parser *self)
+{
+  ParserPrivate *priv = parser_get_instance_private (self);
+  GPtrArray *semantic_stack = priv->semantic_stack;
+
+  for (guint i = 0; i < semantic_stack->len; ++i)
+    {
+      gpointer value = g_ptr_array_index (semantic_stack, i);
+
+      if (value != NULL)
+        g_object_unref (value);
+    }
+
+  g_ptr_array_set_size (semantic_stack, 0);
+  g_array_set_size (priv->semantic_frames, 0);
+}
+
 static GPtrArray *
 parser_create_parsing_table_keys (Grammar     *grammar,
                                   Symbol      *non_terminal,
@@ -302,6 +379,12 @@ parser_create_parsing_table_keys (Grammar     *grammar,
                 PROP_LEXEME_CONTENT, &lexeme_content,
                 NULL);
 
+  /* Every non-ASCII character is matched by the same terminal symbol. */
+  gchar *terminal_value = lexeme_content->str;
+
+  if ((guint8) *terminal_value > G_MAXINT8)
+    terminal_value = TERMINAL_NON_ASCII_CHARACTER;
+
   /* Multiple parsing table keys are required as certain overlaps
    * exist concerning some of the terminal symbols' values.
    */
@@ -309,7 +392,7 @@ parser_create_parsing_table_keys (Grammar     *grammar,
     {
       Symbol *terminal = g_ptr_array_index (all_terminals, i);
 
-      if (symbol_is_match (terminal, lexeme_content->str))
+      if (symbol_is_match (terminal, terminal_value))
         {
           ParsingTableKey *parsing_table_key = parsing_table_key_new (PROP_PARSING_TABLE_KEY_PRODUCTION, production,
                                                                       PROP_PARSING_TABLE_KEY_TERMINAL, terminal);
@@ -353,80 +436,6 @@ parser_can_accept (Symbol *terminal,
   return FALSE;
 }
 
-static GNode *
-parser_transform_analysis (GQueue *analysis_queue)
-{
-  GNode *concrete_syntax_tree = NULL;
-  DerivationItem *start_derivation_item = g_queue_peek_head (analysis_queue);
-  g_autoptr (Production) start_left_hand_side = NULL;
-
-  g_object_get (start_derivation_item,
-                PROP_DERIVATION_ITEM_LEFT_HAND_SIDE, &start_left_hand_side,
-                NULL);
-
-  Symbol *symbol = non_terminal_new (PROP_SYMBOL_VALUE, start_left_hand_side);
-
-  concrete_syntax_tree = g_node_new (symbol);
-
-  parser_insert_children (concrete_syntax_tree, analysis_queue);
-
-  return concrete_syntax_tree;
-}
-
-static void
-parser_insert_children (GNode  *root,
-                        GQueue *analysis_queue)
-{
-  g_assert (!g_queue_is_empty (analysis_queue));
-
-  g_autoptr (DerivationItem) derivation_item = g_queue_pop_head (analysis_queue);
-  g_autoptr (Rule) right_hand_side = NULL;
-  g_autoptr (GPtrArray) symbols = NULL;
-
-  g_object_get (derivation_item,
-                PROP_DERIVATION_ITEM_RIGHT_HAND_SIDE, &right_hand_side,
-                NULL);
-  g_object_get (right_hand_side,
-                PROP_RULE_SYMBOLS, &symbols,
-                NULL);
-
-  for (guint i = 0; i < symbols->len; ++i)
-    {
-      Symbol *symbol = g_ptr_array_index (symbols, i);
-      GNode *child = NULL;
-
-      /* Terminals need to be exchanged with their equivalent
-       * tokens (which are guaranteed to be positioned right after them,
-       * with the notable exception of epsilon) as these objects are more
-       * useful in the succeeding stages of processing.
-       */
-      if (SYMBOLS_IS_TERMINAL (symbol))
-        {
-          if (!symbol_is_epsilon (symbol))
-            {
-              Token *token = g_queue_pop_head (analysis_queue);
-
-              child = g_node_new (token);
-            }
-          else
-            {
-              child = g_node_new (g_object_ref (symbol));
-            }
-
-          g_node_insert (root, i, child);
-        }
-      /* Non-terminals need to be transformed further, recursively. */
-      else if (SYMBOLS_IS_NON_TERMINAL (symbol))
-        {
-          child = g_node_new (g_object_ref (symbol));
-
-          g_node_insert (root, i, child);
-
-          parser_insert_children (child, analysis_queue);
-        }
-    }
-}
-
 static void
 parser_report_error (guint       token_position,
                      GPtrArray  *all_tokens,
@@ -460,14 +469,41 @@ parser_report_error (guint       token_position,
 
       if (token_category == TOKEN_CATEGORY_END_OF_INPUT_MARKER)
         {
-          TokenCategory categories[] = { TOKEN_CATEGORY_OPEN_PARENTHESIS,
-                                         TOKEN_CATEGORY_CLOSE_PARENTHESIS,
-                                         TOKEN_CATEGORY_OPEN_BRACKET,
-                                         TOKEN_CATEGORY_ALTERNATION_OPERATOR,
-                                         TOKEN_CATEGORY_METACHARACTER_ESCAPE,
-                                         TOKEN_CATEGORY_END_ANCHOR };
+          Token *found_token = NULL;
+          Token *close_brace_token = NULL;
+          guint found_token_position = 0;
+          guint close_brace_token_position = 0;
 
-          g_array_append_vals (additional_categories, categories, G_N_ELEMENTS (categories));
+          /* Bounds of a quantification operator are unterminated only if the last opening brace
+           * is not followed by a closing one.
+           */
+          if (parser_token_exists_in_all_tokens (all_tokens,
+                                                 TOKEN_CATEGORY_BOUNDED_QUANTIFICATION_OPERATOR,
+                                                 starting_position,
+                                                 &found_token,
+                                                 &found_token_position) &&
+              (!parser_token_exists_in_all_tokens (all_tokens,
+                                                   TOKEN_CATEGORY_CLOSE_BRACE,
+                                                   starting_position,
+                                                   &close_brace_token,
+                                                   &close_brace_token_position) ||
+               close_brace_token_position < found_token_position))
+            {
+              invalid_token = found_token;
+              error_code = SYNTACTIC_ANALYSIS_PARSER_ERROR_UNMATCHED_OPEN_BRACE;
+              error_message = "Unmatched open brace";
+            }
+          else
+            {
+              TokenCategory categories[] = { TOKEN_CATEGORY_OPEN_PARENTHESIS,
+                                             TOKEN_CATEGORY_CLOSE_PARENTHESIS,
+                                             TOKEN_CATEGORY_OPEN_BRACKET,
+                                             TOKEN_CATEGORY_ALTERNATION_OPERATOR,
+                                             TOKEN_CATEGORY_METACHARACTER_ESCAPE,
+                                             TOKEN_CATEGORY_END_ANCHOR };
+
+              g_array_append_vals (additional_categories, categories, G_N_ELEMENTS (categories));
+            }
         }
       else if (token_category == TOKEN_CATEGORY_CLOSE_PARENTHESIS)
         {
@@ -619,6 +655,7 @@ parser_report_error (guint       token_position,
             case TOKEN_CATEGORY_STAR_QUANTIFICATION_OPERATOR:
             case TOKEN_CATEGORY_PLUS_QUANTIFICATION_OPERATOR:
             case TOKEN_CATEGORY_QUESTION_MARK_QUANTIFICATION_OPERATOR:
+            case TOKEN_CATEGORY_BOUNDED_QUANTIFICATION_OPERATOR:
               error_code = SYNTACTIC_ANALYSIS_PARSER_ERROR_DANGLING_QUANTIFICATION_OPERATOR;
               error_message = "Dangling quantification operator";
               break;
@@ -693,8 +730,15 @@ parser_dispose (GObject *object)
 {
   ParserPrivate *priv = parser_get_instance_private (SYNTACTIC_ANALYSIS_PARSER (object));
 
-  if (priv->analysis_queue != NULL)
-    g_clear_pointer (&priv->analysis_queue, g_queue_unref_g_objects);
+  if (priv->semantic_stack != NULL)
+    {
+      parser_clear_semantic_stack (SYNTACTIC_ANALYSIS_PARSER (object));
+
+      g_clear_pointer (&priv->semantic_stack, g_ptr_array_unref);
+    }
+
+  if (priv->semantic_frames != NULL)
+    g_clear_pointer (&priv->semantic_frames, g_array_unref);
 
   if (priv->prediction_queue != NULL)
     g_clear_pointer (&priv->prediction_queue, g_queue_free);
@@ -702,5 +746,8 @@ parser_dispose (GObject *object)
   if (priv->grammar != NULL)
     g_clear_object (&priv->grammar);
 
+  if (priv->analyzer != NULL)
+    g_clear_object (&priv->analyzer);
+
   G_OBJECT_CLASS (parser_parent_class)->dispose (object);
 }
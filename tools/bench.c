@@ -0,0 +1,1116 @@
+#include "regexperience.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+/* Measures the compilation latency and the matching throughput of a fixed corpus of expressions against
+ * generated inputs, the results are written out as JSON. The same corpus can be run through GLib's GRegex
+ * as well, in which case its numbers and the matches both engines agree on are reported alongside.
+ *
+ * The scaling mode compiles families of expressions growing with a parameter instead, in order to find out
+ * how the time spent in the most expensive phases grows with the size of what each one of them processes.
+ *
+ * The units saved by the fuzzer (an expression followed by its input, see fuzz.c) can be replayed on top
+ * of the corpus, each one of them is matched against its own input as well as the generated ones.
+ */
+
+#define BENCH_DEFAULT_INPUT_SIZE (1024 * 1024)
+#define BENCH_DEFAULT_ITERATIONS 5
+#define BENCH_DEFAULT_SEED       42
+#define BENCH_BYTES_PER_MB       1000000.0
+
+#define BENCH_DEFAULT_MAX_EXPONENT   1.5
+#define BENCH_SCALING_NOISE_FLOOR_US 100
+#define BENCH_SCALING_MIN_POINTS     3
+#define BENCH_EXIT_SUPER_LINEAR      3
+
+typedef struct
+{
+  const gchar *name;
+  const gchar *category;
+  const gchar *expression;
+} BenchPattern;
+
+typedef struct
+{
+  const gchar *name;
+  gchar      *(*generate) (GRand *rand,
+                           gsize  size);
+} BenchInput;
+
+typedef struct
+{
+  const gchar *name;
+  gchar      *(*generate) (guint size);
+  guint        first_size;
+  guint        last_size;
+  gboolean     is_doubled;
+} BenchFamily;
+
+typedef struct
+{
+  gint      input_size;
+  gint      iterations;
+  gint      seed;
+  gchar    *filter;
+  gchar    *output;
+  gboolean  no_bit_parallel;
+  gboolean  leftmost_longest;
+  gboolean  captures;
+  gint      max_states;
+  gboolean  compare_gregex;
+  gboolean  scaling;
+  gdouble   max_exponent;
+  gchar    *replay;
+} BenchOptions;
+
+typedef struct
+{
+  guint begin;
+  guint end;
+} BenchRange;
+
+typedef struct
+{
+  gchar *name;
+  gchar *expression;
+  gchar *input;
+} BenchUnit;
+
+static gchar   *bench_generate_synthetic (GRand               *rand,
+                                          gsize                size);
+
+static gchar   *bench_generate_log       (GRand               *rand,
+                                          gsize                size);
+
+static gchar   *bench_generate_repeated  (GRand               *rand,
+                                          gsize                size);
+
+static gchar   *bench_family_alternation (guint                size);
+
+static gchar   *bench_family_nesting     (guint                size);
+
+static gchar   *bench_family_exponential (guint                size);
+
+static gchar   *bench_family_literal     (guint                size);
+
+static void     bench_run_pattern        (const BenchOptions  *options,
+                                          const BenchPattern  *pattern,
+                                          gchar              **inputs,
+                                          const gchar         *unit_input,
+                                          GString             *json);
+
+static GArray  *bench_load_units         (const gchar         *directory,
+                                          GError             **error);
+
+static void     bench_clear_unit         (gpointer             data);
+
+static gboolean bench_compile            (const BenchOptions  *options,
+                                          const BenchPattern  *pattern,
+                                          Regexperience       *regexperience,
+                                          gint64              *median_duration,
+                                          GString             *json);
+
+static GRegex  *bench_compile_gregex     (const BenchOptions  *options,
+                                          const BenchPattern  *pattern,
+                                          gint64               median_duration,
+                                          GString             *json);
+
+static void     bench_match              (const BenchOptions  *options,
+                                          Regexperience       *regexperience,
+                                          GRegex              *gregex,
+                                          const gchar         *input_name,
+                                          const gchar         *input,
+                                          GString             *json);
+
+static void     bench_match_gregex       (const BenchOptions  *options,
+                                          GRegex              *gregex,
+                                          const gchar         *input,
+                                          GArray              *ranges,
+                                          gdouble              mb_per_second,
+                                          GString             *json);
+
+static GArray  *bench_gregex_ranges      (GRegex              *gregex,
+                                          const gchar         *input,
+                                          gsize                input_length,
+                                          GError             **error);
+
+static gboolean bench_run_family         (const BenchOptions  *options,
+                                          const BenchFamily   *family,
+                                          GString             *json);
+
+static gboolean bench_append_growth      (const BenchOptions  *options,
+                                          const gchar         *phase,
+                                          GArray              *sizes,
+                                          GArray              *durations,
+                                          GString             *json);
+
+static gint     bench_compare_durations  (gconstpointer        a,
+                                          gconstpointer        b);
+
+static gint     bench_compare_reports    (gconstpointer        a,
+                                          gconstpointer        b);
+
+static void     bench_append_string      (GString             *json,
+                                          const gchar         *value);
+
+static void     bench_append_double      (GString             *json,
+                                          gdouble              value);
+
+static const BenchPattern bench_patterns[] =
+{
+  { "literal-short",            "literal",      "error" },
+  { "literal-long",             "literal",      "connection reset by peer" },
+  { "class-digits",             "class",        "[0-9]+" },
+  { "class-identifier",         "class",        "[A-Za-z_][A-Za-z0-9_]*" },
+  { "class-negated",            "class",        "[^ ]+" },
+  { "alternation-levels",       "alternation",  "DEBUG|INFO|WARN|ERROR|FATAL" },
+  { "alternation-methods",      "alternation",  "GET|POST|PUT|DELETE|PATCH|HEAD|OPTIONS" },
+  { "alternation-words",        "alternation",  "timeout|refused|denied|unreachable|exhausted|corrupted" },
+  { "anchored-start",           "anchored",     "^[0-9]{4}-[0-9]{2}-[0-9]{2}" },
+  { "anchored-end",             "anchored",     "ms$" },
+  { "anchored-both",            "anchored",     "^[a-z0-9 ]*$" },
+  { "dot-star-prefix",          "dot-star",     ".*error" },
+  { "dot-star-between",         "dot-star",     "status=5.*latency=" },
+  { "dot-star-everything",      "dot-star",     ".*" },
+  { "pathological-nested",      "pathological", "(a|aa)*b" },
+  { "pathological-exponential", "pathological", "(a|b)*a(a|b){10}" },
+  { "pathological-quantified",  "pathological", "(x+x+)+y" },
+  { "pathological-repetition",  "pathological", "(a?){20}a{20}" }
+};
+
+static const BenchInput bench_inputs[] =
+{
+  { "synthetic",  bench_generate_synthetic },
+  { "log",        bench_generate_log },
+  { "repetitive", bench_generate_repeated }
+};
+
+static const BenchFamily bench_families[] =
+{
+  { "alternation",   bench_family_alternation, 2,  256,  TRUE },
+  { "nesting",       bench_family_nesting,     4,  128,  TRUE },
+  { "exponential",   bench_family_exponential, 1,  10,   FALSE },
+  { "concatenation", bench_family_literal,     16, 512,  TRUE }
+};
+
+int
+main (int   argc,
+      char *argv[])
+{
+  BenchOptions options = { BENCH_DEFAULT_INPUT_SIZE, BENCH_DEFAULT_ITERATIONS, BENCH_DEFAULT_SEED, .max_exponent = BENCH_DEFAULT_MAX_EXPONENT };
+  GOptionEntry entries[] =
+  {
+    { "size", 's', 0, G_OPTION_ARG_INT, &options.input_size, "Size of each generated input in bytes", "BYTES" },
+    { "iterations", 'i', 0, G_OPTION_ARG_INT, &options.iterations, "Number of measured compilations and runs", "N" },
+    { "seed", 0, 0, G_OPTION_ARG_INT, &options.seed, "Seed of the generated inputs", "SEED" },
+    { "filter", 'f', 0, G_OPTION_ARG_STRING, &options.filter, "Only measure the patterns whose name contains the filter", "TEXT" },
+    { "output", 'o', 0, G_OPTION_ARG_FILENAME, &options.output, "Write the results to a file instead of the standard output", "FILE" },
+    { "no-bit-parallel", 0, 0, G_OPTION_ARG_NONE, &options.no_bit_parallel, "Always convert the expressions to a DFA", NULL },
+    { "leftmost-longest", 0, 0, G_OPTION_ARG_NONE, &options.leftmost_longest, "Find the leftmost-longest matches", NULL },
+    { "captures", 0, 0, G_OPTION_ARG_NONE, &options.captures, "Report the capture groups", NULL },
+    { "max-states", 0, 0, G_OPTION_ARG_INT, &options.max_states, "Maximum number of states (zero stands for no limit)", "N" },
+    { "compare-gregex", 0, 0, G_OPTION_ARG_NONE, &options.compare_gregex, "Run the same corpus through GRegex and compare", NULL },
+    { "scaling", 0, 0, G_OPTION_ARG_NONE, &options.scaling, "Compile the growing families of expressions instead", NULL },
+    { "max-exponent", 0, 0, G_OPTION_ARG_DOUBLE, &options.max_exponent, "Growth exponent above which a phase is flagged", "X" },
+    { "replay", 'r', 0, G_OPTION_ARG_FILENAME, &options.replay, "Replay the units saved by the fuzzer as well", "DIRECTORY" },
+    { NULL }
+  };
+  g_autoptr (GOptionContext) context = g_option_context_new ("- measure compilation latency and matching throughput");
+  g_autoptr (GRand) rand = NULL;
+  g_autoptr (GString) json = g_string_new (NULL);
+  g_autoptr (GArray) units = NULL;
+  gchar *inputs[G_N_ELEMENTS (bench_inputs)] = { NULL };
+  GError *error = NULL;
+  gboolean is_first_result = TRUE;
+  gboolean is_super_linear = FALSE;
+
+  g_option_context_add_main_entries (context, entries, NULL);
+
+  if (!g_option_context_parse (context, &argc, &argv, &error) ||
+      options.input_size <= 0 ||
+      options.iterations <= 0 ||
+      options.max_states < 0 ||
+      options.max_exponent <= 0)
+    {
+      fprintf (stderr, "%s: %s\n", argv[0], (error != NULL) ? error->message : "Invalid option value");
+
+      g_clear_error (&error);
+
+      return 2;
+    }
+
+  if (options.replay != NULL && !options.scaling)
+    {
+      units = bench_load_units (options.replay, &error);
+
+      if (units == NULL)
+        {
+          fprintf (stderr, "%s: %s\n", argv[0], error->message);
+
+          g_error_free (error);
+          g_free (options.filter);
+          g_free (options.output);
+          g_free (options.replay);
+
+          return 1;
+        }
+    }
+
+  g_string_append (json, "{\n  \"configuration\": {");
+  g_string_append_printf (json,
+                          "\"input_size\": %d, \"iterations\": %d, \"seed\": %d, \"bit_parallel\": %s, "
+                          "\"leftmost_longest\": %s, \"captures\": %s, \"max_states\": %d, \"compare_gregex\": %s, "
+                          "\"scaling\": %s, \"max_exponent\": ",
+                          options.input_size,
+                          options.iterations,
+                          options.seed,
+                          options.no_bit_parallel ? "false" : "true",
+                          options.leftmost_longest ? "true" : "false",
+                          options.captures ? "true" : "false",
+                          options.max_states,
+                          options.compare_gregex ? "true" : "false",
+                          options.scaling ? "true" : "false");
+  bench_append_double (json, options.max_exponent);
+  g_string_append (json, ", \"replay\": ");
+
+  if (units != NULL)
+    bench_append_string (json, options.replay);
+  else
+    g_string_append (json, "null");
+
+  g_string_append (json, "},\n");
+
+  if (options.scaling)
+    {
+      g_string_append (json, "  \"families\": [");
+
+      for (guint i = 0; i < G_N_ELEMENTS (bench_families); ++i)
+        {
+          const BenchFamily *family = &bench_families[i];
+
+          if (options.filter != NULL && strstr (family->name, options.filter) == NULL)
+            continue;
+
+          g_string_append (json, is_first_result ? "\n" : ",\n");
+
+          if (bench_run_family (&options, family, json))
+            is_super_linear = TRUE;
+
+          is_first_result = FALSE;
+        }
+    }
+  else
+    {
+      rand = g_rand_new_with_seed ((guint32) options.seed);
+
+      for (guint i = 0; i < G_N_ELEMENTS (bench_inputs); ++i)
+        inputs[i] = bench_inputs[i].generate (rand, (gsize) options.input_size);
+
+      g_string_append (json, "  \"results\": [");
+
+      for (guint i = 0; i < G_N_ELEMENTS (bench_patterns); ++i)
+        {
+          const BenchPattern *pattern = &bench_patterns[i];
+
+          if (options.filter != NULL && strstr (pattern->name, options.filter) == NULL)
+            continue;
+
+          g_string_append (json, is_first_result ? "\n" : ",\n");
+
+          bench_run_pattern (&options, pattern, inputs, NULL, json);
+
+          is_first_result = FALSE;
+        }
+
+      for (guint i = 0; units != NULL && i < units->len; ++i)
+        {
+          const BenchUnit *unit = &g_array_index (units, BenchUnit, i);
+          BenchPattern pattern = { unit->name, "regression", unit->expression };
+
+          if (options.filter != NULL && strstr (unit->name, options.filter) == NULL)
+            continue;
+
+          g_string_append (json, is_first_result ? "\n" : ",\n");
+
+          bench_run_pattern (&options, &pattern, inputs, unit->input, json);
+
+          is_first_result = FALSE;
+        }
+
+      for (guint i = 0; i < G_N_ELEMENTS (bench_inputs); ++i)
+        g_free (inputs[i]);
+    }
+
+  g_string_append (json, "\n  ]\n}\n");
+
+  if (options.output == NULL)
+    fputs (json->str, stdout);
+  else if (!g_file_set_contents (options.output, json->str, (gssize) json->len, &error))
+    {
+      fprintf (stderr, "%s: %s\n", argv[0], error->message);
+
+      g_error_free (error);
+    }
+
+  g_free (options.filter);
+  g_free (options.output);
+  g_free (options.replay);
+
+  if (error != NULL)
+    return 1;
+
+  /* The results are written out either way, the exit status tells whether any phase grew too fast. */
+  return is_super_linear ? BENCH_EXIT_SUPER_LINEAR : 0;
+}
+
+static gchar *
+bench_generate_synthetic (GRand *rand,
+                          gsize  size)
+{
+  static const gchar alphabet[] = "abcdefghijklmnopqrstuvwxyz0123456789      ";
+  gchar *input = g_new (gchar, size + 1);
+
+  /* Uniformly distributed characters, a line break every now and then. */
+  for (gsize i = 0; i < size; ++i)
+    input[i] = (g_rand_int_range (rand, 0, 80) == 0) ? '\n' : alphabet[g_rand_int_range (rand, 0, sizeof (alphabet) - 1)];
+
+  input[size] = '\0';
+
+  return input;
+}
+
+static gchar *
+bench_generate_log (GRand *rand,
+                    gsize  size)
+{
+  static const gchar *levels[] = { "DEBUG", "INFO", "INFO", "INFO", "WARN", "ERROR" };
+  static const gchar *methods[] = { "GET", "GET", "POST", "PUT", "DELETE" };
+  static const gchar *paths[] = { "/api/v1/users", "/api/v1/orders", "/health", "/static/app.js", "/api/v2/search" };
+  static const gchar *messages[] = { "request completed", "cache miss", "connection reset by peer",
+                                     "upstream timeout", "permission denied", "retrying request" };
+  g_autoptr (GString) input = g_string_sized_new (size + 256);
+
+  /* Lines resembling the access logs of a web service. */
+  while (input->len < size)
+    g_string_append_printf (input,
+                            "%04d-%02d-%02dT%02d:%02d:%02d.%03dZ %s [worker-%d] %s %s %s status=%d latency=%dms\n",
+                            2024,
+                            g_rand_int_range (rand, 1, 13),
+                            g_rand_int_range (rand, 1, 29),
+                            g_rand_int_range (rand, 0, 24),
+                            g_rand_int_range (rand, 0, 60),
+                            g_rand_int_range (rand, 0, 60),
+                            g_rand_int_range (rand, 0, 1000),
+                            levels[g_rand_int_range (rand, 0, G_N_ELEMENTS (levels))],
+                            g_rand_int_range (rand, 0, 16),
+                            methods[g_rand_int_range (rand, 0, G_N_ELEMENTS (methods))],
+                            paths[g_rand_int_range (rand, 0, G_N_ELEMENTS (paths))],
+                            messages[g_rand_int_range (rand, 0, G_N_ELEMENTS (messages))],
+                            (g_rand_int_range (rand, 0, 10) == 0) ? 500 + g_rand_int_range (rand, 0, 4) : 200,
+                            g_rand_int_range (rand, 0, 2000));
+
+  g_string_truncate (input, size);
+
+  return g_string_free (g_steal_pointer (&input), FALSE);
+}
+
+static gchar *
+bench_generate_repeated (GRand *rand,
+                         gsize  size)
+{
+  gchar *input = g_new (gchar, size + 1);
+  gsize i = 0;
+
+  /* Long runs of the same characters, the worst case for the pathological expressions. */
+  while (i < size)
+    {
+      gchar character = (g_rand_int_range (rand, 0, 4) == 0) ? 'x' : 'a';
+      gsize run_length = (gsize) g_rand_int_range (rand, 1, 64);
+
+      for (gsize j = 0; j < run_length && i < size; ++j)
+        input[i++] = character;
+
+      if (i < size && g_rand_int_range (rand, 0, 8) == 0)
+        input[i++] = 'b';
+    }
+
+  input[size] = '\0';
+
+  return input;
+}
+
+static gchar *
+bench_family_alternation (guint size)
+{
+  g_autoptr (GString) expression = g_string_new (NULL);
+
+  /* Distinct literals sharing their prefixes, e.g. w0000|w0001|w0002. */
+  for (guint i = 0; i < size; ++i)
+    g_string_append_printf (expression, (i == 0) ? "w%04u" : "|w%04u", i);
+
+  return g_string_free (g_steal_pointer (&expression), FALSE);
+}
+
+static gchar *
+bench_family_nesting (guint size)
+{
+  g_autoptr (GString) expression = g_string_new ("a");
+
+  /* Groups nested within each other, e.g. (a(a(aa|b)|b)|b). */
+  for (guint i = 0; i < size; ++i)
+    {
+      g_string_prepend (expression, "(a");
+      g_string_append (expression, "|b)");
+    }
+
+  return g_string_free (g_steal_pointer (&expression), FALSE);
+}
+
+static gchar *
+bench_family_exponential (guint size)
+{
+  /* The DFA of this expression has twice as many states for each additional repetition. */
+  return g_strdup_printf ("(a|b)*a(a|b){%u}", size);
+}
+
+static gchar *
+bench_family_literal (guint size)
+{
+  static const gchar alphabet[] = "abcdefghijklmnopqrstuvwxyz";
+  gchar *expression = g_new (gchar, size + 1);
+
+  for (guint i = 0; i < size; ++i)
+    expression[i] = alphabet[i % (sizeof (alphabet) - 1)];
+
+  expression[size] = '\0';
+
+  return expression;
+}
+
+static void
+bench_run_pattern (const BenchOptions  *options,
+                   const BenchPattern  *pattern,
+                   gchar              **inputs,
+                   const gchar         *unit_input,
+                   GString             *json)
+{
+  g_autoptr (Regexperience) regexperience = regexperience_new (PROP_REGEXPERIENCE_BIT_PARALLEL, !options->no_bit_parallel,
+                                                               PROP_REGEXPERIENCE_LEFTMOST_LONGEST, options->leftmost_longest,
+                                                               PROP_REGEXPERIENCE_CAPTURES, options->captures,
+                                                               PROP_REGEXPERIENCE_MAX_STATES, (guint) options->max_states);
+
+  g_string_append (json, "    {\"pattern\": ");
+  bench_append_string (json, pattern->name);
+  g_string_append (json, ", \"category\": ");
+  bench_append_string (json, pattern->category);
+  g_string_append (json, ", \"expression\": ");
+  bench_append_string (json, pattern->expression);
+  g_string_append (json, ",\n     ");
+
+  gint64 median_duration = 0;
+
+  if (bench_compile (options, pattern, regexperience, &median_duration, json))
+    {
+      g_autoptr (GRegex) gregex = NULL;
+
+      if (options->compare_gregex)
+        {
+          g_string_append (json, ",\n     ");
+
+          gregex = bench_compile_gregex (options, pattern, median_duration, json);
+        }
+
+      g_string_append (json, ",\n     \"match\": [");
+
+      for (guint i = 0; i < G_N_ELEMENTS (bench_inputs); ++i)
+        {
+          g_string_append (json, (i == 0) ? "\n       " : ",\n       ");
+
+          bench_match (options, regexperience, gregex, bench_inputs[i].name, inputs[i], json);
+        }
+
+      if (unit_input != NULL)
+        {
+          g_string_append (json, ",\n       ");
+
+          bench_match (options, regexperience, gregex, "unit", unit_input, json);
+        }
+
+      g_string_append (json, "\n     ]");
+    }
+
+  g_string_append (json, "}");
+}
+
+static GArray *
+bench_load_units (const gchar  *directory,
+                  GError      **error)
+{
+  g_autoptr (GDir) dir = g_dir_open (directory, 0, error);
+  g_autoptr (GPtrArray) names = g_ptr_array_new_with_free_func (g_free);
+  const gchar *name = NULL;
+
+  if (dir == NULL)
+    return NULL;
+
+  while ((name = g_dir_read_name (dir)) != NULL)
+    g_ptr_array_add (names, g_strdup (name));
+
+  /* The units are replayed in the same order every time, regardless of the file system. */
+  g_ptr_array_sort (names, (GCompareFunc) g_strcmp0);
+
+  GArray *units = g_array_sized_new (FALSE, FALSE, sizeof (BenchUnit), names->len);
+
+  g_array_set_clear_func (units, bench_clear_unit);
+
+  for (guint i = 0; i < names->len; ++i)
+    {
+      g_autofree gchar *path = g_build_filename (directory, g_ptr_array_index (names, i), NULL);
+      g_autofree gchar *contents = NULL;
+
+      if (!g_file_test (path, G_FILE_TEST_IS_REGULAR))
+        continue;
+
+      if (!g_file_get_contents (path, &contents, NULL, error))
+        {
+          g_array_unref (units);
+
+          return NULL;
+        }
+
+      /* The fuzzer ignores the units without a line break, so there are none to replay either. */
+      gchar *line_break = strchr (contents, '\n');
+
+      if (line_break == NULL)
+        continue;
+
+      BenchUnit unit = { g_strdup (g_ptr_array_index (names, i)),
+                         g_strndup (contents, (gsize) (line_break - contents)),
+                         g_strdup (line_break + 1) };
+
+      g_array_append_val (units, unit);
+    }
+
+  return units;
+}
+
+static void
+bench_clear_unit (gpointer data)
+{
+  BenchUnit *unit = data;
+
+  g_free (unit->name);
+  g_free (unit->expression);
+  g_free (unit->input);
+}
+
+static gboolean
+bench_compile (const BenchOptions *options,
+               const BenchPattern *pattern,
+               Regexperience      *regexperience,
+               gint64             *median_duration,
+               GString            *json)
+{
+  g_autoptr (GArray) durations = g_array_sized_new (FALSE, FALSE, sizeof (gint64), (guint) options->iterations);
+  GError *error = NULL;
+
+  for (gint i = 0; i < options->iterations; ++i)
+    {
+      gint64 begin = g_get_monotonic_time ();
+
+      regexperience_compile (regexperience, pattern->expression, &error);
+
+      gint64 duration = g_get_monotonic_time () - begin;
+
+      /* Failing to compile is a result as well (exceeding the maximum number of states, for instance). */
+      if (error != NULL)
+        {
+          g_string_append (json, "\"error\": ");
+          bench_append_string (json, error->message);
+
+          g_error_free (error);
+
+          return FALSE;
+        }
+
+      g_array_append_val (durations, duration);
+    }
+
+  CompileReport report;
+
+  g_array_sort (durations, bench_compare_durations);
+  regexperience_get_compile_report (regexperience, &report);
+
+  *median_duration = g_array_index (durations, gint64, durations->len / 2);
+
+  /* The phases are only reported for the last compilation, they are meant to show where the time goes. */
+  g_string_append_printf (json,
+                          "\"compile\": {\"min_us\": %" G_GINT64_FORMAT ", \"median_us\": %" G_GINT64_FORMAT ", "
+                          "\"phases_us\": {\"tokenization\": %" G_GINT64_FORMAT ", \"parsing\": %" G_GINT64_FORMAT ", "
+                          "\"construction\": %" G_GINT64_FORMAT ", \"epsilon_closures\": %" G_GINT64_FORMAT ", "
+                          "\"subset_construction\": %" G_GINT64_FORMAT ", \"minimization\": %" G_GINT64_FORMAT "}, "
+                          "\"nfa_states\": %u, \"dfa_states\": %u, \"minimized_dfa_states\": %u}",
+                          g_array_index (durations, gint64, 0),
+                          g_array_index (durations, gint64, durations->len / 2),
+                          report.tokenization_time,
+                          report.parsing_time,
+                          report.construction_time,
+                          report.epsilon_closures_time,
+                          report.subset_construction_time,
+                          report.minimization_time,
+                          report.nfa_states_count,
+                          report.dfa_states_count,
+                          report.minimized_dfa_states_count);
+
+  return TRUE;
+}
+
+static GRegex *
+bench_compile_gregex (const BenchOptions *options,
+                      const BenchPattern *pattern,
+                      gint64              median_duration,
+                      GString            *json)
+{
+  g_autoptr (GArray) durations = g_array_sized_new (FALSE, FALSE, sizeof (gint64), (guint) options->iterations);
+  GRegex *gregex = NULL;
+  GError *error = NULL;
+
+  /* The wildcard matches line breaks as well and the end anchor matches at the very end of the input only,
+   * just like they do in the expressions compiled by regexperience.
+   */
+  const GRegexCompileFlags compile_flags = G_REGEX_RAW | G_REGEX_DOTALL | G_REGEX_DOLLAR_ENDONLY | G_REGEX_OPTIMIZE;
+
+  for (gint i = 0; i < options->iterations; ++i)
+    {
+      gint64 begin = g_get_monotonic_time ();
+
+      g_clear_pointer (&gregex, g_regex_unref);
+
+      gregex = g_regex_new (pattern->expression, compile_flags, 0, &error);
+
+      gint64 duration = g_get_monotonic_time () - begin;
+
+      if (error != NULL)
+        {
+          g_string_append (json, "\"gregex_error\": ");
+          bench_append_string (json, error->message);
+
+          g_error_free (error);
+
+          return NULL;
+        }
+
+      g_array_append_val (durations, duration);
+    }
+
+  g_array_sort (durations, bench_compare_durations);
+
+  gint64 gregex_median_duration = g_array_index (durations, gint64, durations->len / 2);
+
+  g_string_append_printf (json,
+                          "\"gregex_compile\": {\"min_us\": %" G_GINT64_FORMAT ", \"median_us\": %" G_GINT64_FORMAT ", "
+                          "\"relative_compile_time\": ",
+                          g_array_index (durations, gint64, 0),
+                          gregex_median_duration);
+  bench_append_double (json, (gdouble) MAX (median_duration, 1) / MAX (gregex_median_duration, 1));
+  g_string_append (json, "}");
+
+  return gregex;
+}
+
+static void
+bench_match (const BenchOptions *options,
+             Regexperience      *regexperience,
+             GRegex             *gregex,
+             const gchar        *input_name,
+             const gchar        *input,
+             GString            *json)
+{
+  gsize input_length = strlen (input);
+  guint matches_count = 0;
+  gint64 total_duration = 0;
+  g_autoptr (GArray) ranges = g_array_new (FALSE, FALSE, sizeof (BenchRange));
+
+  /* The first run is not measured, it builds the DFA's table. */
+  for (gint i = -1; i < options->iterations; ++i)
+    {
+      g_autoptr (GPtrArray) matches = NULL;
+      gint64 begin = g_get_monotonic_time ();
+
+      regexperience_match (regexperience, input, &matches, NULL);
+
+      if (i < 0)
+        continue;
+
+      total_duration += g_get_monotonic_time () - begin;
+      matches_count = (matches != NULL) ? matches->len : 0;
+
+      /* Only the last run's matches are compared to the ones found by GRegex. */
+      if (gregex != NULL && i == options->iterations - 1)
+        for (guint j = 0; j < matches_count; ++j)
+          {
+            BenchRange range = { 0 };
+
+            g_object_get (g_ptr_array_index (matches, j),
+                          PROP_MATCH_RANGE_BEGIN, &range.begin,
+                          PROP_MATCH_RANGE_END, &range.end,
+                          NULL);
+
+            g_array_append_val (ranges, range);
+          }
+    }
+
+  gdouble seconds = MAX (total_duration, 1) / (gdouble) G_USEC_PER_SEC;
+  gdouble mb_per_second = input_length * options->iterations / BENCH_BYTES_PER_MB / seconds;
+
+  g_string_append (json, "{\"input\": ");
+  bench_append_string (json, input_name);
+  g_string_append_printf (json, ", \"bytes\": %" G_GSIZE_FORMAT ", \"matches\": %u, \"mb_per_second\": ",
+                          input_length,
+                          matches_count);
+  bench_append_double (json, mb_per_second);
+  g_string_append (json, ", \"matches_per_second\": ");
+  bench_append_double (json, (gdouble) matches_count * options->iterations / seconds);
+
+  if (gregex != NULL)
+    bench_match_gregex (options, gregex, input, ranges, mb_per_second, json);
+
+  g_string_append (json, "}");
+}
+
+static void
+bench_match_gregex (const BenchOptions *options,
+                    GRegex             *gregex,
+                    const gchar        *input,
+                    GArray             *ranges,
+                    gdouble             mb_per_second,
+                    GString            *json)
+{
+  gsize input_length = strlen (input);
+  g_autoptr (GArray) gregex_ranges = NULL;
+  gint64 total_duration = 0;
+  GError *error = NULL;
+
+  for (gint i = -1; i < options->iterations && error == NULL; ++i)
+    {
+      gint64 begin = g_get_monotonic_time ();
+
+      g_clear_pointer (&gregex_ranges, g_array_unref);
+
+      gregex_ranges = bench_gregex_ranges (gregex, input, input_length, &error);
+
+      if (i >= 0)
+        total_duration += g_get_monotonic_time () - begin;
+    }
+
+  g_string_append (json, ", \"gregex\": {");
+
+  /* Backtracking might exceed PCRE's own limits, which is a result as well. */
+  if (error != NULL)
+    {
+      g_string_append (json, "\"error\": ");
+      bench_append_string (json, error->message);
+      g_string_append (json, "}");
+
+      g_error_free (error);
+
+      return;
+    }
+
+  gdouble seconds = MAX (total_duration, 1) / (gdouble) G_USEC_PER_SEC;
+  gdouble gregex_mb_per_second = input_length * options->iterations / BENCH_BYTES_PER_MB / seconds;
+  guint common_count = 0;
+
+  /* Both sets of matches are ordered by their beginnings and none of them overlap. */
+  for (guint i = 0, j = 0; i < ranges->len && j < gregex_ranges->len;)
+    {
+      BenchRange *range = &g_array_index (ranges, BenchRange, i);
+      BenchRange *gregex_range = &g_array_index (gregex_ranges, BenchRange, j);
+
+      if (range->begin == gregex_range->begin && range->end == gregex_range->end)
+        {
+          common_count++;
+          i++;
+          j++;
+        }
+      else if (range->begin < gregex_range->begin ||
+               (range->begin == gregex_range->begin && range->end < gregex_range->end))
+        {
+          i++;
+        }
+      else
+        {
+          j++;
+        }
+    }
+
+  g_string_append_printf (json, "\"matches\": %u, \"mb_per_second\": ", gregex_ranges->len);
+  bench_append_double (json, gregex_mb_per_second);
+  g_string_append (json, ", \"relative_throughput\": ");
+  bench_append_double (json, mb_per_second / MAX (gregex_mb_per_second, G_MINDOUBLE));
+  g_string_append_printf (json,
+                          ", \"agreement\": {\"identical\": %s, \"common\": %u, \"regexperience_only\": %u, "
+                          "\"gregex_only\": %u}}",
+                          (common_count == ranges->len && common_count == gregex_ranges->len) ? "true" : "false",
+                          common_count,
+                          ranges->len - common_count,
+                          gregex_ranges->len - common_count);
+}
+
+static GArray *
+bench_gregex_ranges (GRegex       *gregex,
+                     const gchar  *input,
+                     gsize         input_length,
+                     GError      **error)
+{
+  g_autoptr (GArray) ranges = g_array_new (FALSE, FALSE, sizeof (BenchRange));
+  g_autoptr (GMatchInfo) match_info = NULL;
+  GError *temporary_error = NULL;
+
+  g_regex_match_full (gregex, input, (gssize) input_length, 0, 0, &match_info, &temporary_error);
+
+  while (temporary_error == NULL && g_match_info_matches (match_info))
+    {
+      gint begin = 0, end = 0;
+
+      g_match_info_fetch_pos (match_info, 0, &begin, &end);
+
+      BenchRange range = { (guint) begin, (guint) end };
+
+      g_array_append_val (ranges, range);
+      g_match_info_next (match_info, &temporary_error);
+    }
+
+  if (temporary_error != NULL)
+    {
+      g_propagate_error (error, temporary_error);
+
+      return NULL;
+    }
+
+  return g_steal_pointer (&ranges);
+}
+
+static gboolean
+bench_run_family (const BenchOptions *options,
+                  const BenchFamily  *family,
+                  GString            *json)
+{
+  /* The families are compiled to a DFA regardless of the options, its construction is what is measured. */
+  g_autoptr (Regexperience) regexperience = regexperience_new (PROP_REGEXPERIENCE_BIT_PARALLEL, FALSE,
+                                                               PROP_REGEXPERIENCE_MAX_STATES, (guint) options->max_states);
+  g_autoptr (GArray) epsilon_nfa_sizes = g_array_new (FALSE, FALSE, sizeof (guint));
+  g_autoptr (GArray) dfa_sizes = g_array_new (FALSE, FALSE, sizeof (guint));
+  g_autoptr (GArray) epsilon_closures_durations = g_array_new (FALSE, FALSE, sizeof (gint64));
+  g_autoptr (GArray) subset_construction_durations = g_array_new (FALSE, FALSE, sizeof (gint64));
+  g_autoptr (GArray) minimization_durations = g_array_new (FALSE, FALSE, sizeof (gint64));
+  gboolean is_super_linear = FALSE;
+
+  g_string_append (json, "    {\"family\": ");
+  bench_append_string (json, family->name);
+  g_string_append (json, ", \"points\": [");
+
+  for (guint size = family->first_size;
+       size <= family->last_size;
+       size = family->is_doubled ? size * 2 : size + 1)
+    {
+      g_autofree gchar *expression = family->generate (size);
+      g_autoptr (GArray) reports = g_array_sized_new (FALSE, FALSE, sizeof (CompileReport), (guint) options->iterations);
+      AutomatonStats stats = { 0 };
+      AllocationReport allocations = { 0 };
+      GError *error = NULL;
+
+      g_string_append (json, (size == family->first_size) ? "\n       " : ",\n       ");
+      g_string_append_printf (json, "{\"size\": %u, \"expression_length\": %" G_GSIZE_FORMAT ", ",
+                              size,
+                              strlen (expression));
+
+      for (gint i = 0; i < options->iterations && error == NULL; ++i)
+        {
+          CompileReport report;
+
+          regexperience_compile (regexperience, expression, &error);
+          regexperience_get_compile_report (regexperience, &report);
+
+          g_array_append_val (reports, report);
+        }
+
+      /* A family is abandoned at the first size which cannot be compiled (exceeding the maximum number of states). */
+      if (error != NULL)
+        {
+          g_string_append (json, "\"error\": ");
+          bench_append_string (json, error->message);
+          g_string_append (json, "}");
+
+          g_error_free (error);
+
+          break;
+        }
+
+      /* The phases are reported for the compilation whose total time is the median one. */
+      g_array_sort (reports, bench_compare_reports);
+
+      const CompileReport median_report = g_array_index (reports, CompileReport, reports->len / 2);
+
+      /* The peak memory comes from one more compilation with the allocations accounted for, which would
+       * otherwise slow the timed ones down. A compilation always allocates, the library has therefore been
+       * built without allocation accounting in case nothing was counted.
+       */
+      g_object_set (regexperience, PROP_REGEXPERIENCE_ALLOCATION_ACCOUNTING, TRUE, NULL);
+      regexperience_compile (regexperience, expression, NULL);
+      regexperience_get_allocations (regexperience, &allocations, NULL);
+      g_object_set (regexperience, PROP_REGEXPERIENCE_ALLOCATION_ACCOUNTING, FALSE, NULL);
+
+      regexperience_get_stats (regexperience, &stats, NULL);
+
+      g_string_append_printf (json,
+                              "\"compile_us\": %" G_GINT64_FORMAT ", "
+                              "\"phases_us\": {\"epsilon_closures\": %" G_GINT64_FORMAT ", "
+                              "\"subset_construction\": %" G_GINT64_FORMAT ", \"minimization\": %" G_GINT64_FORMAT "}, "
+                              "\"epsilon_nfa_states\": %u, \"dfa_states\": %u, \"minimized_dfa_states\": %u, "
+                              "\"automaton_bytes\": %" G_GSIZE_FORMAT ", \"compile_peak_bytes\": ",
+                              median_report.total_time,
+                              median_report.epsilon_closures_time,
+                              median_report.subset_construction_time,
+                              median_report.minimization_time,
+                              median_report.epsilon_nfa_states_count,
+                              median_report.dfa_states_count,
+                              median_report.minimized_dfa_states_count,
+                              stats.bytes);
+
+      if (allocations.allocations_count != 0)
+        g_string_append_printf (json, "%" G_GUINT64_FORMAT "}", allocations.peak_bytes);
+      else
+        g_string_append (json, "null}");
+
+      g_array_append_val (epsilon_nfa_sizes, median_report.epsilon_nfa_states_count);
+      g_array_append_val (dfa_sizes, median_report.dfa_states_count);
+      g_array_append_val (epsilon_closures_durations, median_report.epsilon_closures_time);
+      g_array_append_val (subset_construction_durations, median_report.subset_construction_time);
+      g_array_append_val (minimization_durations, median_report.minimization_time);
+    }
+
+  /* Each phase is measured against the size of what it processes rather than against the family's parameter,
+   * a DFA that grows exponentially is not a regression of the subset construction by itself.
+   */
+  g_string_append (json, "\n     ],\n     \"growth\": {");
+
+  if (bench_append_growth (options, "epsilon_closures", epsilon_nfa_sizes, epsilon_closures_durations, json))
+    is_super_linear = TRUE;
+
+  g_string_append (json, ", ");
+
+  if (bench_append_growth (options, "subset_construction", dfa_sizes, subset_construction_durations, json))
+    is_super_linear = TRUE;
+
+  g_string_append (json, ", ");
+
+  if (bench_append_growth (options, "minimization", dfa_sizes, minimization_durations, json))
+    is_super_linear = TRUE;
+
+  g_string_append (json, "}}");
+
+  return is_super_linear;
+}
+
+static gboolean
+bench_append_growth (const BenchOptions *options,
+                     const gchar        *phase,
+                     GArray             *sizes,
+                     GArray             *durations,
+                     GString            *json)
+{
+  gdouble sum_x = 0, sum_y = 0, sum_xx = 0, sum_xy = 0;
+  guint points_count = 0;
+
+  /* Fitting a line to the logarithms of the sizes and the durations, its slope is the exponent of the growth.
+   * The shortest durations are left out as they mostly consist of noise.
+   */
+  for (guint i = 0; i < sizes->len; ++i)
+    {
+      guint size = g_array_index (sizes, guint, i);
+      gint64 duration = g_array_index (durations, gint64, i);
+
+      if (size == 0 || duration < BENCH_SCALING_NOISE_FLOOR_US)
+        continue;
+
+      gdouble x = log ((gdouble) size);
+      gdouble y = log ((gdouble) duration);
+
+      sum_x += x;
+      sum_y += y;
+      sum_xx += x * x;
+      sum_xy += x * y;
+      points_count++;
+    }
+
+  gdouble denominator = points_count * sum_xx - sum_x * sum_x;
+
+  g_string_append_printf (json, "\"%s\": {\"points\": %u, \"exponent\": ", phase, points_count);
+
+  if (points_count < BENCH_SCALING_MIN_POINTS || denominator <= 0)
+    {
+      g_string_append (json, "null, \"super_linear\": false}");
+
+      return FALSE;
+    }
+
+  gdouble exponent = (points_count * sum_xy - sum_x * sum_y) / denominator;
+  gboolean is_super_linear = (exponent > options->max_exponent);
+
+  bench_append_double (json, exponent);
+  g_string_append_printf (json, ", \"super_linear\": %s}", is_super_linear ? "true" : "false");
+
+  return is_super_linear;
+}
+
+static gint
+bench_compare_durations (gconstpointer a,
+                         gconstpointer b)
+{
+  gint64 first_duration = *(const gint64 *) a;
+  gint64 second_duration = *(const gint64 *) b;
+
+  return (first_duration > second_duration) - (first_duration < second_duration);
+}
+
+static gint
+bench_compare_reports (gconstpointer a,
+                       gconstpointer b)
+{
+  const CompileReport *first_report = a;
+  const CompileReport *second_report = b;
+
+  return bench_compare_durations (&first_report->total_time, &second_report->total_time);
+}
+
+static void
+bench_append_string (GString     *json,
+                     const gchar *value)
+{
+  g_string_append_c (json, '"');
+
+  for (const gchar *character = value; *character != '\0'; ++character)
+    {
+      if (*character == '"' || *character == '\\')
+        g_string_append_printf (json, "\\%c", *character);
+      else if ((guchar) *character < 0x20)
+        g_string_append_printf (json, "\\u%04x", (guint) *character);
+      else
+        g_string_append_c (json, *character);
+    }
+
+  g_string_append_c (json, '"');
+}
+
+static void
+bench_append_double (GString *json,
+                     gdouble  value)
+{
+  gchar buffer[G_ASCII_DTOSTR_BUF_SIZE];
+
+  /* The decimal separator must not depend on the locale. */
+  g_string_append (json, g_ascii_formatd (buffer, sizeof (buffer), "%.3f", value));
+}
@@ -0,0 +1,53 @@
+#include "regexperience.h"
+
+#include <stdio.h>
+
+/* Generates a standalone matcher for the given expression - the source and the header are written
+ * to the output directory as <name>.c and <name>.h, respectively.
+ */
+int
+main (int   argc,
+      char *argv[])
+{
+  if (argc != 4)
+    {
+      fprintf (stderr, "Usage: %s <name> <expression> <output directory>\n", argv[0]);
+
+      return 2;
+    }
+
+  const gchar *matcher_name = argv[1];
+  const gchar *expression = argv[2];
+  const gchar *output_directory = argv[3];
+  g_autoptr (Regexperience) regexperience = regexperience_new ();
+  g_autofree gchar *source = NULL;
+  g_autofree gchar *header = NULL;
+  GError *error = NULL;
+
+  if (regexperience_generate_matcher (regexperience,
+                                      expression,
+                                      matcher_name,
+                                      &source,
+                                      &header,
+                                      &error))
+    {
+      g_autofree gchar *source_name = g_strconcat (matcher_name, ".c", NULL);
+      g_autofree gchar *header_name = g_strconcat (matcher_name, ".h", NULL);
+      g_autofree gchar *source_path = g_build_filename (output_directory, source_name, NULL);
+      g_autofree gchar *header_path = g_build_filename (output_directory, header_name, NULL);
+
+      if (g_file_set_contents (source_path, source, -1, &error))
+        g_file_set_contents (header_path, header, -1, &error);
+    }
+
+  if (error != NULL)
+    {
+      fprintf (stderr, "%s: %s\n", argv[0], error->message);
+
+      g_error_free (error);
+
+      return 1;
+    }
+
+  return 0;
+}
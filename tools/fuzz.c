@@ -0,0 +1,205 @@
+#include "regexperience.h"
+
+#include <stdio.h>
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Hunts for performance cliffs rather than crashes - each unit is an expression (up to the first line break)
+ * followed by an input, the expression is compiled to a DFA and matched against the input. A unit whose
+ * compilation or match takes too long, or whose DFA grows too large, is saved to the regression corpus
+ * (which the benchmark replays) and reported as a finding by aborting.
+ *
+ * Built with REGEXPERIENCE_LIBFUZZER, libFuzzer provides the entry point. Otherwise, each file given on
+ * the command line (or the standard input) is run as a single unit, which is what AFL expects.
+ */
+
+#define FUZZ_DEFAULT_MAX_COMPILE_US 100000
+#define FUZZ_DEFAULT_MAX_MATCH_US   100000
+#define FUZZ_DEFAULT_MAX_STATES     10000
+#define FUZZ_DEFAULT_CORPUS         "regression-corpus"
+
+typedef struct
+{
+  gint64       max_compile_time;
+  gint64       max_match_time;
+  guint        max_states;
+  const gchar *corpus;
+} FuzzThresholds;
+
+int             LLVMFuzzerTestOneInput     (const guint8         *data,
+                                            size_t                size);
+
+static void     fuzz_load_thresholds       (FuzzThresholds       *thresholds);
+
+static gint64   fuzz_get_environment_value (const gchar          *name,
+                                            gint64                default_value);
+
+static void     fuzz_report_finding        (const FuzzThresholds *thresholds,
+                                            const guint8         *data,
+                                            size_t                size,
+                                            const gchar          *reason);
+
+int
+LLVMFuzzerTestOneInput (const guint8 *data,
+                        size_t        size)
+{
+  static FuzzThresholds thresholds = { 0 };
+
+  if (thresholds.corpus == NULL)
+    fuzz_load_thresholds (&thresholds);
+
+  const guint8 *line_break = memchr (data, '\n', size);
+
+  if (line_break == NULL)
+    return 0;
+
+  /* The unit is copied because it is not terminated, an embedded null character ends either part early. */
+  g_autofree gchar *expression = g_strndup ((const gchar *) data, (gsize) (line_break - data));
+  g_autofree gchar *input = g_strndup ((const gchar *) line_break + 1, size - (gsize) (line_break - data) - 1);
+
+  /* The limits keep a pathological expression from stalling the fuzzer, hitting either one is a finding
+   * on its own. The bit-parallel simulation is disabled since it would skip the DFA's construction.
+   */
+  g_autoptr (Regexperience) regexperience = regexperience_new (PROP_REGEXPERIENCE_BIT_PARALLEL, FALSE,
+                                                               PROP_REGEXPERIENCE_NFA_FALLBACK, FALSE,
+                                                               PROP_REGEXPERIENCE_MAX_STATES, thresholds.max_states,
+                                                               PROP_REGEXPERIENCE_TIME_LIMIT, thresholds.max_compile_time);
+  g_autoptr (GPtrArray) matches = NULL;
+  GError *error = NULL;
+  gint64 begin = g_get_monotonic_time ();
+
+  regexperience_compile (regexperience, expression, &error);
+
+  gint64 compile_time = g_get_monotonic_time () - begin;
+
+  if (error != NULL)
+    {
+      /* Invalid expressions are expected, most of the generated ones are (the error codes are unique). */
+      if (error->code == CORE_REGEXPERIENCE_ERROR_COMPILATION_BUDGET_EXCEEDED)
+        fuzz_report_finding (&thresholds, data, size, error->message);
+
+      g_error_free (error);
+
+      return 0;
+    }
+
+  if (compile_time > thresholds.max_compile_time)
+    fuzz_report_finding (&thresholds, data, size, "compilation time exceeded");
+
+  begin = g_get_monotonic_time ();
+
+  regexperience_match (regexperience, input, &matches, &error);
+
+  gint64 match_time = g_get_monotonic_time () - begin;
+
+  /* Any input is accepted, an error could only be an internal one which is not a performance cliff. */
+  g_clear_error (&error);
+
+  if (match_time > thresholds.max_match_time)
+    fuzz_report_finding (&thresholds, data, size, "match time exceeded");
+
+  return 0;
+}
+
+#ifndef REGEXPERIENCE_LIBFUZZER
+
+int
+main (int   argc,
+      char *argv[])
+{
+  GError *error = NULL;
+
+  if (argc < 2)
+    {
+      g_autoptr (GString) unit = g_string_new (NULL);
+      gchar buffer[BUFSIZ];
+      gsize length = 0;
+
+      while ((length = fread (buffer, 1, sizeof (buffer), stdin)) > 0)
+        g_string_append_len (unit, buffer, (gssize) length);
+
+      return LLVMFuzzerTestOneInput ((const guint8 *) unit->str, unit->len);
+    }
+
+  for (gint i = 1; i < argc; ++i)
+    {
+      g_autofree gchar *unit = NULL;
+      gsize length = 0;
+
+      if (!g_file_get_contents (argv[i], &unit, &length, &error))
+        {
+          fprintf (stderr, "%s: %s\n", argv[0], error->message);
+
+          g_error_free (error);
+
+          return 1;
+        }
+
+      LLVMFuzzerTestOneInput ((const guint8 *) unit, length);
+    }
+
+  return 0;
+}
+
+#endif
+
+static void
+fuzz_load_thresholds (FuzzThresholds *thresholds)
+{
+  const gchar *corpus = g_getenv ("REGEXPERIENCE_FUZZ_CORPUS");
+
+  thresholds->max_compile_time = fuzz_get_environment_value ("REGEXPERIENCE_FUZZ_MAX_COMPILE_US",
+                                                             FUZZ_DEFAULT_MAX_COMPILE_US);
+  thresholds->max_match_time = fuzz_get_environment_value ("REGEXPERIENCE_FUZZ_MAX_MATCH_US",
+                                                           FUZZ_DEFAULT_MAX_MATCH_US);
+  thresholds->max_states = (guint) fuzz_get_environment_value ("REGEXPERIENCE_FUZZ_MAX_STATES",
+                                                               FUZZ_DEFAULT_MAX_STATES);
+  thresholds->corpus = (corpus != NULL) ? corpus : FUZZ_DEFAULT_CORPUS;
+}
+
+static gint64
+fuzz_get_environment_value (const gchar *name,
+                            gint64       default_value)
+{
+  const gchar *value = g_getenv (name);
+  gint64 parsed_value = 0;
+
+  if (value == NULL)
+    return default_value;
+
+  if (!g_ascii_string_to_signed (value, 10, 1, G_MAXUINT, &parsed_value, NULL))
+    {
+      fprintf (stderr, "Ignoring %s, it is not a positive number: %s\n", name, value);
+
+      return default_value;
+    }
+
+  return parsed_value;
+}
+
+static void
+fuzz_report_finding (const FuzzThresholds *thresholds,
+                     const guint8         *data,
+                     size_t                size,
+                     const gchar          *reason)
+{
+  g_autofree gchar *checksum = g_compute_checksum_for_data (G_CHECKSUM_SHA1, data, size);
+  g_autofree gchar *path = g_build_filename (thresholds->corpus, checksum, NULL);
+  GError *error = NULL;
+
+  /* The unit is saved before aborting, so that it is kept even if the fuzzer itself discards it. */
+  if (g_mkdir_with_parents (thresholds->corpus, 0755) != 0 ||
+      !g_file_set_contents (path, (const gchar *) data, (gssize) size, &error))
+    {
+      fprintf (stderr, "Unable to save the unit to %s: %s\n",
+               path,
+               (error != NULL) ? error->message : g_strerror (errno));
+
+      g_clear_error (&error);
+    }
+
+  fprintf (stderr, "Performance cliff (%s), saved as %s\n", reason, path);
+
+  abort ();
+}